@@ -21,7 +21,11 @@ void URestorableGameServiceBase::BeginServiceStart()
 	bIsWaitingForSaveGameRestore = true;
 	SaveGameService = UseGameServiceAsWeakPtr<USaveGameService>(this);
 	SaveGameService->OnBeforeSaved.AddUObject(this, &ThisClass::WriteToSaveGame);
-	SaveGameService->OnAfterRestored.AddUObject(this, &ThisClass::HandleSaveGameLoaded);
+	if (bWritesToSaveGameAsync)
+	{
+		SaveGameService->AddSaveContributor(GetClass()->GetFName(), FCurrentSaveGame::FOnContributeToSave::CreateUObject(this, &ThisClass::WriteToSaveGameAsync));
+	}
+	SaveGameService->RestorePipeline.Add(RestoreTier, FSaveGameRestorePipeline::FRestoreStep::CreateUObject(this, &ThisClass::HandleSaveGameLoaded), RestorePriority);
 
 	if (!SaveGameService->IsBusyLoading())
 	{
@@ -34,7 +38,8 @@ void URestorableGameServiceBase::BeginServiceShutdown(bool bIsWorldTearingDown)
 	if (SaveGameService.IsValid())
 	{
 		SaveGameService->OnBeforeSaved.RemoveAll(this);
-		SaveGameService->OnAfterRestored.RemoveAll(this);
+		SaveGameService->RestorePipeline.RemoveAll(this);
+		SaveGameService->RemoveAllSaveContributors(this);
 		SaveGameService.Reset();
 	}
 
@@ -10,6 +10,7 @@
 #include "SaveGame/Mocks/MockSaveGameSerializer.h"
 
 #include "GameFramework/SaveGame.h"
+#include "SaveGame/ModularSaveGame.h"
 
 bool UMockSaveGameSerializer::TrySerializeSaveGame(USaveGame& InSaveGameObject, TArray<uint8>& OutSaveData) const
 {
@@ -17,6 +18,13 @@ bool UMockSaveGameSerializer::TrySerializeSaveGame(USaveGame& InSaveGameObject,
 	USaveGame* CopyOfSaveGameObject =
 		DuplicateObject<USaveGame>(&InSaveGameObject, InSaveGameObject.GetOuter(), FName(InSaveGameObject.GetName() + "_Serialized"));
 
+	// (i) The header data is no property and would not be duplicated along:
+	const UModularSaveGame* ModularSaveGame = Cast<UModularSaveGame>(&InSaveGameObject);
+	if (ModularSaveGame && ModularSaveGame->GetInstancedHeaderData().IsValid())
+	{
+		CastChecked<UModularSaveGame>(CopyOfSaveGameObject)->SetInstancedHeaderData(*ModularSaveGame->GetInstancedHeaderData());
+	}
+
 	// Give out the index of the "serialized" object as only entry of the output byte array:
 	const int32 Index = SerializedSaveGameObjects.AddUnique(CopyOfSaveGameObject);
 	OutSaveData = {static_cast<uint8>(Index)};
@@ -37,13 +45,22 @@ bool UMockSaveGameSerializer::DoesSaveGameExist(const FSlotName& SlotName, const
 
 bool UMockSaveGameSerializer::TrySaveDataToSlot(const TArray<uint8>& InSaveData, const FSlotName& SlotName, const int32 UserIndex)
 {
+	if (SlotsFailingToSave.Contains(SlotName))
+		return false;
+
 	PretendedSaveGamesOnDisk.Add(SlotName, InSaveData);
 	return true;
 }
 
-void UMockSaveGameSerializer::AsyncSaveGameToSlot(USaveGame& SaveGameObject, const FSlotName& SlotName, const int32 UserIndex, FOnAsyncSaveCompleted Callback)
+void UMockSaveGameSerializer::AsyncSaveGameToSlot(USaveGame& SaveGameObject, const FSlotName& SlotName, const int32 UserIndex, FOnAsyncSaveCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken, ESaveGameIOPriority Priority)
+{
+	const bool bSuccess = (!FSaveLoadCancellationToken::IsCancelled(CancellationToken) && TrySaveGameToSlot(SaveGameObject, SlotName, UserIndex));
+	Callback.ExecuteIfBound(SlotName, UserIndex, bSuccess);
+}
+
+void UMockSaveGameSerializer::AsyncSaveDataToSlot(const TSharedRef<TArray<uint8>>& InSaveData, const FSlotName& SlotName, const int32 UserIndex, FOnAsyncSaveCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken, ESaveGameIOPriority Priority)
 {
-	const bool bSuccess = TrySaveGameToSlot(SaveGameObject, SlotName, UserIndex);;
+	const bool bSuccess = (!FSaveLoadCancellationToken::IsCancelled(CancellationToken) && TrySaveDataToSlot(*InSaveData, SlotName, UserIndex));
 	Callback.ExecuteIfBound(SlotName, UserIndex, bSuccess);
 }
 
@@ -56,14 +73,55 @@ bool UMockSaveGameSerializer::TryLoadDataFromSlot(const FSlotName& SlotName, con
 	return true;
 }
 
-void UMockSaveGameSerializer::AsyncLoadGameFromSlot(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncLoadCompleted Callback)
+void UMockSaveGameSerializer::AsyncLoadGameFromSlot(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncLoadCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken, ESaveGameIOPriority Priority)
 {
+	if (bAsyncLoadsNeverComplete)
+		return;
+
 	USaveGame* SaveGame = nullptr;
-	TryLoadGameFromSlot(SlotName, UserIndex, OUT SaveGame);
+	if (!FSaveLoadCancellationToken::IsCancelled(CancellationToken))
+	{
+		TryLoadGameFromSlot(SlotName, UserIndex, OUT SaveGame);
+	}
 	Callback.ExecuteIfBound(SlotName, UserIndex, SaveGame);
 }
 
+void UMockSaveGameSerializer::AsyncLoadDataFromSlot(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncLoadDataCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken, ESaveGameIOPriority Priority)
+{
+	if (bAsyncLoadsNeverComplete)
+		return;
+
+	TArray<uint8> SaveData;
+	const bool bSuccess = (!FSaveLoadCancellationToken::IsCancelled(CancellationToken) && TryLoadDataFromSlot(SlotName, UserIndex, OUT SaveData));
+	Callback.ExecuteIfBound(SlotName, UserIndex, bSuccess, SaveData);
+}
+
 bool UMockSaveGameSerializer::TryDeleteGameInSlot(const FSlotName& SlotName, const int32 UserIndex, TOptional<FString> OptionalBackupFolder)
 {
 	return (PretendedSaveGamesOnDisk.Remove(SlotName) > 0);
 }
+
+void UMockSaveGameSerializer::AsyncReadSlotHeader(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncReadSlotHeaderCompleted Callback, ESaveGameIOPriority Priority)
+{
+	FSaveGameSlotManifestEntry Entry;
+	const bool bSuccess = TryReadHeaderFromSlotFile(SlotName, UserIndex, OUT Entry);
+	Callback.ExecuteIfBound(SlotName, bSuccess, Entry);
+}
+
+bool UMockSaveGameSerializer::TryReadHeaderFromSaveData(const TArray<uint8>& InSaveData, FSaveGameSlotManifestEntry& OutEntry) const
+{
+	USaveGame* SaveGame = nullptr;
+	const UModularSaveGame* ModularSaveGame = (TryDeserializeSaveGame(InSaveData, OUT SaveGame) ? Cast<UModularSaveGame>(SaveGame) : nullptr);
+	if (!ModularSaveGame || !ModularSaveGame->GetInstancedHeaderData().IsValid())
+		return false;
+
+	OutEntry.SaveGameClassName = ModularSaveGame->GetClass()->GetPathName();
+	OutEntry.CustomHeaderData = *ModularSaveGame->GetInstancedHeaderData();
+	return true;
+}
+
+bool UMockSaveGameSerializer::TryReadHeaderFromSlotFile(const FSlotName& SlotName, const int32 UserIndex, FSaveGameSlotManifestEntry& OutEntry)
+{
+	TArray<uint8> SaveData;
+	return (TryLoadDataFromSlot(SlotName, UserIndex, OUT SaveData) && TryReadHeaderFromSaveData(SaveData, OUT OutEntry));
+}
@@ -9,18 +9,27 @@
 
 #include "SaveGame/ModularSaveGame.h"
 
+#include "Async/ParallelFor.h"
 #include "GameService/GameServiceLocator.h"
+#include "Hash/xxhash.h"
+#include "Misc/Compression.h"
 #include "Misc/EngineVersion.h"
 #include "SaveGame/SaveGameHeader.h"
+#include "SaveGame/SaveGameSchema.h"
 #include "SaveGame/SaveGameService.h"
+#include "SaveGame/Modules/LevelObjectRestorer.h"
+#include "SaveGame/Settings/SaveGameServiceSettings.h"
 #include "Serialization/CustomVersion.h"
 #include "Serialization/MemoryReader.h"
 #include "Serialization/MemoryWriter.h"
 #include "Templates/SubclassOf.h"
+#include "UObject/UObjectIterator.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////
 /// @UModularSaveGame
 
+uint32 UModularSaveGame::ModuleHandleGeneration = 1;
+
 const UModularSaveGame* UModularSaveGame::GetCurrent()
 {
 	const USaveGameService* SaveGameService = UGameServiceLocator::FindService<USaveGameService>();
@@ -39,9 +48,26 @@ UModularSaveGame* UModularSaveGame::GetMutableCurrent()
 	return SaveGameService->GetCurrentSaveGame().GetMutablePtr<UModularSaveGame>();
 }
 
+bool UModularSaveGame::DeleteModule(const FName& ModuleName)
+{
+	if (Modules.Remove(ModuleName) == 0)
+		return false;
+
+	InvalidateModuleHandles();
+	return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////
 /// SAVE GAME HEADER - Mostly copied from UE/GameplayStatic.cpp
 
+void FSimpleSaveGameHeaderData::ResetVolatileData()
+{
+	SaveCounter = 0;
+	RestoreCounter = 0;
+	UtcTimeOfLastSave = FDateTime();
+	UtcTimeOfLastRestore = FDateTime();
+}
+
 FModularSaveGameHeader::FModularSaveGameHeader() :
 	FileTypeTag(0),
 	SaveGameFileVersion(0),
@@ -87,7 +113,7 @@ bool FModularSaveGameHeader::TryRead(FMemoryReader& MemoryReader)
 
 	// Check incompatible save file version:
 	MemoryReader << SaveGameFileVersion;
-	if (SaveGameFileVersion < MODULAR_SAVEGAME_FILE_VERSION)
+	if (SaveGameFileVersion < MODULAR_SAVEGAME_FILE_VERSION_MIN)
 	{
 		MemoryReader.Seek(0);
 		return false;
@@ -136,6 +162,39 @@ bool FModularSaveGameHeader::TryWrite(FMemoryWriter& MemoryWriter)
 	return true;
 }
 
+void UModularSaveGame::Serialize(FArchive& Ar)
+{
+	// (i) Struct modules are notified here, since they have no Serialize() of their own. This always runs on the game thread.
+	if (Ar.ArIsSaveGame && Ar.IsSaving())
+	{
+		for (TTuple<FName, FInstancedStruct>& NameAndModule : StructModules)
+		{
+			if (FSaveGameStructModule* StructModule = NameAndModule.Value.GetMutablePtr<FSaveGameStructModule>())
+			{
+				StructModule->PreSaveModule();
+			}
+		}
+	}
+
+	Super::Serialize(Ar);
+
+	if (Ar.IsLoading())
+	{
+		InvalidateModuleHandles();
+	}
+
+	if (Ar.ArIsSaveGame && Ar.IsLoading())
+	{
+		for (TTuple<FName, FInstancedStruct>& NameAndModule : StructModules)
+		{
+			if (FSaveGameStructModule* StructModule = NameAndModule.Value.GetMutablePtr<FSaveGameStructModule>())
+			{
+				StructModule->PostRestoreModule();
+			}
+		}
+	}
+}
+
 #if WITH_EDITOR
 void UModularSaveGame::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
@@ -148,6 +207,7 @@ void UModularSaveGame::PostEditChangeProperty(FPropertyChangedEvent& PropertyCha
 
 			Itr.Key() = Itr.Value()->DefaultModuleName;
 		}
+		InvalidateModuleHandles();
 	}
 
 	Super::PostEditChangeProperty(PropertyChangedEvent);
@@ -157,23 +217,518 @@ void UModularSaveGame::PostEditChangeProperty(FPropertyChangedEvent& PropertyCha
 ///////////////////////////////////////////////////////////////////////////////////////
 /// @UModularSaveGameSerializer
 
+namespace
+{
+	struct FModuleTableEntry
+	{
+		FString ModuleName;
+		FString ClassPath;
+		int32 StoredSize = 0;
+		int32 UncompressedSize = 0; // (i) Equal to StoredSize if the module block is stored uncompressed.
+		uint64 SchemaHash = 0; // (i) 0 if the module was saved with tagged serialization (see USaveGameModule::bUseCompiledSchema).
+
+		void Serialize(FArchive& Ar, int32 FileVersion)
+		{
+			Ar << ModuleName;
+			Ar << ClassPath;
+			Ar << StoredSize;
+			Ar << UncompressedSize;
+			if (FileVersion >= MODULAR_SAVEGAME_FILE_VERSION_MODULE_SCHEMAS)
+			{
+				Ar << SchemaHash;
+			}
+		}
+	};
+
+	/** Table that precedes the separately compressed module blocks (see MODULAR_SAVEGAME_FILE_VERSION_MODULE_TABLE). */
+	struct FModuleTable
+	{
+		FString CompressionFormat;
+		TArray<FModuleTableEntry> Entries;
+		TMap<uint64, TArray<FSaveGameSchemaField>> SchemaFields; // (i) Saved fields by schema hash, to read modules whose schema changed since.
+
+		void Serialize(FArchive& Ar, int32 FileVersion)
+		{
+			Ar << CompressionFormat;
+			int32 NumEntries = Entries.Num();
+			Ar << NumEntries;
+			if (Ar.IsLoading())
+			{
+				if (NumEntries < 0 || NumEntries > Ar.TotalSize())
+				{
+					Ar.SetError();
+					return;
+				}
+				Entries.SetNum(NumEntries);
+			}
+			for (FModuleTableEntry& Entry : Entries)
+			{
+				Entry.Serialize(Ar, FileVersion);
+			}
+			if (FileVersion >= MODULAR_SAVEGAME_FILE_VERSION_MODULE_SCHEMAS)
+			{
+				Ar << SchemaFields;
+			}
+		}
+	};
+
+	/** Module that was encoded into its own buffer, independently of all other modules. */
+	struct FEncodedModule
+	{
+		FName ModuleName;
+		USaveGameModule* Module = nullptr;
+		const FSaveGameSchema* Schema = nullptr;
+		TArray<uint8> StoredData;
+		int32 UncompressedSize = 0;
+		uint64 UncompressedHash = 0;
+		TSet<FString> ReferencedAssetPaths;
+		FCustomVersionContainer UsedCustomVersions;
+		double EncodeTime = 0.0;
+		double CompressionTime = 0.0;
+	};
+
+	void EncodeModule(FEncodedModule& InOutEncodedModule, const FName& CompressionFormat)
+	{
+		double StartTime = FPlatformTime::Seconds();
+		TArray<uint8> UncompressedData;
+		FMemoryWriter ModuleWriter(UncompressedData, true);
+		ModuleWriter.ArIsSaveGame = true;
+		FWeekendUtilsAssetCollectingProxyArchive ModuleArchive(ModuleWriter, true, InOutEncodedModule.ReferencedAssetPaths);
+		ModuleArchive.ArIsSaveGame = true;
+		if (InOutEncodedModule.Schema)
+		{
+			InOutEncodedModule.Module->SetSchemaForNextSerialize(InOutEncodedModule.Schema);
+		}
+		InOutEncodedModule.Module->Serialize(ModuleArchive);
+		InOutEncodedModule.UsedCustomVersions = ModuleWriter.GetCustomVersions();
+		InOutEncodedModule.UncompressedSize = UncompressedData.Num();
+		InOutEncodedModule.UncompressedHash = FXxHash64::HashBuffer(UncompressedData.GetData(), UncompressedData.Num()).Hash;
+		InOutEncodedModule.EncodeTime = (FPlatformTime::Seconds() - StartTime);
+
+		// Keep the module uncompressed if compression is disabled or doesn't pay off:
+		StartTime = FPlatformTime::Seconds();
+		if (!CompressionFormat.IsNone() && !UncompressedData.IsEmpty())
+		{
+			int32 CompressedSize = FCompression::CompressMemoryBound(CompressionFormat, UncompressedData.Num());
+			InOutEncodedModule.StoredData.SetNumUninitialized(CompressedSize);
+			if (FCompression::CompressMemory(CompressionFormat, InOutEncodedModule.StoredData.GetData(), OUT CompressedSize, UncompressedData.GetData(), UncompressedData.Num())
+				&& CompressedSize < UncompressedData.Num())
+			{
+				InOutEncodedModule.StoredData.SetNum(CompressedSize);
+			}
+			else
+			{
+				InOutEncodedModule.StoredData.Reset();
+			}
+		}
+		if (InOutEncodedModule.StoredData.IsEmpty())
+		{
+			InOutEncodedModule.StoredData = MoveTemp(UncompressedData);
+		}
+		InOutEncodedModule.CompressionTime = (FPlatformTime::Seconds() - StartTime);
+	}
+
+	/** @returns the custom versions that were used while serializing, which are the only ones needed to deserialize again. */
+	FCustomVersionContainer GetUsedCustomVersions(const FInstancedStruct& CustomHeaderData, const FCustomVersionContainer& ContentVersions, const TArray<FEncodedModule>& EncodedModules)
+	{
+		// (i) Header data is serialized once more just to find out its custom versions, which is cheap for such small structs.
+		TArray<uint8> HeaderData;
+		FInstancedStruct HeaderDataCopy = CustomHeaderData;
+		FMemoryWriter HeaderDataWriter(HeaderData, true);
+		HeaderDataWriter.ArIsSaveGame = true;
+		FObjectAndNameAsStringProxyArchive HeaderDataArchive(HeaderDataWriter, true);
+		HeaderDataCopy.Serialize(HeaderDataArchive);
+
+		FCustomVersionContainer UsedCustomVersions = HeaderDataWriter.GetCustomVersions();
+		auto AddCustomVersions = [&UsedCustomVersions](const FCustomVersionContainer& CustomVersions)
+		{
+			for (const FCustomVersion& CustomVersion : CustomVersions.GetAllVersions())
+			{
+				UsedCustomVersions.SetVersion(CustomVersion.Key, CustomVersion.Version, CustomVersion.GetFriendlyName());
+			}
+		};
+		AddCustomVersions(ContentVersions);
+		for (const FEncodedModule& EncodedModule : EncodedModules)
+		{
+			AddCustomVersions(EncodedModule.UsedCustomVersions);
+		}
+		return UsedCustomVersions;
+	}
+
+	/** @returns hash of the header data, without the data that changes with every save (see FSaveGameHeaderDataBase::ResetVolatileData). */
+	uint64 HashHeaderDataContent(const FInstancedStruct& CustomHeaderData)
+	{
+		FInstancedStruct HeaderDataCopy = CustomHeaderData;
+		if (FSaveGameHeaderDataBase* HeaderDataBase = HeaderDataCopy.GetMutablePtr<FSaveGameHeaderDataBase>())
+		{
+			HeaderDataBase->ResetVolatileData();
+		}
+
+		TArray<uint8> HeaderData;
+		FMemoryWriter HeaderDataWriter(HeaderData, true);
+		HeaderDataWriter.ArIsSaveGame = true;
+		FObjectAndNameAsStringProxyArchive HeaderDataArchive(HeaderDataWriter, true);
+		HeaderDataCopy.Serialize(HeaderDataArchive);
+		return FXxHash64::HashBuffer(HeaderData.GetData(), HeaderData.Num()).Hash;
+	}
+
+	/** Proxy archive for decoding modules on worker threads, which only finds objects that are already loaded instead of loading them. */
+	struct FWorkerThreadModuleArchive : public FObjectAndNameAsStringProxyArchive
+	{
+		FWorkerThreadModuleArchive(FArchive& InInnerArchive) : FObjectAndNameAsStringProxyArchive(InInnerArchive, false)
+		{
+			ArIsSaveGame = true;
+		}
+
+		/** Whether a referenced object was not loaded yet, so the module has to be decoded again on the game thread. */
+		bool bHasUnresolvedReferences = false;
+
+		virtual FArchive& operator<<(UObject*& Obj) override
+		{
+			if (!IsLoading())
+				return FObjectAndNameAsStringProxyArchive::operator<<(Obj);
+
+			FString ObjectPath;
+			InnerArchive << ObjectPath;
+			Obj = FindObject<UObject>(nullptr, *ObjectPath);
+			bHasUnresolvedReferences |= (!Obj && !ObjectPath.IsEmpty() && ObjectPath != TEXT("None"));
+			return *this;
+		}
+	};
+
+	/** Module block of the module table that is decoded independently of all other modules. */
+	struct FDecodedModule
+	{
+		const FModuleTableEntry* Entry = nullptr;
+		int64 BlockOffset = 0;
+		USaveGameModule* Module = nullptr;
+		const FSaveGameSchema* Schema = nullptr;
+		const TArray<FSaveGameSchemaField>* SavedSchemaFields = nullptr; // (i) Only set if the schema changed since saving.
+		bool bSucceeded = false;
+		bool bHasUnresolvedReferences = false;
+		double DecodeTime = 0.0;
+		double DecompressionTime = 0.0;
+	};
+
+	void DecodeModule(FDecodedModule& InOutDecodedModule, const TArray<uint8>& InSaveData, const FModularSaveGameHeader& SaveHeader, const FName& CompressionFormat)
+	{
+		const FModuleTableEntry& Entry = *InOutDecodedModule.Entry;
+		const double StartTime = FPlatformTime::Seconds();
+
+		// Decompress the module block, unless it was stored uncompressed:
+		const uint8* StoredData = (InSaveData.GetData() + InOutDecodedModule.BlockOffset);
+		TArray<uint8> UncompressedData;
+		if (Entry.StoredSize < Entry.UncompressedSize)
+		{
+			UncompressedData.SetNumUninitialized(Entry.UncompressedSize);
+			const bool bDecompressed = FCompression::UncompressMemory(CompressionFormat, UncompressedData.GetData(), Entry.UncompressedSize, StoredData, Entry.StoredSize);
+			InOutDecodedModule.DecompressionTime = (FPlatformTime::Seconds() - StartTime);
+			if (!bDecompressed)
+				return;
+		}
+		else
+		{
+			UncompressedData.Append(StoredData, Entry.StoredSize);
+		}
+
+		// Restore the module with the versions the SaveGame was saved with:
+		FMemoryReader ModuleReader(UncompressedData, true);
+		ModuleReader.ArIsSaveGame = true;
+		ModuleReader.SetUEVer(SaveHeader.PackageFileUEVersion);
+		ModuleReader.SetEngineVer(SaveHeader.SavedEngineVersion);
+		ModuleReader.SetCustomVersions(SaveHeader.CustomVersions);
+		if (InOutDecodedModule.Schema)
+		{
+			InOutDecodedModule.Module->SetSchemaForNextSerialize(InOutDecodedModule.Schema, InOutDecodedModule.SavedSchemaFields);
+		}
+		if (IsInGameThread())
+		{
+			FObjectAndNameAsStringProxyArchive ModuleArchive(ModuleReader, true);
+			ModuleArchive.ArIsSaveGame = true;
+			InOutDecodedModule.Module->Serialize(ModuleArchive);
+		}
+		else
+		{
+			FWorkerThreadModuleArchive ModuleArchive(ModuleReader);
+			InOutDecodedModule.Module->Serialize(ModuleArchive);
+			InOutDecodedModule.bHasUnresolvedReferences = ModuleArchive.bHasUnresolvedReferences;
+		}
+
+		InOutDecodedModule.bSucceeded = !ModuleReader.IsError();
+		InOutDecodedModule.DecodeTime = (FPlatformTime::Seconds() - StartTime);
+	}
+
+	bool TryDeserializeModules(const TArray<uint8>& InSaveData, FMemoryReader& MemoryReader, const FModularSaveGameHeader& SaveHeader, UObject& ModuleOuter,
+		TMap<FName, TObjectPtr<USaveGameModule>>& OutModules, double& OutDecompressionTime, TMap<FName, double>& OutModuleTimes)
+	{
+		FModuleTable ModuleTable;
+		ModuleTable.Serialize(MemoryReader, SaveHeader.SaveGameFileVersion);
+		if (MemoryReader.IsError())
+			return false;
+
+		// Create all module objects on the game thread first:
+		TArray<FDecodedModule> DecodedModules;
+		for (const FModuleTableEntry& Entry : ModuleTable.Entries)
+		{
+			const int64 BlockOffset = MemoryReader.Tell();
+			if (Entry.StoredSize < 0 || Entry.UncompressedSize < Entry.StoredSize || BlockOffset + Entry.StoredSize > InSaveData.Num())
+			{
+				UE_LOG(LogSaveGameService, Error, TEXT("Module table of SaveGame is corrupt at module \"%s\"."), *Entry.ModuleName);
+				return false;
+			}
+			MemoryReader.Seek(BlockOffset + Entry.StoredSize);
+
+			UClass* ModuleClass = UClass::TryFindTypeSlow<UClass>(Entry.ClassPath);
+			if (!ModuleClass)
+			{
+				ModuleClass = LoadObject<UClass>(nullptr, *Entry.ClassPath);
+			}
+			if (!ModuleClass || !ModuleClass->IsChildOf<USaveGameModule>())
+			{
+				UE_LOG(LogSaveGameService, Warning, TEXT("Skipped SaveGame module \"%s\", because its class \"%s\" does not exist."), *Entry.ModuleName, *Entry.ClassPath);
+				continue;
+			}
+
+			FDecodedModule& DecodedModule = DecodedModules.AddDefaulted_GetRef();
+			DecodedModule.Entry = &Entry;
+			DecodedModule.BlockOffset = BlockOffset;
+			DecodedModule.Module = NewObject<USaveGameModule>(&ModuleOuter, ModuleClass);
+
+			// Modules are read positionally if their schema did not change, otherwise their fields are matched by name:
+			if (Entry.SchemaHash != 0)
+			{
+				DecodedModule.Schema = &FSaveGameSchema::FindOrCompile(*ModuleClass);
+				if (DecodedModule.Schema->GetHash() != Entry.SchemaHash)
+				{
+					DecodedModule.SavedSchemaFields = ModuleTable.SchemaFields.Find(Entry.SchemaHash);
+					if (!DecodedModule.SavedSchemaFields)
+					{
+						UE_LOG(LogSaveGameService, Error, TEXT("Module table of SaveGame is missing the schema of module \"%s\"."), *Entry.ModuleName);
+						return false;
+					}
+					UE_LOG(LogSaveGameService, Verbose, TEXT("Schema of SaveGame module \"%s\" changed since saving, matching its fields by name."), *Entry.ModuleName);
+				}
+			}
+		}
+
+		// Decompress and parse the module blocks in parallel. Modules that don't support this go first, on the game thread:
+		const FName CompressionFormat(*ModuleTable.CompressionFormat);
+		const double DecodeStartTime = FPlatformTime::Seconds();
+		TArray<FDecodedModule*> ParallelDecodedModules;
+		for (FDecodedModule& DecodedModule : DecodedModules)
+		{
+			if (DecodedModule.Module->bSupportsParallelSerialization)
+			{
+				ParallelDecodedModules.Add(&DecodedModule);
+				continue;
+			}
+			DecodeModule(DecodedModule, InSaveData, SaveHeader, CompressionFormat);
+		}
+		ParallelFor(ParallelDecodedModules.Num(), [&](int32 Index)
+		{
+			DecodeModule(*ParallelDecodedModules[Index], InSaveData, SaveHeader, CompressionFormat);
+		}, GetDefault<USaveGameServiceSettings>()->bParallelModuleSerialization ? EParallelForFlags::Unbalanced : EParallelForFlags::ForceSingleThread);
+		const double DecodeTime = (FPlatformTime::Seconds() - DecodeStartTime);
+
+		double TotalDecodeTime = 0.0, TotalDecompressionTime = 0.0;
+		for (FDecodedModule& DecodedModule : DecodedModules)
+		{
+			const FName ModuleName(*DecodedModule.Entry->ModuleName);
+
+			// (i) Worker threads must not load objects, so modules referencing objects that are not loaded yet are decoded again.
+			if (DecodedModule.bHasUnresolvedReferences)
+			{
+				UE_LOG(LogSaveGameService, Verbose, TEXT("SaveGame module \"%s\" references unloaded objects, decoding it again on the game thread."), *ModuleName.ToString());
+				const double PreviousDecodeTime = DecodedModule.DecodeTime;
+				DecodedModule.Module = NewObject<USaveGameModule>(&ModuleOuter, DecodedModule.Module->GetClass());
+				DecodeModule(DecodedModule, InSaveData, SaveHeader, CompressionFormat);
+				DecodedModule.DecodeTime += PreviousDecodeTime;
+			}
+
+			if (!DecodedModule.bSucceeded)
+			{
+				UE_LOG(LogSaveGameService, Error, TEXT("Failed to decode SaveGame module \"%s\" (%s)."), *ModuleName.ToString(), *ModuleTable.CompressionFormat);
+				return false;
+			}
+
+			DecodedModule.Module->PostRestoreModuleOnGameThread();
+			OutModules.Add(ModuleName, DecodedModule.Module);
+			OutModuleTimes.Add(ModuleName, DecodedModule.DecodeTime);
+			TotalDecodeTime += DecodedModule.DecodeTime;
+			TotalDecompressionTime += DecodedModule.DecompressionTime;
+		}
+
+		// Report the share of the decoding wall time that was spent on decompression:
+		OutDecompressionTime = (TotalDecodeTime > 0.0) ? (DecodeTime * TotalDecompressionTime / TotalDecodeTime) : 0.0;
+		return true;
+	}
+}
+
 bool UModularSaveGameSerializer::TrySerializeSaveGame(USaveGame& InSaveGameObject, TArray<uint8>& OutSaveData) const
 {
-	const UModularSaveGame* ModularSaveGame = Cast<UModularSaveGame>(&InSaveGameObject);
-	FMemoryWriter MemoryWriter(OutSaveData, true);
+	const int64 ExpectedSize = FMath::Max<int64>(OutSaveData.Max(), LastSizeReport.TotalBytes);
+	LastContentHash.Reset();
+	LastSizeReport.Reset();
+	LastCompressionTime = 0.0;
+	LastModuleTimes.Reset();
+
+	const USaveGameServiceSettings* Settings = GetDefault<USaveGameServiceSettings>();
+	UModularSaveGame* ModularSaveGame = Cast<UModularSaveGame>(&InSaveGameObject);
+
+	// (i) Content is serialized before the header, so the header only needs to contain the custom versions that were used.
+	// Content buffer is pooled and pre-sized like the output buffer (or for the last SaveGame), since it grows to almost the same size.
+	const TSharedRef<TArray<uint8>> ContentBuffer = GetBufferPool()->Acquire(ExpectedSize);
+	TArray<uint8>& ContentData = *ContentBuffer;
+	FMemoryWriter MemoryWriter(ContentData, true);
 	MemoryWriter.ArIsSaveGame = true;
 
-	// Serialize header data:
+	// Reserve the offset of the referenced assets table, which is only known after serializing the content:
+	int64 ReferencedAssetsOffset = 0;
+	MemoryWriter << ReferencedAssetsOffset;
+
+	// Serialize the save game object and all supported properties, except for the modules, which are stored separately:
+	TMap<FName, TObjectPtr<USaveGameModule>> Modules;
+	if (ModularSaveGame)
+	{
+		Swap(Modules, ModularSaveGame->Modules);
+	}
+	const int64 MainContentOffset = MemoryWriter.Tell();
+	FWeekendUtilsSubobjectProxyArchive Archive(MemoryWriter, InSaveGameObject);
+	InSaveGameObject.Serialize(Archive);
+	const int64 MainContentSize = (MemoryWriter.Tell() - MainContentOffset);
+	if (ModularSaveGame)
+	{
+		Swap(Modules, ModularSaveGame->Modules);
+	}
+
+	// Encode every module into its own buffer. Modules that don't support parallel encoding go first, on the game thread:
+	// (i) Modules are notified on the game thread, so that nothing needs to be broadcast from worker threads.
+	TArray<FEncodedModule> EncodedModules;
+	for (const TTuple<FName, TObjectPtr<USaveGameModule>>& NameAndModule : Modules)
+	{
+		if (!NameAndModule.Value)
+			continue;
+
+		NameAndModule.Value->PreSaveModuleOnGameThread();
+		FEncodedModule& EncodedModule = EncodedModules.AddDefaulted_GetRef();
+		EncodedModule.ModuleName = NameAndModule.Key;
+		EncodedModule.Module = NameAndModule.Value;
+		if (NameAndModule.Value->bUseCompiledSchema)
+		{
+			EncodedModule.Schema = &FSaveGameSchema::FindOrCompile(*NameAndModule.Value->GetClass());
+		}
+	}
+
+	const FName CompressionFormat = FCompression::IsFormatValid(Settings->ModuleCompressionFormat) ? Settings->ModuleCompressionFormat : NAME_None;
+	const double EncodeStartTime = FPlatformTime::Seconds();
+	TArray<FEncodedModule*> ParallelEncodedModules;
+	for (FEncodedModule& EncodedModule : EncodedModules)
+	{
+		if (EncodedModule.Module->bSupportsParallelSerialization)
+		{
+			ParallelEncodedModules.Add(&EncodedModule);
+			continue;
+		}
+		EncodeModule(EncodedModule, CompressionFormat);
+	}
+	ParallelFor(ParallelEncodedModules.Num(), [&ParallelEncodedModules, &CompressionFormat](int32 Index)
+	{
+		EncodeModule(*ParallelEncodedModules[Index], CompressionFormat);
+	}, Settings->bParallelModuleSerialization ? EParallelForFlags::Unbalanced : EParallelForFlags::ForceSingleThread);
+	const double EncodeTime = (FPlatformTime::Seconds() - EncodeStartTime);
+
+	// Write the module table, followed by the stored module blocks:
+	FModuleTable ModuleTable;
+	ModuleTable.CompressionFormat = CompressionFormat.ToString();
+	for (const FEncodedModule& EncodedModule : EncodedModules)
+	{
+		FModuleTableEntry& Entry = ModuleTable.Entries.AddDefaulted_GetRef();
+		Entry.ModuleName = EncodedModule.ModuleName.ToString();
+		Entry.ClassPath = EncodedModule.Module->GetClass()->GetPathName();
+		Entry.StoredSize = EncodedModule.StoredData.Num();
+		Entry.UncompressedSize = EncodedModule.UncompressedSize;
+		if (EncodedModule.Schema)
+		{
+			Entry.SchemaHash = EncodedModule.Schema->GetHash();
+			ModuleTable.SchemaFields.Add(Entry.SchemaHash, EncodedModule.Schema->GetFields());
+		}
+	}
+	ModuleTable.Serialize(MemoryWriter, MODULAR_SAVEGAME_FILE_VERSION);
+	for (const FEncodedModule& EncodedModule : EncodedModules)
+	{
+		MemoryWriter.Serialize(const_cast<uint8*>(EncodedModule.StoredData.GetData()), EncodedModule.StoredData.Num());
+	}
+
+	// Append the referenced assets table (see GetUnloadedReferencedAssets):
+	TSet<FString> ReferencedAssetPathSet = MoveTemp(Archive.ReferencedAssetPaths);
+	for (const FEncodedModule& EncodedModule : EncodedModules)
+	{
+		ReferencedAssetPathSet.Append(EncodedModule.ReferencedAssetPaths);
+	}
+	ReferencedAssetsOffset = MemoryWriter.Tell();
+	TArray<FString> ReferencedAssetPaths = ReferencedAssetPathSet.Array();
+	ReferencedAssetPaths.Sort();
+	MemoryWriter << ReferencedAssetPaths;
+
+	// Serialize header data, with only the custom versions used by the header data, the content and the modules:
 	const FInstancedStruct CustomHeaderData = (ModularSaveGame && ModularSaveGame->GetInstancedHeaderData().IsValid())
 		? *ModularSaveGame->GetInstancedHeaderData()
 		: FInstancedStruct::Make<FSimpleSaveGameHeaderData>();
 	FModularSaveGameHeader SaveHeader(InSaveGameObject.GetClass(), CustomHeaderData);
-	if (!SaveHeader.TryWrite(MemoryWriter))
+	SaveHeader.CustomVersions = GetUsedCustomVersions(CustomHeaderData, MemoryWriter.GetCustomVersions(), EncodedModules);
+
+	FMemoryWriter HeaderWriter(OutSaveData, true);
+	HeaderWriter.ArIsSaveGame = true;
+	if (!SaveHeader.TryWrite(HeaderWriter))
 		return false;
 
-	// Serialize the save game object and all supported properties:
-	FWeekendUtilsSubobjectProxyArchive Archive(MemoryWriter, InSaveGameObject);
-	InSaveGameObject.Serialize(Archive);
+	// Append the content and make the offset of the referenced assets table absolute:
+	const int64 ContentOffset = HeaderWriter.Tell();
+	ReferencedAssetsOffset += ContentOffset;
+	OutSaveData.Append(ContentData);
+	HeaderWriter.Seek(ContentOffset);
+	HeaderWriter << ReferencedAssetsOffset;
+
+	// Hash content and header data, without what changes with every save (save counter, timestamps, modules that opted out):
+	FXxHash64Builder ContentHashBuilder;
+	const uint64 HeaderDataHash = HashHeaderDataContent(CustomHeaderData);
+	ContentHashBuilder.Update(&HeaderDataHash, sizeof(uint64));
+	ContentHashBuilder.Update(ContentData.GetData() + MainContentOffset, MainContentSize);
+	for (const FEncodedModule& EncodedModule : EncodedModules)
+	{
+		if (!EncodedModule.Module->bAffectsContentHash)
+			continue;
+
+		const FString ModuleName = EncodedModule.ModuleName.ToString();
+		ContentHashBuilder.Update(*ModuleName, ModuleName.Len() * sizeof(TCHAR));
+		ContentHashBuilder.Update(&EncodedModule.UncompressedHash, sizeof(uint64));
+	}
+	LastContentHash = ContentHashBuilder.Finalize().Hash;
+
+	// Report the share of the encoding wall time that was spent on compression:
+	double TotalEncodeTime = 0.0, TotalCompressionTime = 0.0;
+	for (const FEncodedModule& EncodedModule : EncodedModules)
+	{
+		TotalEncodeTime += EncodedModule.EncodeTime + EncodedModule.CompressionTime;
+		TotalCompressionTime += EncodedModule.CompressionTime;
+		LastModuleTimes.Add(EncodedModule.ModuleName, EncodedModule.EncodeTime + EncodedModule.CompressionTime);
+	}
+	LastCompressionTime = (TotalEncodeTime > 0.0) ? (EncodeTime * TotalCompressionTime / TotalEncodeTime) : 0.0;
+
+	// Account bytes per part, to find out what the save size is made of:
+	LastSizeReport.TotalBytes = OutSaveData.Num();
+	LastSizeReport.HeaderBytes = ContentOffset;
+	for (const FEncodedModule& EncodedModule : EncodedModules)
+	{
+		LastSizeReport.BytesByModule.Add(EncodedModule.ModuleName, EncodedModule.StoredData.Num());
+		if (const ULevelObjectRestorer* LevelObjectRestorer = Cast<ULevelObjectRestorer>(EncodedModule.Module))
+		{
+			for (const TTuple<FName, int64>& ClassAndBytes : LevelObjectRestorer->GetLastSavedSizesByObjectClass())
+			{
+				LastSizeReport.BytesByLevelObjectClass.FindOrAdd(ClassAndBytes.Key) += ClassAndBytes.Value;
+			}
+		}
+	}
 
 	return true;
 }
@@ -181,6 +736,8 @@ bool UModularSaveGameSerializer::TrySerializeSaveGame(USaveGame& InSaveGameObjec
 bool UModularSaveGameSerializer::TryDeserializeSaveGame(const TArray<uint8>& InSaveData, USaveGame*& OutSaveGameObject) const
 {
 	OutSaveGameObject = nullptr;
+	LastCompressionTime = 0.0;
+	LastModuleTimes.Reset();
 	if (InSaveData.IsEmpty())
 		return false;
 
@@ -202,15 +759,106 @@ bool UModularSaveGameSerializer::TryDeserializeSaveGame(const TArray<uint8>& InS
 	if (!SaveGameClass)
 		return false;
 
+	// Skip the offset of the referenced assets table, which is only needed for preloading:
+	if (SaveHeader.SaveGameFileVersion >= MODULAR_SAVEGAME_FILE_VERSION_REFERENCED_ASSETS)
+	{
+		int64 ReferencedAssetsOffset = 0;
+		MemoryReader << ReferencedAssetsOffset;
+	}
+
 	// Create (empty) save game object and then restore all of its saved properties:
 	OutSaveGameObject = NewObject<USaveGame>(GetOuter(), SaveGameClass);
 	FWeekendUtilsSubobjectProxyArchive Archive(MemoryReader, *OutSaveGameObject);
+	Archive.bUseObjectIdentityTable = (SaveHeader.SaveGameFileVersion >= MODULAR_SAVEGAME_FILE_VERSION_OBJECT_IDENTITY);
 	OutSaveGameObject->Serialize(Archive);
 
-	if (UModularSaveGame* ModularSaveGame = Cast<UModularSaveGame>(OutSaveGameObject))
+	UModularSaveGame* ModularSaveGame = Cast<UModularSaveGame>(OutSaveGameObject);
+	if (ModularSaveGame && SaveHeader.SaveGameFileVersion >= MODULAR_SAVEGAME_FILE_VERSION_MODULE_TABLE)
+	{
+		if (!TryDeserializeModules(InSaveData, MemoryReader, SaveHeader, *ModularSaveGame, OUT ModularSaveGame->Modules, OUT LastCompressionTime, OUT LastModuleTimes))
+			return false;
+	}
+
+	if (ModularSaveGame)
 	{
 		ModularSaveGame->SetInstancedHeaderData(SaveHeader.CustomHeaderData);
 	}
 
 	return true;
 }
+
+void UModularSaveGameSerializer::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	// Compile the schemas of all loaded module classes at startup, instead of during the first save:
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		TArray<const UStruct*> ModuleClasses;
+		for (TObjectIterator<UClass> ClassItr; ClassItr; ++ClassItr)
+		{
+			if (ClassItr->IsChildOf<USaveGameModule>() && !ClassItr->HasAnyClassFlags(CLASS_Abstract)
+				&& GetDefault<USaveGameModule>(*ClassItr)->bUseCompiledSchema)
+			{
+				ModuleClasses.Add(*ClassItr);
+			}
+		}
+		FSaveGameSchema::Precompile(ModuleClasses);
+	}
+}
+
+void UModularSaveGameSerializer::GetUnloadedReferencedAssets(const TArray<uint8>& InSaveData, TArray<FSoftObjectPath>& OutAssetPaths) const
+{
+	OutAssetPaths.Reset();
+	if (InSaveData.IsEmpty())
+		return;
+
+	FMemoryReader MemoryReader(InSaveData, true);
+	MemoryReader.ArIsSaveGame = true;
+
+	FModularSaveGameHeader SaveHeader;
+	if (!SaveHeader.TryRead(MemoryReader) || SaveHeader.SaveGameFileVersion < MODULAR_SAVEGAME_FILE_VERSION_REFERENCED_ASSETS)
+		return;
+
+	int64 ReferencedAssetsOffset = 0;
+	MemoryReader << ReferencedAssetsOffset;
+	if (ReferencedAssetsOffset <= MemoryReader.Tell() || ReferencedAssetsOffset >= InSaveData.Num())
+		return;
+
+	// (i) Only the header and the table at the end are read, the content in between is not touched.
+	TArray<FString> ReferencedAssetPaths;
+	MemoryReader.Seek(ReferencedAssetsOffset);
+	MemoryReader << ReferencedAssetPaths;
+	if (MemoryReader.IsError())
+		return;
+
+	for (const FString& AssetPath : ReferencedAssetPaths)
+	{
+		FSoftObjectPath SoftObjectPath(AssetPath);
+		if (SoftObjectPath.IsValid() && !SoftObjectPath.ResolveObject())
+		{
+			OutAssetPaths.Add(MoveTemp(SoftObjectPath));
+		}
+	}
+}
+
+bool UModularSaveGameSerializer::TryReadHeaderFromSaveData(const TArray<uint8>& InSaveData, FSaveGameSlotManifestEntry& OutEntry) const
+{
+	if (InSaveData.IsEmpty())
+		return false;
+
+	FMemoryReader MemoryReader(InSaveData, true);
+	MemoryReader.ArIsSaveGame = true;
+
+	// (i) Only the header is read, the rest of the save data is not touched. It may also be missing completely,
+	// when only the beginning of the save file was read (see @USaveGameSerializer::TryReadHeaderFromSlotFile).
+	FModularSaveGameHeader SaveHeader;
+	if (!SaveHeader.TryRead(MemoryReader) || MemoryReader.IsError())
+		return false;
+
+	OutEntry.SaveGameFileVersion = SaveHeader.SaveGameFileVersion;
+	OutEntry.SavedEngineVersion = SaveHeader.SavedEngineVersion;
+	OutEntry.SaveGameClassName = SaveHeader.SaveGameClassName;
+	OutEntry.CustomHeaderData = SaveHeader.CustomHeaderData;
+	return true;
+}
@@ -154,6 +154,7 @@ void ULevelObjectRestorer::UnregisterLevelObjectWithTransform(USceneComponent& S
 
 void ULevelObjectRestorer::Serialize(FArchive& Ar)
 {
+	TMap<FString, FName> ClassNamesByObjectId;
 	for (TWeakObjectPtr<> RegisteredObject : SimpleRegisteredObjects.Union(RegisteredObjectsWithTransform))
 	{
 		if (!RegisteredObject.IsValid())
@@ -166,6 +167,7 @@ void ULevelObjectRestorer::Serialize(FArchive& Ar)
 		if (Ar.IsSaving())
 		{
 			SaveObjectToState(*Object, bHasTransform, IN OUT State);
+			ClassNamesByObjectId.Add(ObjectId, Object->GetClass()->GetFName());
 		}
 		else
 		{
@@ -173,6 +175,19 @@ void ULevelObjectRestorer::Serialize(FArchive& Ar)
 		}
 	}
 
+	// Size accounting by object class (see UModularSaveGameSerializer):
+	if (Ar.IsSaving() && Ar.ArIsSaveGame)
+	{
+		static const FName UnregisteredClassName = "Unregistered";
+		LastSavedSizesByObjectClass.Reset();
+		for (const TTuple<FString, FLevelObjectSaveGameState>& IdAndState : ObjectStates)
+		{
+			const FName* ClassName = ClassNamesByObjectId.Find(IdAndState.Key);
+			const int64 NumBytes = IdAndState.Value.ByteData.Num() + IdAndState.Key.Len() * sizeof(TCHAR);
+			LastSavedSizesByObjectClass.FindOrAdd(ClassName ? *ClassName : UnregisteredClassName) += NumBytes;
+		}
+	}
+
 	Super::Serialize(Ar);
 }
 
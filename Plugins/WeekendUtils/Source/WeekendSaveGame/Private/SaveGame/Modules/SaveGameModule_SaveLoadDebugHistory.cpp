@@ -11,6 +11,7 @@
 
 #include "GameService/GameServiceLocator.h"
 #include "SaveGame/SaveGameService.h"
+#include "SaveGame/Settings/SaveGameServiceSettings.h"
 
 void USaveGameModule_SaveLoadDebugHistory::PreSaveModule()
 {
@@ -22,6 +23,7 @@ void USaveGameModule_SaveLoadDebugHistory::PreSaveModule()
 	}
 	if (SaveGameService)
 	{
-		DebugHistory = SaveGameService->GetDebugHistory();
+		// (i) Only a bounded tail is saved, to keep the save file size independent of the session length.
+		DebugHistory = SaveGameService->GetDebugHistory().FormatMostRecent(GetDefault<USaveGameServiceSettings>()->DebugHistoryEntriesToSave);
 	}
 }
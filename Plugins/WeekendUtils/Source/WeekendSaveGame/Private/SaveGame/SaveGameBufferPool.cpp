@@ -0,0 +1,197 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#include "SaveGame/SaveGameBufferPool.h"
+
+#include "WeekendSaveGame.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Buffer Pool: Hits"), STAT_SaveGame_BufferPool_Hits, STATGROUP_SaveGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Buffer Pool: Reallocations Avoided"), STAT_SaveGame_BufferPool_ReallocationsAvoided, STATGROUP_SaveGame);
+DECLARE_MEMORY_STAT(TEXT("Buffer Pool: Pooled Size"), STAT_SaveGame_BufferPool_PooledBytes, STATGROUP_SaveGame);
+DECLARE_MEMORY_STAT(TEXT("Buffer Pool: In Use Size"), STAT_SaveGame_BufferPool_InUseBytes, STATGROUP_SaveGame);
+DECLARE_MEMORY_STAT(TEXT("Buffer Pool: Peak Size"), STAT_SaveGame_BufferPool_PeakBytes, STATGROUP_SaveGame);
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveGameBufferPoolStats
+
+FString FSaveGameBufferPoolStats::ToString() const
+{
+	const double HitPercent = (NumAcquires > 0 ? 100.0 * NumHits / NumAcquires : 0.0);
+	return FString::Printf(TEXT("SaveGame buffer pool: %d acquires, %d hits (%.1f%%), %d reallocations avoided, %d grown buffers, %.1f KiB pooled, %.1f KiB in use, %.1f KiB peak"),
+		NumAcquires, NumHits, HitPercent, NumReallocationsAvoided, NumGrownBuffers, PooledBytes / 1024.0, InUseBytes / 1024.0, PeakBytes / 1024.0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveGameBufferPool
+
+FSaveGameBufferPool::FSaveGameBufferPool(int64 InMaxPooledBytes) :
+	MaxPooledBytes(FMath::Max<int64>(InMaxPooledBytes, 0))
+{
+}
+
+TSharedRef<TArray<uint8>> FSaveGameBufferPool::Acquire(int64 MinCapacity)
+{
+	const int32 Capacity = static_cast<int32>(FMath::Clamp<int64>(MinCapacity, 0, MAX_int32));
+
+	TUniquePtr<TArray<uint8>> Buffer = nullptr;
+	{
+		FScopeLock Lock(&Mutex);
+		++Stats.NumAcquires;
+
+		// Smallest pooled buffer that fits, otherwise the largest one, which has to grow the least:
+		int32 BestIndex = INDEX_NONE;
+		for (int32 Index = 0; Index < PooledBuffers.Num(); ++Index)
+		{
+			const int32 Max = PooledBuffers[Index]->Max();
+			const int32 BestMax = (BestIndex != INDEX_NONE ? PooledBuffers[BestIndex]->Max() : -1);
+			const bool bFits = (Max >= Capacity);
+			const bool bBestFits = (BestMax >= Capacity);
+			if (BestIndex == INDEX_NONE || (bFits && (!bBestFits || Max < BestMax)) || (!bFits && !bBestFits && Max > BestMax))
+			{
+				BestIndex = Index;
+			}
+		}
+
+		if (BestIndex != INDEX_NONE)
+		{
+			Buffer = MoveTemp(PooledBuffers[BestIndex]);
+			PooledBuffers.RemoveAtSwap(BestIndex);
+			Stats.PooledBytes -= Buffer->Max();
+			if (Buffer->Max() >= Capacity)
+			{
+				++Stats.NumHits;
+			}
+		}
+	}
+
+	if (!Buffer.IsValid())
+	{
+		Buffer = MakeUnique<TArray<uint8>>();
+	}
+	Buffer->Reserve(Capacity);
+	const int64 HandedOutCapacity = Buffer->Max();
+
+	{
+		FScopeLock Lock(&Mutex);
+		Stats.InUseBytes += HandedOutCapacity;
+		UpdateStats();
+	}
+
+	// (i) Returns to the pool when the last reference is released, unless the pool is gone by then:
+	const TWeakPtr<FSaveGameBufferPool, ESPMode::ThreadSafe> WeakPool = AsShared();
+	return MakeShareable(Buffer.Release(), [WeakPool, HandedOutCapacity](TArray<uint8>* ReleasedBuffer)
+	{
+		if (const TSharedPtr<FSaveGameBufferPool, ESPMode::ThreadSafe> Pool = WeakPool.Pin())
+		{
+			Pool->Release(ReleasedBuffer, HandedOutCapacity);
+		}
+		else
+		{
+			delete ReleasedBuffer;
+		}
+	});
+}
+
+TSharedRef<TArray<uint8>> FSaveGameBufferPool::AcquireForSlot(const FSlotName& SlotName)
+{
+	// (i) Some headroom, as SaveGames usually grow a bit over time:
+	const int64 ExpectedSize = GetExpectedSlotSize(SlotName);
+	return Acquire(ExpectedSize + ExpectedSize / 16);
+}
+
+void FSaveGameBufferPool::RecordSlotSize(const FSlotName& SlotName, int64 NumBytes)
+{
+	FScopeLock Lock(&Mutex);
+	ExpectedSizeBySlot.Add(SlotName, NumBytes);
+}
+
+int64 FSaveGameBufferPool::GetExpectedSlotSize(const FSlotName& SlotName) const
+{
+	FScopeLock Lock(&Mutex);
+	const int64* ExpectedSize = ExpectedSizeBySlot.Find(SlotName);
+	return (ExpectedSize ? *ExpectedSize : 0);
+}
+
+void FSaveGameBufferPool::Trim()
+{
+	// (i) Buffers are freed after the lock was released:
+	TArray<TUniquePtr<TArray<uint8>>> BuffersToFree;
+	FScopeLock Lock(&Mutex);
+	BuffersToFree = MoveTemp(PooledBuffers);
+	PooledBuffers.Reset();
+	Stats.PooledBytes = 0;
+	UpdateStats();
+}
+
+FSaveGameBufferPoolStats FSaveGameBufferPool::GetStats() const
+{
+	FScopeLock Lock(&Mutex);
+	return Stats;
+}
+
+void FSaveGameBufferPool::Release(TArray<uint8>* Buffer, int64 HandedOutCapacity)
+{
+	// (i) Buffers that don't fit into the budget are freed after the lock was released:
+	TArray<TUniquePtr<TArray<uint8>>> BuffersToFree;
+	TUniquePtr<TArray<uint8>> ReleasedBuffer(Buffer);
+	const int64 NumBytesUsed = ReleasedBuffer->Num();
+	const int64 Capacity = ReleasedBuffer->Max();
+	ReleasedBuffer->Reset();
+
+	FScopeLock Lock(&Mutex);
+	Stats.InUseBytes -= HandedOutCapacity;
+	if (Capacity > HandedOutCapacity)
+	{
+		++Stats.NumGrownBuffers;
+	}
+	else
+	{
+		Stats.NumReallocationsAvoided += EstimateNumReallocations(NumBytesUsed);
+	}
+
+	if (Capacity > 0 && Capacity <= MaxPooledBytes)
+	{
+		// Make room by freeing the smallest pooled buffers first, which are the least likely to be reused:
+		PooledBuffers.Sort([](const TUniquePtr<TArray<uint8>>& A, const TUniquePtr<TArray<uint8>>& B) { return A->Max() > B->Max(); });
+		while (Stats.PooledBytes + Capacity > MaxPooledBytes)
+		{
+			Stats.PooledBytes -= PooledBuffers.Last()->Max();
+			BuffersToFree.Add(PooledBuffers.Pop());
+		}
+		Stats.PooledBytes += Capacity;
+		PooledBuffers.Add(MoveTemp(ReleasedBuffer));
+	}
+	else
+	{
+		BuffersToFree.Add(MoveTemp(ReleasedBuffer));
+	}
+	UpdateStats();
+}
+
+void FSaveGameBufferPool::UpdateStats()
+{
+	Stats.PeakBytes = FMath::Max(Stats.PeakBytes, Stats.PooledBytes + Stats.InUseBytes);
+
+	SET_DWORD_STAT(STAT_SaveGame_BufferPool_Hits, Stats.NumHits);
+	SET_DWORD_STAT(STAT_SaveGame_BufferPool_ReallocationsAvoided, Stats.NumReallocationsAvoided);
+	SET_MEMORY_STAT(STAT_SaveGame_BufferPool_PooledBytes, Stats.PooledBytes);
+	SET_MEMORY_STAT(STAT_SaveGame_BufferPool_InUseBytes, Stats.InUseBytes);
+	SET_MEMORY_STAT(STAT_SaveGame_BufferPool_PeakBytes, Stats.PeakBytes);
+}
+
+int32 FSaveGameBufferPool::EstimateNumReallocations(int64 NumBytes)
+{
+	// (i) Approximates the default slack growth of TArray (see DefaultCalculateSlackGrow), which grows by 3/8 plus a constant:
+	int32 NumReallocations = 0;
+	for (int64 Max = 0; Max < NumBytes; Max += (3 * Max / 8 + 16))
+	{
+		++NumReallocations;
+	}
+	return NumReallocations;
+}
@@ -37,6 +37,44 @@ DEFINE_CHEAT_COLLECTION(WeekendSaveGameCheats, AsCheatMenuTab("Save/Load"))
 		SaveGameService->RequestLoadCurrentSaveGameFromSlot("Cheat.SaveGame.LoadAutosave", SaveGameService->GetAutosaveSlotName());
 	}
 
+	DEFINE_CHEAT_COMMAND(PrintMetricsCheat, "Cheat.SaveGame.PrintMetrics")
+	.DisplayAs("Print Save/Load Metrics")
+	DEFINE_CHEAT_EXECUTE(PrintMetricsCheat)
+	{
+		const USaveGameService* SaveGameService = UGameServiceLocator::FindService<USaveGameService>();
+		if (LogInvalidity(SaveGameService, "SaveGameService not available"))
+			return;
+
+		LogInfo(SaveGameService->GetSaveLoadMetrics().ToString());
+		if (const USaveGameSerializer* SaveGameSerializer = SaveGameService->GetSaveGameSerializer())
+		{
+			LogInfo(SaveGameSerializer->GetBufferPool()->GetStats().ToString());
+		}
+	}
+
+	DEFINE_CHEAT_COMMAND(PrintSizeReportCheat, "Cheat.SaveGame.PrintSizeReport")
+	.DisplayAs("Print SaveGame Size Report")
+	DEFINE_CHEAT_EXECUTE(PrintSizeReportCheat)
+	{
+		USaveGameService* SaveGameService = UGameServiceLocator::FindService<USaveGameService>();
+		if (LogInvalidity(SaveGameService, "SaveGameService not available"))
+			return;
+
+		LogInfo(SaveGameService->MeasureCurrentSaveGameSize().ToString());
+	}
+
+	DEFINE_CHEAT_COMMAND(VerifyChunkStoreCheat, "Cheat.SaveGame.VerifyChunkStore")
+	.DisplayAs("Verify & Repair SaveGame Chunk Store")
+	DEFINE_CHEAT_EXECUTE(VerifyChunkStoreCheat)
+	{
+		const USaveGameService* SaveGameService = UGameServiceLocator::FindService<USaveGameService>();
+		USaveGameSerializer* SaveGameSerializer = (SaveGameService ? SaveGameService->GetSaveGameSerializer() : nullptr);
+		if (LogInvalidity(SaveGameSerializer, "SaveGameSerializer not available"))
+			return;
+
+		LogInfo(SaveGameSerializer->VerifyChunkStoreIntegrity(true).ToString());
+	}
+
 #if WITH_EDITOR
 	DEFINE_CHEAT_COMMAND(OpenSaveGameEditorCheat, "Cheat.SaveGame.OpenEditor")
 	.DisplayAs("Open SaveGame Editor")
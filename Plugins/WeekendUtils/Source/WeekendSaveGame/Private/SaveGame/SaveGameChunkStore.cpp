@@ -0,0 +1,491 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#include "SaveGame/SaveGameChunkStore.h"
+
+#include "HAL/FileManager.h"
+#include "Hash/xxhash.h"
+#include "Misc/FileHelper.h"
+#include "SaveGame/SaveGameStorageBackend.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSaveGameChunkStore, Log, All);
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// UTILS
+
+namespace
+{
+	/** Random value per byte value, which is rolled into the hash that decides chunk boundaries ("gear hash"). */
+	struct FGearTable
+	{
+		uint64 Values[256];
+
+		FGearTable()
+		{
+			// (i) Deterministic (SplitMix64), since chunk boundaries must be the same in every session and on every platform.
+			uint64 State = 0x9E3779B97F4A7C15ull;
+			for (uint64& Value : Values)
+			{
+				State += 0x9E3779B97F4A7C15ull;
+				uint64 Z = State;
+				Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+				Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+				Value = Z ^ (Z >> 31);
+			}
+		}
+	};
+
+	const FGearTable& GetGearTable()
+	{
+		static const FGearTable GearTable;
+		return GearTable;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveGameChunkId
+
+FSaveGameChunkId FSaveGameChunkId::FromData(const uint8* Data, int32 Size)
+{
+	const FXxHash128 Hash = FXxHash128::HashBuffer(Data, Size);
+	FSaveGameChunkId ChunkId;
+	ChunkId.HashHigh = Hash.Hi;
+	ChunkId.HashLow = Hash.Lo;
+	ChunkId.Size = Size;
+	return ChunkId;
+}
+
+FString FSaveGameChunkId::ToString() const
+{
+	return FString::Printf(TEXT("%016llx%016llx"), HashHigh, HashLow);
+}
+
+void FSaveGameChunkId::Serialize(FArchive& Ar)
+{
+	Ar << HashHigh;
+	Ar << HashLow;
+	Ar << Size;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveGameChunkList
+
+bool FSaveGameChunkList::IsChunkListData(const TArray<uint8>& InFileData)
+{
+	int32 FileTypeTag = 0;
+	if (InFileData.Num() < static_cast<int32>(sizeof(FileTypeTag)))
+		return false;
+
+	FMemoryReader MemoryReader(InFileData, true);
+	MemoryReader << FileTypeTag;
+	return (FileTypeTag == MODULAR_SAVEGAME_CHUNK_LIST_FILE_TYPE_TAG);
+}
+
+bool FSaveGameChunkList::TryReadFromData(const TArray<uint8>& InFileData)
+{
+	FMemoryReader MemoryReader(InFileData, true);
+
+	int32 FileTypeTag = 0;
+	int32 FileVersion = 0;
+	MemoryReader << FileTypeTag;
+	MemoryReader << FileVersion;
+	if (FileTypeTag != MODULAR_SAVEGAME_CHUNK_LIST_FILE_TYPE_TAG || FileVersion != MODULAR_SAVEGAME_CHUNK_LIST_FILE_VERSION)
+		return false;
+
+	int32 NumChunks = 0;
+	MemoryReader << TotalSize;
+	MemoryReader << DataHash;
+	MemoryReader << NumChunks;
+	if (MemoryReader.IsError() || NumChunks < 0 || NumChunks > (MemoryReader.TotalSize() - MemoryReader.Tell()))
+		return false;
+
+	Chunks.SetNum(NumChunks);
+	for (FSaveGameChunkId& ChunkId : Chunks)
+	{
+		ChunkId.Serialize(MemoryReader);
+	}
+	return !MemoryReader.IsError();
+}
+
+void FSaveGameChunkList::WriteToData(TArray<uint8>& OutFileData) const
+{
+	FMemoryWriter MemoryWriter(OutFileData, true);
+
+	int32 FileTypeTag = MODULAR_SAVEGAME_CHUNK_LIST_FILE_TYPE_TAG;
+	int32 FileVersion = MODULAR_SAVEGAME_CHUNK_LIST_FILE_VERSION;
+	int64 TotalSizeToWrite = TotalSize;
+	uint64 DataHashToWrite = DataHash;
+	int32 NumChunks = Chunks.Num();
+	MemoryWriter << FileTypeTag;
+	MemoryWriter << FileVersion;
+	MemoryWriter << TotalSizeToWrite;
+	MemoryWriter << DataHashToWrite;
+	MemoryWriter << NumChunks;
+	for (FSaveGameChunkId ChunkId : Chunks)
+	{
+		ChunkId.Serialize(MemoryWriter);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveGameChunkStoreIntegrityReport
+
+FString FSaveGameChunkStoreIntegrityReport::ToString() const
+{
+	FString Result = FString::Printf(TEXT("SaveGame chunk store is %s: %d referenced chunks (%.1f KiB, %.1f KiB on disk), %d missing, %d corrupt, %d unreferenced, %d wrong reference counts"),
+		IsHealthy() ? TEXT("healthy") : TEXT("BROKEN"), NumReferencedChunks, ReferencedBytes / 1024.0, StoredBytes / 1024.0,
+		NumMissingChunks, NumCorruptChunks, NumUnreferencedChunks, NumWrongReferenceCounts);
+	for (const FString& BrokenChunkList : BrokenChunkLists)
+	{
+		Result += FString::Printf(TEXT("\n  - Can't be loaded: %s"), *BrokenChunkList);
+	}
+	return Result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveGameChunkStore
+
+FSaveGameChunkStore::FSaveGameChunkStore(const FString& InDirectory) :
+	Directory(InDirectory)
+{
+}
+
+FSaveGameChunkList FSaveGameChunkStore::SplitIntoChunks(const TArray<uint8>& InData)
+{
+	FSaveGameChunkList ChunkList;
+	ChunkList.TotalSize = InData.Num();
+	ChunkList.DataHash = FXxHash64::HashBuffer(InData.GetData(), InData.Num()).Hash;
+	ChunkList.Chunks.Reserve(InData.Num() / (MinChunkSize + (1 << ChunkBoundaryBits)) + 1);
+
+	int32 Offset = 0;
+	while (Offset < InData.Num())
+	{
+		const int32 ChunkSize = FindChunkBoundary(InData.GetData() + Offset, InData.Num() - Offset);
+		ChunkList.Chunks.Add(FSaveGameChunkId::FromData(InData.GetData() + Offset, ChunkSize));
+		Offset += ChunkSize;
+	}
+	return ChunkList;
+}
+
+bool FSaveGameChunkStore::TryWriteChunks(const TArray<uint8>& InData, const FSaveGameChunkList& ChunkList, int64& OutWrittenBytes, FSaveGameWriteThrottle* Throttle) const
+{
+	OutWrittenBytes = 0;
+	if (ChunkList.TotalSize != InData.Num())
+		return false;
+
+	IFileManager& FileManager = IFileManager::Get();
+	int64 Offset = 0;
+	for (const FSaveGameChunkId& ChunkId : ChunkList.Chunks)
+	{
+		const FString ChunkFilePath = GetChunkFilePath(ChunkId);
+		const TArrayView<const uint8> ChunkData(InData.GetData() + Offset, ChunkId.Size);
+		Offset += ChunkId.Size;
+
+		// Chunk is already stored (by this or any other slot):
+		if (FileManager.FileSize(*ChunkFilePath) == ChunkId.Size)
+			continue;
+
+		// (i) Write to a temporary file first, so a crash or power loss during the write can never leave a half-written
+		// chunk behind, which would be mistaken for a complete one. Temp file is per thread, as slots may be written in parallel.
+		const FString TempFilePath = FString::Printf(TEXT("%s.%u.tmp"), *ChunkFilePath, FPlatformTLS::GetCurrentThreadId());
+		const double WriteStartTime = FPlatformTime::Seconds();
+		if (!FFileHelper::SaveArrayToFile(ChunkData, *TempFilePath) || !FileManager.Move(*ChunkFilePath, *TempFilePath, true))
+		{
+			UE_LOG(LogSaveGameChunkStore, Warning, TEXT("Failed to write SaveGame chunk: %s"), *ChunkFilePath);
+			FileManager.Delete(*TempFilePath, false, false, true);
+			return false;
+		}
+		OutWrittenBytes += ChunkId.Size;
+
+		if (Throttle)
+		{
+			Throttle->ThrottleBlock(ChunkId.Size, FPlatformTime::Seconds() - WriteStartTime);
+		}
+	}
+	return true;
+}
+
+bool FSaveGameChunkStore::TryAssembleData(const FSaveGameChunkList& ChunkList, TArray<uint8>& OutData) const
+{
+	OutData.Reset(ChunkList.TotalSize);
+
+	TArray<uint8> ChunkData;
+	for (const FSaveGameChunkId& ChunkId : ChunkList.Chunks)
+	{
+		if (!TryReadChunk(ChunkId, OUT ChunkData))
+		{
+			UE_LOG(LogSaveGameChunkStore, Error, TEXT("SaveGame chunk %s is missing or corrupt."), *ChunkId.ToString());
+			return false;
+		}
+		OutData.Append(ChunkData);
+	}
+
+	if (OutData.Num() != ChunkList.TotalSize || FXxHash64::HashBuffer(OutData.GetData(), OutData.Num()).Hash != ChunkList.DataHash)
+	{
+		UE_LOG(LogSaveGameChunkStore, Error, TEXT("Assembled SaveGame chunks don't match the expected data."));
+		OutData.Reset();
+		return false;
+	}
+	return true;
+}
+
+bool FSaveGameChunkStore::TryLoadIndex()
+{
+	ReferenceCounts.Reset();
+
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(OUT FileData, *GetIndexFilePath(), FILEREAD_Silent))
+		return false;
+
+	FMemoryReader MemoryReader(FileData, true);
+
+	int32 FileTypeTag = 0;
+	int32 FileVersion = 0;
+	MemoryReader << FileTypeTag;
+	MemoryReader << FileVersion;
+	if (FileTypeTag != MODULAR_SAVEGAME_CHUNK_INDEX_FILE_TYPE_TAG || FileVersion != MODULAR_SAVEGAME_CHUNK_INDEX_FILE_VERSION)
+	{
+		UE_LOG(LogSaveGameChunkStore, Log, TEXT("Ignoring incompatible chunk index: %s"), *GetIndexFilePath());
+		return false;
+	}
+
+	int32 NumEntries = 0;
+	MemoryReader << NumEntries;
+	ReferenceCounts.Reserve(NumEntries);
+	for (int32 i = 0; i < NumEntries && !MemoryReader.IsError(); ++i)
+	{
+		FSaveGameChunkId ChunkId;
+		int32 ReferenceCount = 0;
+		ChunkId.Serialize(MemoryReader);
+		MemoryReader << ReferenceCount;
+		ReferenceCounts.Add(ChunkId, ReferenceCount);
+	}
+
+	if (MemoryReader.IsError())
+	{
+		UE_LOG(LogSaveGameChunkStore, Warning, TEXT("Chunk index is corrupted and needs to be rebuilt: %s"), *GetIndexFilePath());
+		ReferenceCounts.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FSaveGameChunkStore::TrySaveIndex() const
+{
+	TArray<uint8> FileData;
+	FMemoryWriter MemoryWriter(FileData, true);
+
+	int32 FileTypeTag = MODULAR_SAVEGAME_CHUNK_INDEX_FILE_TYPE_TAG;
+	int32 FileVersion = MODULAR_SAVEGAME_CHUNK_INDEX_FILE_VERSION;
+	MemoryWriter << FileTypeTag;
+	MemoryWriter << FileVersion;
+
+	int32 NumEntries = ReferenceCounts.Num();
+	MemoryWriter << NumEntries;
+	for (const TTuple<FSaveGameChunkId, int32>& ChunkAndCount : ReferenceCounts)
+	{
+		FSaveGameChunkId ChunkId = ChunkAndCount.Key;
+		int32 ReferenceCount = ChunkAndCount.Value;
+		ChunkId.Serialize(MemoryWriter);
+		MemoryWriter << ReferenceCount;
+	}
+
+	// (i) Same as the slot manifest: Replace the index only when the new one was written completely.
+	const FString IndexFilePath = GetIndexFilePath();
+	const FString TempFilePath = IndexFilePath + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(FileData, *TempFilePath) || !IFileManager::Get().Move(*IndexFilePath, *TempFilePath, true))
+	{
+		UE_LOG(LogSaveGameChunkStore, Warning, TEXT("Failed to write chunk index: %s"), *IndexFilePath);
+		IFileManager::Get().Delete(*TempFilePath, false, false, true);
+		return false;
+	}
+
+	return true;
+}
+
+void FSaveGameChunkStore::RebuildReferences(const TMap<FString, FSaveGameChunkList>& ChunkListsByFile)
+{
+	check(IsInGameThread());
+	ReferenceCounts.Reset();
+	for (const TTuple<FString, FSaveGameChunkList>& FileAndChunkList : ChunkListsByFile)
+	{
+		AddReferences(FileAndChunkList.Value);
+	}
+	TrySaveIndex();
+}
+
+void FSaveGameChunkStore::AddReferences(const FSaveGameChunkList& ChunkList)
+{
+	check(IsInGameThread());
+	for (const FSaveGameChunkId& ChunkId : ChunkList.Chunks)
+	{
+		ReferenceCounts.FindOrAdd(ChunkId) += 1;
+	}
+}
+
+void FSaveGameChunkStore::ReleaseReferences(const FSaveGameChunkList& ChunkList)
+{
+	check(IsInGameThread());
+	for (const FSaveGameChunkId& ChunkId : ChunkList.Chunks)
+	{
+		if (int32* ReferenceCount = ReferenceCounts.Find(ChunkId))
+		{
+			// (i) Unreferenced chunks are kept in the index until garbage collection deletes them.
+			*ReferenceCount = FMath::Max(*ReferenceCount - 1, 0);
+		}
+	}
+}
+
+int32 FSaveGameChunkStore::CollectGarbage()
+{
+	check(IsInGameThread());
+	int32 NumDeletedChunks = 0;
+	for (auto It = ReferenceCounts.CreateIterator(); It; ++It)
+	{
+		if (It->Value > 0)
+			continue;
+
+		IFileManager::Get().Delete(*GetChunkFilePath(It->Key), false, false, true);
+		It.RemoveCurrent();
+		++NumDeletedChunks;
+	}
+	return NumDeletedChunks;
+}
+
+FSaveGameChunkStoreIntegrityReport FSaveGameChunkStore::VerifyIntegrity(const TMap<FString, FSaveGameChunkList>& ChunkListsByFile, bool bRepair)
+{
+	check(IsInGameThread());
+	FSaveGameChunkStoreIntegrityReport Report;
+
+	TMap<FSaveGameChunkId, int32> ActualReferenceCounts;
+	for (const TTuple<FString, FSaveGameChunkList>& FileAndChunkList : ChunkListsByFile)
+	{
+		for (const FSaveGameChunkId& ChunkId : FileAndChunkList.Value.Chunks)
+		{
+			ActualReferenceCounts.FindOrAdd(ChunkId) += 1;
+		}
+	}
+
+	// Check that every referenced chunk exists and is intact:
+	TSet<FSaveGameChunkId> BrokenChunks;
+	TSet<FString> ReferencedChunkFiles;
+	TArray<uint8> ChunkData;
+	for (const TTuple<FSaveGameChunkId, int32>& ChunkAndCount : ActualReferenceCounts)
+	{
+		const FSaveGameChunkId& ChunkId = ChunkAndCount.Key;
+		const FString ChunkFilePath = GetChunkFilePath(ChunkId);
+		ReferencedChunkFiles.Add(FPaths::ConvertRelativePathToFull(ChunkFilePath));
+		Report.NumReferencedChunks += 1;
+		Report.ReferencedBytes += ChunkId.Size;
+
+		if (IFileManager::Get().FileSize(*ChunkFilePath) < 0)
+		{
+			Report.NumMissingChunks += 1;
+			BrokenChunks.Add(ChunkId);
+		}
+		else if (!TryReadChunk(ChunkId, OUT ChunkData))
+		{
+			Report.NumCorruptChunks += 1;
+			BrokenChunks.Add(ChunkId);
+		}
+
+		if (ReferenceCounts.FindRef(ChunkId) != ChunkAndCount.Value)
+		{
+			Report.NumWrongReferenceCounts += 1;
+		}
+	}
+
+	for (const TTuple<FSaveGameChunkId, int32>& ChunkAndCount : ReferenceCounts)
+	{
+		if (ChunkAndCount.Value > 0 && !ActualReferenceCounts.Contains(ChunkAndCount.Key))
+		{
+			Report.NumWrongReferenceCounts += 1;
+		}
+	}
+
+	for (const TTuple<FString, FSaveGameChunkList>& FileAndChunkList : ChunkListsByFile)
+	{
+		if (FileAndChunkList.Value.Chunks.ContainsByPredicate([&BrokenChunks](const FSaveGameChunkId& ChunkId) { return BrokenChunks.Contains(ChunkId); }))
+		{
+			Report.BrokenChunkLists.Add(FileAndChunkList.Key);
+		}
+	}
+
+	// Find stored files that no chunk list references (e.g. left behind by interrupted writes):
+	TArray<FString> UnreferencedChunkFiles;
+	IFileManager::Get().IterateDirectoryStatRecursively(*Directory, [&](const TCHAR* FilePath, const FFileStatData& StatData)
+	{
+		const FString Extension = FPaths::GetExtension(FilePath);
+		if (StatData.bIsDirectory || (Extension != TEXT("chunk") && Extension != TEXT("tmp")) || FPaths::IsSamePath(FilePath, GetIndexFilePath() + TEXT(".tmp")))
+			return true;
+
+		Report.StoredBytes += StatData.FileSize;
+		if (!ReferencedChunkFiles.Contains(FPaths::ConvertRelativePathToFull(FilePath)))
+		{
+			Report.NumUnreferencedChunks += 1;
+			UnreferencedChunkFiles.Add(FilePath);
+		}
+		return true;
+	});
+
+	if (bRepair)
+	{
+		for (const FString& ChunkFilePath : UnreferencedChunkFiles)
+		{
+			IFileManager::Get().Delete(*ChunkFilePath, false, false, true);
+		}
+		RebuildReferences(ChunkListsByFile);
+	}
+
+	return Report;
+}
+
+FString FSaveGameChunkStore::GetChunkFilePath(const FSaveGameChunkId& ChunkId) const
+{
+	// (i) Chunks are spread over 256 sub-directories, so no directory ends up with thousands of files.
+	const FString ChunkName = ChunkId.ToString();
+	return FString(Directory / ChunkName.Left(2) / ChunkName + TEXT(".chunk"));
+}
+
+FString FSaveGameChunkStore::GetIndexFilePath() const
+{
+	return FString(Directory / TEXT("Chunks.index"));
+}
+
+int32 FSaveGameChunkStore::FindChunkBoundary(const uint8* Data, int32 NumBytes)
+{
+	if (NumBytes <= MinChunkSize)
+		return NumBytes;
+
+	// (i) Rolling gear hash: Every byte shifts the previous ones further out, so the topmost bits depend on the last 64 bytes only.
+	// A boundary is placed where these bits are all zero, which only depends on the local content and not on its offset in the data.
+	constexpr uint64 BoundaryMask = ~0ull << (64 - ChunkBoundaryBits);
+	const FGearTable& GearTable = GetGearTable();
+	const int32 MaxBytes = FMath::Min(NumBytes, MaxChunkSize);
+
+	uint64 Hash = 0;
+	for (int32 i = MinChunkSize; i < MaxBytes; ++i)
+	{
+		Hash = (Hash << 1) + GearTable.Values[Data[i]];
+		if ((Hash & BoundaryMask) == 0)
+			return (i + 1);
+	}
+	return MaxBytes;
+}
+
+bool FSaveGameChunkStore::TryReadChunk(const FSaveGameChunkId& ChunkId, TArray<uint8>& OutChunkData) const
+{
+	if (!FFileHelper::LoadFileToArray(OUT OutChunkData, *GetChunkFilePath(ChunkId), FILEREAD_Silent))
+		return false;
+
+	return (OutChunkData.Num() == ChunkId.Size && FSaveGameChunkId::FromData(OutChunkData.GetData(), OutChunkData.Num()) == ChunkId);
+}
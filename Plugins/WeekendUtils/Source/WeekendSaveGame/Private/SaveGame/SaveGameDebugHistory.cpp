@@ -0,0 +1,92 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#include "SaveGame/SaveGameDebugHistory.h"
+
+#include "Misc/StringBuilder.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveLoadDebugEntry
+
+FSaveLoadDebugEntry& FSaveLoadDebugEntry::SetResult(bool bSuccess, double InDuration)
+{
+	Result = (bSuccess ? EResult::Succeeded : EResult::Failed);
+	Duration = static_cast<float>(InDuration);
+	return *this;
+}
+
+FString FSaveLoadDebugEntry::ToString() const
+{
+	TStringBuilder<256> Builder;
+	Builder.Appendf(TEXT("(%s UTC)\t [%s]"), *UtcTime.ToString(), *Operation.ToString());
+	if (Result != EResult::None)
+	{
+		Builder.Appendf(TEXT(" %s (took %.3fsec)"), (Result == EResult::Succeeded ? TEXT("succeeded") : TEXT("failed")), Duration);
+	}
+	if (!SlotName.IsNone())
+	{
+		Builder.Appendf(TEXT(" Slot: %s"), *SlotName.ToString());
+	}
+	if (!KeyHolder.IsNone())
+	{
+		Builder.Appendf(TEXT(" KeyHolder: %s"), *KeyHolder.ToString());
+	}
+	if (Handle.IsValid())
+	{
+		Builder.Appendf(TEXT(" Key: %s"), *Handle.ToString());
+	}
+	if (!Context.IsEmpty())
+	{
+		Builder.Appendf(TEXT(" Context: %s"), *Context);
+	}
+	return Builder.ToString();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveLoadDebugHistory
+
+void FSaveLoadDebugHistory::SetCapacity(int32 InCapacity)
+{
+	Capacity = FMath::Max(InCapacity, 0);
+	while (Entries.Num() > Capacity)
+	{
+		Entries.PopFront();
+	}
+	Entries.Reserve(Capacity);
+}
+
+void FSaveLoadDebugHistory::Add(FSaveLoadDebugEntry&& Entry)
+{
+	if (Capacity <= 0)
+		return;
+
+	// (i) Reserved capacity is never exceeded, so the ring buffer won't reallocate.
+	if (Entries.Num() >= Capacity)
+	{
+		Entries.PopFront();
+	}
+	Entries.Emplace(MoveTemp(Entry));
+}
+
+void FSaveLoadDebugHistory::Clear()
+{
+	Entries.Reset();
+}
+
+TArray<FString> FSaveLoadDebugHistory::FormatMostRecent(int32 MaxEntries) const
+{
+	const int32 NumEntries = FMath::Clamp(MaxEntries, 0, Entries.Num());
+	TArray<FString> Result;
+	Result.Reserve(NumEntries);
+	for (int32 Index = Entries.Num() - NumEntries; Index < Entries.Num(); ++Index)
+	{
+		Result.Add(Entries[Index].ToString());
+	}
+	return Result;
+}
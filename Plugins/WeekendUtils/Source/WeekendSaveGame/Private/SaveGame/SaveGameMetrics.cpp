@@ -0,0 +1,314 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#include "SaveGame/SaveGameMetrics.h"
+
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "WeekendSaveGame.h"
+
+CSV_DEFINE_CATEGORY(SaveGame, true);
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Save: Deferral (ms)"), STAT_SaveGame_Save_Deferral, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Save: Queue Wait (ms)"), STAT_SaveGame_Save_QueueWait, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Save: Capture (ms)"), STAT_SaveGame_Save_Capture, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Save: Contribute (ms)"), STAT_SaveGame_Save_Contribute, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Save: Serialize (ms)"), STAT_SaveGame_Save_Serialize, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Save: Compress (ms)"), STAT_SaveGame_Save_Compress, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Save: IO (ms)"), STAT_SaveGame_Save_IO, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Save: Throttle (ms)"), STAT_SaveGame_Save_Throttle, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Save: Total (ms)"), STAT_SaveGame_Save_Total, STATGROUP_SaveGame);
+DECLARE_MEMORY_STAT(TEXT("Last Save: Size"), STAT_SaveGame_Save_Bytes, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Load: Queue Wait (ms)"), STAT_SaveGame_Load_QueueWait, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Load: IO (ms)"), STAT_SaveGame_Load_IO, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Load: Asset Preload (ms)"), STAT_SaveGame_Load_AssetPreload, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Load: Decompress (ms)"), STAT_SaveGame_Load_Decompress, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Load: Deserialize (ms)"), STAT_SaveGame_Load_Deserialize, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Load: Total (ms)"), STAT_SaveGame_Load_Total, STATGROUP_SaveGame);
+DECLARE_MEMORY_STAT(TEXT("Last Load: Size"), STAT_SaveGame_Load_Bytes, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Snapshot Restore: Queue Wait (ms)"), STAT_SaveGame_RestoreSnapshot_QueueWait, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Snapshot Restore: Decompress (ms)"), STAT_SaveGame_RestoreSnapshot_Decompress, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Snapshot Restore: Deserialize (ms)"), STAT_SaveGame_RestoreSnapshot_Deserialize, STATGROUP_SaveGame);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Snapshot Restore: Total (ms)"), STAT_SaveGame_RestoreSnapshot_Total, STATGROUP_SaveGame);
+DECLARE_MEMORY_STAT(TEXT("Last Snapshot Restore: Size"), STAT_SaveGame_RestoreSnapshot_Bytes, STATGROUP_SaveGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Num Saves"), STAT_SaveGame_NumSaves, STATGROUP_SaveGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Num Loads"), STAT_SaveGame_NumLoads, STATGROUP_SaveGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Num Snapshot Restores"), STAT_SaveGame_NumSnapshotRestores, STATGROUP_SaveGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Num Failures"), STAT_SaveGame_NumFailures, STATGROUP_SaveGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Num Skipped Writes"), STAT_SaveGame_NumSkippedWrites, STATGROUP_SaveGame);
+DECLARE_MEMORY_STAT(TEXT("Skipped Write Size"), STAT_SaveGame_SkippedWriteBytes, STATGROUP_SaveGame);
+
+const TCHAR* LexToString(ESaveLoadOperation Operation)
+{
+	switch (Operation)
+	{
+	case ESaveLoadOperation::Save: return TEXT("Save");
+	case ESaveLoadOperation::Load: return TEXT("Load");
+	case ESaveLoadOperation::RestoreSnapshot: return TEXT("RestoreSnapshot");
+	default: return TEXT("???");
+	}
+}
+
+const TCHAR* LexToString(ESaveLoadPhase Phase)
+{
+	switch (Phase)
+	{
+	case ESaveLoadPhase::Deferral: return TEXT("Deferral");
+	case ESaveLoadPhase::QueueWait: return TEXT("QueueWait");
+	case ESaveLoadPhase::Capture: return TEXT("Capture");
+	case ESaveLoadPhase::Contribute: return TEXT("Contribute");
+	case ESaveLoadPhase::Serialize: return TEXT("Serialize");
+	case ESaveLoadPhase::Compress: return TEXT("Compress");
+	case ESaveLoadPhase::IO: return TEXT("IO");
+	case ESaveLoadPhase::Throttle: return TEXT("Throttle");
+	case ESaveLoadPhase::AssetPreload: return TEXT("AssetPreload");
+	case ESaveLoadPhase::Deserialize: return TEXT("Deserialize");
+	case ESaveLoadPhase::Total: return TEXT("Total");
+	default: return TEXT("???");
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveGameSizeReport
+
+void FSaveGameSizeReport::Reset()
+{
+	TotalBytes = 0;
+	HeaderBytes = 0;
+	BytesByModule.Reset();
+	BytesByLevelObjectClass.Reset();
+}
+
+FString FSaveGameSizeReport::ToString() const
+{
+	auto AppendSortedBySize = [this](FString& OutResult, const TCHAR* Title, TMap<FName, int64> BytesByName)
+	{
+		if (BytesByName.IsEmpty())
+			return;
+
+		BytesByName.ValueSort([](int64 A, int64 B) { return A > B; });
+		OutResult += FString::Printf(TEXT("%s:\n"), Title);
+		for (const TTuple<FName, int64>& NameAndBytes : BytesByName)
+		{
+			const double Percent = (TotalBytes > 0 ? 100.0 * NameAndBytes.Value / TotalBytes : 0.0);
+			OutResult += FString::Printf(TEXT("\t%-40s %10lld bytes (%5.1f%%)\n"), *NameAndBytes.Key.ToString(), NameAndBytes.Value, Percent);
+		}
+	};
+
+	FString Result = FString::Printf(TEXT("SaveGame size: %lld bytes (header: %lld bytes)\n"), TotalBytes, HeaderBytes);
+	AppendSortedBySize(Result, TEXT("Modules"), BytesByModule);
+	AppendSortedBySize(Result, TEXT("Level objects by class"), BytesByLevelObjectClass);
+	return Result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveLoadMetrics
+
+FString FSaveLoadMetrics::ToString() const
+{
+	FString Result = FString::Printf(TEXT("%s '%s' %s (%lld bytes):"), LexToString(Operation), *SlotName, (bSuccess ? TEXT("succeeded") : TEXT("failed")), NumBytes);
+	for (uint8 i = 0; i < static_cast<uint8>(ESaveLoadPhase::MAX); ++i)
+	{
+		if (!WasPhaseMeasured(static_cast<ESaveLoadPhase>(i)))
+			continue;
+
+		Result += FString::Printf(TEXT(" %s=%.2fms"), LexToString(static_cast<ESaveLoadPhase>(i)), PhaseTimes[i] * 1000.0);
+	}
+	if (!SecondsByModule.IsEmpty())
+	{
+		Result += TEXT(" | Modules:");
+		for (const TTuple<FName, double>& ModuleAndSeconds : SecondsByModule)
+		{
+			Result += FString::Printf(TEXT(" %s=%.2fms"), *ModuleAndSeconds.Key.ToString(), ModuleAndSeconds.Value * 1000.0);
+		}
+	}
+	if (!SecondsByContributor.IsEmpty())
+	{
+		Result += TEXT(" | Contributors:");
+		for (const TTuple<FName, double>& ContributorAndSeconds : SecondsByContributor)
+		{
+			Result += FString::Printf(TEXT(" %s=%.2fms"), *ContributorAndSeconds.Key.ToString(), ContributorAndSeconds.Value * 1000.0);
+		}
+	}
+	return Result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveLoadLatencyHistogram
+
+namespace
+{
+	constexpr double HistogramBaseSeconds = 0.00001; // 10us
+	constexpr double HistogramBucketFactor = 1.5;
+}
+
+void FSaveLoadLatencyHistogram::Add(double Seconds)
+{
+	Seconds = FMath::Max(Seconds, 0.0);
+	Buckets[GetBucketIndex(Seconds)]++;
+	NumSamples++;
+	SumSeconds += Seconds;
+	MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+}
+
+void FSaveLoadLatencyHistogram::Reset()
+{
+	*this = FSaveLoadLatencyHistogram();
+}
+
+double FSaveLoadLatencyHistogram::GetPercentile(double Fraction) const
+{
+	if (NumSamples <= 0)
+		return 0.0;
+
+	const int32 TargetCount = FMath::Max(FMath::CeilToInt32(FMath::Clamp(Fraction, 0.0, 1.0) * NumSamples), 1);
+	int32 Count = 0;
+	for (int32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+	{
+		Count += Buckets[BucketIndex];
+		if (Count >= TargetCount)
+			return FMath::Min(GetBucketUpperBound(BucketIndex), MaxSeconds);
+	}
+	return MaxSeconds;
+}
+
+double FSaveLoadLatencyHistogram::GetBucketUpperBound(int32 BucketIndex)
+{
+	return HistogramBaseSeconds * FMath::Pow(HistogramBucketFactor, static_cast<double>(BucketIndex));
+}
+
+int32 FSaveLoadLatencyHistogram::GetBucketIndex(double Seconds)
+{
+	if (Seconds <= HistogramBaseSeconds)
+		return 0;
+
+	const int32 BucketIndex = FMath::CeilToInt32(FMath::LogX(HistogramBucketFactor, Seconds / HistogramBaseSeconds));
+	return FMath::Clamp(BucketIndex, 0, NumBuckets - 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveLoadMetricsRecorder
+
+void FSaveLoadMetricsRecorder::Record(const FSaveLoadMetrics& Metrics)
+{
+	FSaveLoadOperationStats& Stats = StatsByOperation[static_cast<uint8>(Metrics.Operation)];
+	Stats.NumOperations++;
+	Stats.NumFailures += (Metrics.bSuccess ? 0 : 1);
+	Stats.TotalBytes += Metrics.NumBytes;
+	Stats.NumSkippedWrites += (Metrics.bSkippedWrite ? 1 : 0);
+	Stats.NumSkippedWriteBytes += (Metrics.bSkippedWrite ? Metrics.NumBytes : 0);
+	Stats.LastMetrics = Metrics;
+
+	// (i) Failed operations end early, at whichever phase failed, so their timings would only skew the latencies:
+	if (!Metrics.bSuccess)
+	{
+		INC_DWORD_STAT(STAT_SaveGame_NumFailures);
+		return;
+	}
+
+	for (uint8 i = 0; i < static_cast<uint8>(ESaveLoadPhase::MAX); ++i)
+	{
+		const ESaveLoadPhase Phase = static_cast<ESaveLoadPhase>(i);
+		if (Metrics.WasPhaseMeasured(Phase))
+		{
+			Stats.GetHistogram(Phase).Add(Metrics.GetPhaseTime(Phase));
+		}
+	}
+
+#if STATS
+	auto ToMs = [&Metrics](ESaveLoadPhase Phase) { return static_cast<float>(Metrics.GetPhaseTime(Phase) * 1000.0); };
+	switch (Metrics.Operation)
+	{
+	case ESaveLoadOperation::Save:
+		SET_FLOAT_STAT(STAT_SaveGame_Save_Deferral, ToMs(ESaveLoadPhase::Deferral));
+		SET_FLOAT_STAT(STAT_SaveGame_Save_QueueWait, ToMs(ESaveLoadPhase::QueueWait));
+		SET_FLOAT_STAT(STAT_SaveGame_Save_Capture, ToMs(ESaveLoadPhase::Capture));
+		SET_FLOAT_STAT(STAT_SaveGame_Save_Contribute, ToMs(ESaveLoadPhase::Contribute));
+		SET_FLOAT_STAT(STAT_SaveGame_Save_Serialize, ToMs(ESaveLoadPhase::Serialize));
+		SET_FLOAT_STAT(STAT_SaveGame_Save_Compress, ToMs(ESaveLoadPhase::Compress));
+		SET_FLOAT_STAT(STAT_SaveGame_Save_IO, ToMs(ESaveLoadPhase::IO));
+		SET_FLOAT_STAT(STAT_SaveGame_Save_Throttle, ToMs(ESaveLoadPhase::Throttle));
+		SET_FLOAT_STAT(STAT_SaveGame_Save_Total, ToMs(ESaveLoadPhase::Total));
+		SET_MEMORY_STAT(STAT_SaveGame_Save_Bytes, Metrics.NumBytes);
+		INC_DWORD_STAT(STAT_SaveGame_NumSaves);
+		if (Metrics.bSkippedWrite)
+		{
+			INC_DWORD_STAT(STAT_SaveGame_NumSkippedWrites);
+			INC_MEMORY_STAT_BY(STAT_SaveGame_SkippedWriteBytes, Metrics.NumBytes);
+		}
+		break;
+	case ESaveLoadOperation::Load:
+		SET_FLOAT_STAT(STAT_SaveGame_Load_QueueWait, ToMs(ESaveLoadPhase::QueueWait));
+		SET_FLOAT_STAT(STAT_SaveGame_Load_IO, ToMs(ESaveLoadPhase::IO));
+		SET_FLOAT_STAT(STAT_SaveGame_Load_AssetPreload, ToMs(ESaveLoadPhase::AssetPreload));
+		SET_FLOAT_STAT(STAT_SaveGame_Load_Decompress, ToMs(ESaveLoadPhase::Compress));
+		SET_FLOAT_STAT(STAT_SaveGame_Load_Deserialize, ToMs(ESaveLoadPhase::Deserialize));
+		SET_FLOAT_STAT(STAT_SaveGame_Load_Total, ToMs(ESaveLoadPhase::Total));
+		SET_MEMORY_STAT(STAT_SaveGame_Load_Bytes, Metrics.NumBytes);
+		INC_DWORD_STAT(STAT_SaveGame_NumLoads);
+		break;
+	case ESaveLoadOperation::RestoreSnapshot:
+		SET_FLOAT_STAT(STAT_SaveGame_RestoreSnapshot_QueueWait, ToMs(ESaveLoadPhase::QueueWait));
+		SET_FLOAT_STAT(STAT_SaveGame_RestoreSnapshot_Decompress, ToMs(ESaveLoadPhase::Compress));
+		SET_FLOAT_STAT(STAT_SaveGame_RestoreSnapshot_Deserialize, ToMs(ESaveLoadPhase::Deserialize));
+		SET_FLOAT_STAT(STAT_SaveGame_RestoreSnapshot_Total, ToMs(ESaveLoadPhase::Total));
+		SET_MEMORY_STAT(STAT_SaveGame_RestoreSnapshot_Bytes, Metrics.NumBytes);
+		INC_DWORD_STAT(STAT_SaveGame_NumSnapshotRestores);
+		break;
+	default:
+		break;
+	}
+#endif
+
+#if CSV_PROFILER
+	// (i) Save/load operations are rare, so building the stat names on demand is fine.
+	for (uint8 i = 0; i < static_cast<uint8>(ESaveLoadPhase::MAX); ++i)
+	{
+		const ESaveLoadPhase Phase = static_cast<ESaveLoadPhase>(i);
+		if (!Metrics.WasPhaseMeasured(Phase))
+			continue;
+
+		const FName StatName(FString::Printf(TEXT("%s_%sMs"), LexToString(Metrics.Operation), LexToString(Phase)));
+		FCsvProfiler::RecordCustomStat(StatName, CSV_CATEGORY_INDEX(SaveGame), static_cast<float>(Metrics.GetPhaseTime(Phase) * 1000.0), ECsvCustomStatOp::Set);
+	}
+	const FName BytesStatName(FString::Printf(TEXT("%s_Bytes"), LexToString(Metrics.Operation)));
+	FCsvProfiler::RecordCustomStat(BytesStatName, CSV_CATEGORY_INDEX(SaveGame), static_cast<float>(Metrics.NumBytes), ECsvCustomStatOp::Set);
+#endif
+}
+
+void FSaveLoadMetricsRecorder::Reset()
+{
+	for (FSaveLoadOperationStats& Stats : StatsByOperation)
+	{
+		Stats = FSaveLoadOperationStats();
+	}
+}
+
+FString FSaveLoadMetricsRecorder::ToString() const
+{
+	FString Result;
+	for (uint8 OperationIndex = 0; OperationIndex < static_cast<uint8>(ESaveLoadOperation::MAX); ++OperationIndex)
+	{
+		const FSaveLoadOperationStats& Stats = StatsByOperation[OperationIndex];
+		if (Stats.NumOperations == 0)
+			continue;
+
+		Result += FString::Printf(TEXT("%s: %d operations (%d failed, %d skipped writes), %lld bytes total (%lld bytes not written)\n"),
+			LexToString(static_cast<ESaveLoadOperation>(OperationIndex)), Stats.NumOperations, Stats.NumFailures, Stats.NumSkippedWrites, Stats.TotalBytes, Stats.NumSkippedWriteBytes);
+		for (uint8 PhaseIndex = 0; PhaseIndex < static_cast<uint8>(ESaveLoadPhase::MAX); ++PhaseIndex)
+		{
+			const FSaveLoadLatencyHistogram& Histogram = Stats.GetHistogram(static_cast<ESaveLoadPhase>(PhaseIndex));
+			if (Histogram.Num() == 0)
+				continue;
+
+			Result += FString::Printf(TEXT("\t%-12s p50=%.2fms p90=%.2fms p99=%.2fms max=%.2fms\n"), LexToString(static_cast<ESaveLoadPhase>(PhaseIndex)),
+				Histogram.GetPercentile(0.5) * 1000.0, Histogram.GetPercentile(0.9) * 1000.0, Histogram.GetPercentile(0.99) * 1000.0, Histogram.GetMax() * 1000.0);
+		}
+	}
+	return Result;
+}
@@ -0,0 +1,183 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#include "SaveGame/SaveGameRestorePipeline.h"
+
+#include "SaveGame/SaveGameService.h"
+
+const TCHAR* LexToString(ESaveGameRestoreTier Tier)
+{
+	switch (Tier)
+	{
+		case ESaveGameRestoreTier::Critical: return TEXT("Critical");
+		case ESaveGameRestoreTier::Gameplay: return TEXT("Gameplay");
+		case ESaveGameRestoreTier::Deferred: return TEXT("Deferred");
+		default: return TEXT("Unknown");
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveGameRestorePipeline
+
+FDelegateHandle FSaveGameRestorePipeline::Add(ESaveGameRestoreTier Tier, const FRestoreStep& Step, int32 Priority)
+{
+	FListener Listener;
+	Listener.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+	Listener.Step = Step;
+	Listener.Tier = Tier;
+	Listener.Priority = Priority;
+
+	// (i) Keep listeners sorted, so restoring them is just walking the array. Equal listeners keep the order they were added in.
+	const int32 InsertIndex = Listeners.IndexOfByPredicate([&Listener](const FListener& Other)
+	{
+		return ((Other.Tier > Listener.Tier) || (Other.Tier == Listener.Tier && Other.Priority < Listener.Priority));
+	});
+	Listeners.Insert(Listener, (InsertIndex != INDEX_NONE) ? InsertIndex : Listeners.Num());
+	return Listener.Handle;
+}
+
+void FSaveGameRestorePipeline::Remove(const FDelegateHandle& Handle)
+{
+	Listeners.RemoveAll([&Handle](const FListener& Listener) { return (Listener.Handle == Handle); });
+
+	// Listeners removed during a restore must not be called anymore:
+	for (int32 Index = PendingListeners.Num() - 1; Index >= NextListenerIndex; --Index)
+	{
+		if (PendingListeners[Index].Handle == Handle)
+		{
+			PendingListeners.RemoveAt(Index);
+		}
+	}
+}
+
+void FSaveGameRestorePipeline::RemoveAll(const void* UserObject)
+{
+	Listeners.RemoveAll([UserObject](const FListener& Listener) { return Listener.Step.IsBoundToObject(UserObject); });
+	for (int32 Index = PendingListeners.Num() - 1; Index >= NextListenerIndex; --Index)
+	{
+		if (PendingListeners[Index].Step.IsBoundToObject(UserObject))
+		{
+			PendingListeners.RemoveAt(Index);
+		}
+	}
+}
+
+void FSaveGameRestorePipeline::Begin(const FCurrentSaveGame& InSaveGame)
+{
+	if (bIsRunning)
+	{
+		UE_LOG(LogSaveGameService, Log, TEXT("Restore of previous SaveGame was still running (%s tier), cancelling it."), LexToString(CurrentTier));
+		Cancel();
+	}
+
+	SaveGame = InSaveGame;
+	RestoreSerial++;
+	PendingListeners = Listeners;
+	NextListenerIndex = 0;
+	CurrentTier = ESaveGameRestoreTier::Critical;
+	bIsRunning = true;
+	BeginTime = FPlatformTime::Seconds();
+	for (double& Seconds : SecondsUntilTierRestored)
+	{
+		Seconds = -1.0;
+	}
+
+	// Critical listeners are restored right away, regardless of any budget:
+	const uint32 Serial = RestoreSerial;
+	while (RestoreSerial == Serial && PendingListeners.IsValidIndex(NextListenerIndex) && PendingListeners[NextListenerIndex].Tier == ESaveGameRestoreTier::Critical)
+	{
+		RestoreNextListener();
+	}
+
+	if (RestoreSerial == Serial)
+	{
+		FinishTiersUpTo(ESaveGameRestoreTier::Critical);
+	}
+}
+
+void FSaveGameRestorePipeline::Process(double TimeBudget)
+{
+	const double EndTime = (FPlatformTime::Seconds() + TimeBudget);
+	while (bIsRunning && RestoreNextListener())
+	{
+		if (FPlatformTime::Seconds() >= EndTime)
+			return;
+	}
+}
+
+void FSaveGameRestorePipeline::Flush()
+{
+	while (bIsRunning && RestoreNextListener())
+	{
+	}
+}
+
+void FSaveGameRestorePipeline::Cancel()
+{
+	RestoreSerial++;
+	bIsRunning = false;
+	PendingListeners.Reset();
+	NextListenerIndex = 0;
+	SaveGame = FCurrentSaveGame();
+}
+
+bool FSaveGameRestorePipeline::RestoreNextListener()
+{
+	if (!PendingListeners.IsValidIndex(NextListenerIndex))
+	{
+		FinishTiersUpTo(static_cast<ESaveGameRestoreTier>(static_cast<uint8>(ESaveGameRestoreTier::MAX) - 1));
+		return false;
+	}
+
+	// (i) Copy the listener, since it may remove itself or others from the pipeline while being restored.
+	const FListener Listener = PendingListeners[NextListenerIndex++];
+	const uint32 Serial = RestoreSerial;
+	if (Listener.Tier > CurrentTier)
+	{
+		FinishTiersUpTo(static_cast<ESaveGameRestoreTier>(static_cast<uint8>(Listener.Tier) - 1));
+		if (RestoreSerial != Serial)
+			return bIsRunning;
+	}
+
+	const FCurrentSaveGame SaveGameToRestore = SaveGame;
+	Listener.Step.ExecuteIfBound(SaveGameToRestore);
+	return bIsRunning;
+}
+
+void FSaveGameRestorePipeline::FinishTiersUpTo(ESaveGameRestoreTier Tier)
+{
+	const FCurrentSaveGame RestoredSaveGame = SaveGame;
+	const uint32 Serial = RestoreSerial;
+	for (uint8 TierIndex = static_cast<uint8>(CurrentTier); TierIndex <= static_cast<uint8>(Tier); ++TierIndex)
+	{
+		if (SecondsUntilTierRestored[TierIndex] >= 0.0)
+			continue;
+
+		const ESaveGameRestoreTier FinishedTier = static_cast<ESaveGameRestoreTier>(TierIndex);
+		SecondsUntilTierRestored[TierIndex] = (FPlatformTime::Seconds() - BeginTime);
+		UE_LOG(LogSaveGameService, Verbose, TEXT("Restored %s tier of SaveGame after %.2f ms."), LexToString(FinishedTier), SecondsUntilTierRestored[TierIndex] * 1000.0);
+		OnTierRestored.Broadcast(FinishedTier, RestoredSaveGame);
+
+		// (i) Listeners of the finished tier may have started another restore or cancelled this one:
+		if (RestoreSerial != Serial)
+			return;
+	}
+
+	const uint8 NextTierIndex = (static_cast<uint8>(Tier) + 1);
+	if (NextTierIndex < static_cast<uint8>(ESaveGameRestoreTier::MAX))
+	{
+		CurrentTier = static_cast<ESaveGameRestoreTier>(NextTierIndex);
+	}
+	else
+	{
+		bIsRunning = false;
+		PendingListeners.Reset();
+		NextListenerIndex = 0;
+	}
+}
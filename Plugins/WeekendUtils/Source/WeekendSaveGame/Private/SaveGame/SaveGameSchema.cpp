@@ -0,0 +1,209 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#include "SaveGame/SaveGameSchema.h"
+
+#include "Hash/xxhash.h"
+#include "Misc/ScopeRWLock.h"
+#include "Serialization/StructuredArchiveAdapters.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UnrealType.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveGameSchemaField
+
+FArchive& operator<<(FArchive& Ar, FSaveGameSchemaField& Field)
+{
+	Ar << Field.Name;
+	Ar << Field.Type;
+	Ar << Field.Size;
+	Ar << Field.bIsPlainData;
+	return Ar;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveGameSchema
+
+namespace
+{
+	FRWLock SchemaCacheLock;
+	TMap<FObjectKey, TUniquePtr<FSaveGameSchema>> SchemaCache;
+
+	bool IsPlainData(const FProperty& Property)
+	{
+		if (Property.IsA<FNumericProperty>() || Property.IsA<FEnumProperty>())
+			return true;
+
+		if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(&Property))
+			return BoolProperty->IsNativeBool();
+
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(&Property))
+			return (StructProperty->Struct->StructFlags & STRUCT_IsPlainOldData) != 0;
+
+		return false;
+	}
+
+	bool ShouldFlattenStruct(const FProperty& Property)
+	{
+		const FStructProperty* StructProperty = CastField<FStructProperty>(&Property);
+		return (StructProperty && Property.ArrayDim == 1 && !IsPlainData(Property)
+			&& !(StructProperty->Struct->StructFlags & (STRUCT_SerializeNative | STRUCT_SerializeFromMismatchedTag)));
+	}
+}
+
+const FSaveGameSchema& FSaveGameSchema::FindOrCompile(const UStruct& Struct)
+{
+	const FObjectKey StructKey(&Struct);
+	{
+		FReadScopeLock ReadLock(SchemaCacheLock);
+		if (const TUniquePtr<FSaveGameSchema>* Schema = SchemaCache.Find(StructKey))
+			return **Schema;
+	}
+
+	TUniquePtr<FSaveGameSchema> NewSchema = MakeUnique<FSaveGameSchema>();
+	NewSchema->Compile(Struct);
+
+	FWriteScopeLock WriteLock(SchemaCacheLock);
+	if (const TUniquePtr<FSaveGameSchema>* Schema = SchemaCache.Find(StructKey))
+		return **Schema;
+
+	return *SchemaCache.Add(StructKey, MoveTemp(NewSchema));
+}
+
+void FSaveGameSchema::Precompile(const TArray<const UStruct*>& Structs)
+{
+	for (const UStruct* Struct : Structs)
+	{
+		if (Struct)
+		{
+			FindOrCompile(*Struct);
+		}
+	}
+}
+
+void FSaveGameSchema::ResetCache()
+{
+	FWriteScopeLock WriteLock(SchemaCacheLock);
+	SchemaCache.Reset();
+}
+
+void FSaveGameSchema::Compile(const UStruct& Struct)
+{
+	AddFields(Struct, 0, FString());
+
+	// Merge adjacent plain data into memory blocks:
+	for (int32 i = 0; i < Fields.Num(); ++i)
+	{
+		const FOperation& FieldOperation = FieldOperations[i];
+		FOperation* PreviousOperation = (Operations.IsEmpty() ? nullptr : &Operations.Last());
+		if (Fields[i].bIsPlainData && PreviousOperation && !PreviousOperation->Property
+			&& PreviousOperation->Offset + PreviousOperation->Size == FieldOperation.Offset)
+		{
+			PreviousOperation->Size += FieldOperation.Size;
+			continue;
+		}
+		Operations.Add(FieldOperation);
+	}
+
+	FXxHash64Builder HashBuilder;
+	for (const FSaveGameSchemaField& Field : Fields)
+	{
+		const FString FieldDescription = FString::Printf(TEXT("%s:%s:%d:%d;"), *Field.Name, *Field.Type, Field.Size, Field.bIsPlainData ? 1 : 0);
+		HashBuilder.Update(*FieldDescription, FieldDescription.Len() * sizeof(TCHAR));
+	}
+	Hash = FMath::Max<uint64>(HashBuilder.Finalize().Hash, 1);
+}
+
+void FSaveGameSchema::AddFields(const UStruct& Struct, int32 ContainerOffset, const FString& NamePrefix)
+{
+	for (TFieldIterator<FProperty> PropertyItr(&Struct); PropertyItr; ++PropertyItr)
+	{
+		const FProperty* Property = *PropertyItr;
+		if (!Property->HasAnyPropertyFlags(CPF_SaveGame) || Property->HasAnyPropertyFlags(CPF_Transient | CPF_Deprecated))
+			continue;
+
+		const FString FieldName = NamePrefix + Property->GetName();
+		if (ShouldFlattenStruct(*Property))
+		{
+			AddFields(*CastFieldChecked<FStructProperty>(Property)->Struct, ContainerOffset + Property->GetOffset_ForInternal(), FieldName + TEXT("."));
+			continue;
+		}
+
+		FString ExtendedType;
+		FSaveGameSchemaField& Field = Fields.AddDefaulted_GetRef();
+		Field.Name = FieldName;
+		Field.Type = Property->GetCPPType(&ExtendedType, 0) + ExtendedType;
+		Field.Size = Property->GetSize();
+		Field.bIsPlainData = IsPlainData(*Property);
+
+		FOperation& FieldOperation = FieldOperations.AddDefaulted_GetRef();
+		FieldOperation.Property = (Field.bIsPlainData ? nullptr : Property);
+		FieldOperation.Offset = (Field.bIsPlainData ? ContainerOffset + Property->GetOffset_ForInternal() : ContainerOffset);
+		FieldOperation.Size = Field.Size;
+	}
+}
+
+void FSaveGameSchema::SerializeContainer(FArchive& Ar, void* Container, const TArray<FSaveGameSchemaField>* SavedFields) const
+{
+	uint8* ContainerData = static_cast<uint8*>(Container);
+	if (!SavedFields || !Ar.IsLoading())
+	{
+		for (const FOperation& Operation : Operations)
+		{
+			SerializeOperation(Ar, ContainerData, Operation);
+		}
+		return;
+	}
+
+	// Match saved fields by name and type, skipping those that don't exist (anymore):
+	for (const FSaveGameSchemaField& SavedField : *SavedFields)
+	{
+		const int32 FieldIndex = Fields.IndexOfByPredicate([&SavedField](const FSaveGameSchemaField& Field) { return (Field.Name == SavedField.Name); });
+		const bool bIsMatching = (FieldIndex != INDEX_NONE && Fields[FieldIndex].Type == SavedField.Type
+			&& Fields[FieldIndex].Size == SavedField.Size && Fields[FieldIndex].bIsPlainData == SavedField.bIsPlainData);
+		if (bIsMatching)
+		{
+			SerializeOperation(Ar, ContainerData, FieldOperations[FieldIndex]);
+			continue;
+		}
+
+		int32 SavedSize = SavedField.Size;
+		if (!SavedField.bIsPlainData)
+		{
+			Ar << SavedSize;
+		}
+		Ar.Seek(Ar.Tell() + SavedSize);
+	}
+}
+
+void FSaveGameSchema::SerializeOperation(FArchive& Ar, uint8* Container, const FOperation& Operation)
+{
+	if (!Operation.Property)
+	{
+		Ar.Serialize(Container + Operation.Offset, Operation.Size);
+		return;
+	}
+
+	// (i) Other values are prefixed with their size, so they can be skipped if the schema changed.
+	const int64 SizeOffset = Ar.Tell();
+	int32 SerializedSize = 0;
+	Ar << SerializedSize;
+
+	FStructuredArchiveFromArchive StructuredArchive(Ar);
+	Operation.Property->SerializeBinProperty(StructuredArchive.GetSlot(), Container + Operation.Offset);
+
+	const int64 EndOffset = Ar.Tell();
+	if (Ar.IsSaving())
+	{
+		SerializedSize = static_cast<int32>(EndOffset - SizeOffset - sizeof(int32));
+		Ar.Seek(SizeOffset);
+		Ar << SerializedSize;
+	}
+	Ar.Seek(SizeOffset + sizeof(int32) + SerializedSize);
+}
@@ -11,8 +11,77 @@
 
 #include "PlatformFeatures.h"
 #include "SaveGameSystem.h"
+#include "Async/Async.h"
+#include "Engine/StreamableManager.h"
 #include "GameFramework/SaveGame.h"
+#include "HAL/FileManager.h"
+#include "Hash/xxhash.h"
 #include "Kismet/GameplayStatics.h"
+#include "SaveGame/SaveGameService.h"
+#include "SaveGame/Settings/SaveGameServiceSettings.h"
+#include "UObject/Package.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// UTILS
+
+namespace
+{
+	/** Size of the first read of a save file, when only its header is needed. Headers are usually much smaller. */
+	constexpr int64 HeaderReadSize = 64 * 1024;
+
+	/** @returns whether the platform uses the generic ISaveGameSystem, which stores plain files in the SaveGames directory of the project. */
+	bool IsUsingGenericSaveGameSystem()
+	{
+		// (i) The base implementation always returns the generic save game system, which platforms and projects override with their own:
+		IPlatformFeaturesModule& PlatformFeatures = IPlatformFeaturesModule::Get();
+		return (PlatformFeatures.GetSaveGameSystem() == PlatformFeatures.IPlatformFeaturesModule::GetSaveGameSystem());
+	}
+
+	/** @returns whether given object lives in an asset package that can be loaded on its own (e.g. not an actor in a level). */
+	bool IsPreloadableAsset(const UObject* Obj)
+	{
+		if (!Obj || Obj->HasAnyFlags(RF_Transient))
+			return false;
+
+		const UPackage* Package = Obj->GetPackage();
+		return (Package && Package != GetTransientPackage() && !Package->ContainsMap() && !Package->HasAnyPackageFlags(PKG_CompiledIn));
+	}
+
+	/** Reads the chunk list from given save file. Only reads the file type tag of save files that don't use the chunk store. Thread-safe. */
+	bool TryReadChunkListFile(const FString& FilePath, FSaveGameChunkList& OutChunkList)
+	{
+		const TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*FilePath, FILEREAD_Silent));
+		if (!FileReader || FileReader->TotalSize() < static_cast<int64>(sizeof(int32)))
+			return false;
+
+		int32 FileTypeTag = 0;
+		*FileReader << FileTypeTag;
+		if (FileTypeTag != MODULAR_SAVEGAME_CHUNK_LIST_FILE_TYPE_TAG)
+			return false;
+
+		TArray<uint8> FileData;
+		FileData.SetNumUninitialized(FileReader->TotalSize());
+		FileReader->Seek(0);
+		FileReader->Serialize(FileData.GetData(), FileData.Num());
+		return (!FileReader->IsError() && OutChunkList.TryReadFromData(FileData));
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+FWeekendUtilsAssetCollectingProxyArchive::FWeekendUtilsAssetCollectingProxyArchive(FArchive& InInnerArchive, bool bInLoadIfFindFails, TSet<FString>& InReferencedAssetPaths) :
+	FObjectAndNameAsStringProxyArchive(InInnerArchive, bInLoadIfFindFails), ReferencedAssetPaths(InReferencedAssetPaths)
+{
+}
+
+FArchive& FWeekendUtilsAssetCollectingProxyArchive::operator<<(UObject*& Obj)
+{
+	if (IsSaving() && IsPreloadableAsset(Obj))
+	{
+		ReferencedAssetPaths.Add(Obj->GetPathName());
+	}
+	return FObjectAndNameAsStringProxyArchive::operator<<(Obj);
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
@@ -23,6 +92,117 @@ FWeekendUtilsSubobjectProxyArchive::FWeekendUtilsSubobjectProxyArchive(FArchive&
 }
 
 FArchive& FWeekendUtilsSubobjectProxyArchive::operator<<(UObject*& Obj)
+{
+	if (bUseObjectIdentityTable)
+	{
+		SerializeWithIdentityTable(Obj);
+	}
+	else
+	{
+		SerializeInline(Obj);
+	}
+	return *this;
+}
+
+void FWeekendUtilsSubobjectProxyArchive::SerializeWithIdentityTable(UObject*& Obj)
+{
+	// (i) Index into the identity table: INDEX_NONE for objects outside of the owner, followed by their path. An index that is not
+	// in the table yet introduces a new sub-object, followed by its class, data size and data. Other indices are back-references.
+	int32 SubobjectIndex = INDEX_NONE;
+	if (IsLoading())
+	{
+		InnerArchive << SubobjectIndex;
+		if (SubobjectIndex == INDEX_NONE)
+		{
+			// Find/load objects from the asset registry (= asset pointers):
+			FString ObjectPath;
+			InnerArchive << ObjectPath;
+			Obj = FindObject<UObject>(nullptr, *ObjectPath);
+			if (!Obj && bLoadIfFindFails)
+			{
+				Obj = LoadObject<UObject>(nullptr, *ObjectPath);
+			}
+		}
+		else if (SubobjectTable.IsValidIndex(SubobjectIndex))
+		{
+			Obj = SubobjectTable[SubobjectIndex];
+		}
+		else if (SubobjectIndex == SubobjectTable.Num())
+		{
+			// Reconstruct subobjects that were part of the owner hierarchy:
+			FString ClassPath;
+			int64 DataSize = 0;
+			InnerArchive << ClassPath;
+			InnerArchive << DataSize;
+			const int64 DataOffset = Tell();
+			const UClass* Class = UClass::TryFindTypeSlow<UClass>(ClassPath);
+			if (!Class && bLoadIfFindFails)
+			{
+				Class = LoadObject<UClass>(nullptr, *ClassPath);
+			}
+			Obj = (Class ? NewObject<UObject>(&SubobjectOwner, Class) : nullptr);
+
+			// (i) Added before serializing its data, so references back to it from its own data are resolved.
+			SubobjectTable.Add(Obj);
+			if (Obj)
+			{
+				Obj->Serialize(*this);
+			}
+			else
+			{
+				UE_LOG(LogSaveGameService, Warning, TEXT("Skipped SaveGame sub-object, because its class \"%s\" does not exist."), *ClassPath);
+			}
+			Seek(DataOffset + DataSize);
+		}
+		else
+		{
+			SetError();
+			Obj = nullptr;
+		}
+		return;
+	}
+
+	if (!Obj || !Obj->IsInOuter(&SubobjectOwner))
+	{
+		FString ObjectPath(GetPathNameSafe(Obj));
+		if (IsPreloadableAsset(Obj))
+		{
+			ReferencedAssetPaths.Add(ObjectPath);
+		}
+		InnerArchive << SubobjectIndex;
+		InnerArchive << ObjectPath;
+		return;
+	}
+
+	if (const int32* ExistingIndex = SubobjectIndices.Find(Obj))
+	{
+		SubobjectIndex = *ExistingIndex;
+		InnerArchive << SubobjectIndex;
+		return;
+	}
+
+	FString ClassPath(GetPathNameSafe(Obj->GetClass()));
+	if (IsPreloadableAsset(Obj->GetClass()))
+	{
+		ReferencedAssetPaths.Add(ClassPath);
+	}
+	SubobjectIndex = SubobjectIndices.Add(Obj, SubobjectIndices.Num());
+	InnerArchive << SubobjectIndex;
+	InnerArchive << ClassPath;
+
+	// (i) Data is prefixed with its size, so sub-objects of classes that don't exist anymore can be skipped.
+	const int64 DataSizeOffset = Tell();
+	int64 DataSize = 0;
+	InnerArchive << DataSize;
+	Obj->Serialize(*this);
+	const int64 DataEndOffset = Tell();
+	DataSize = (DataEndOffset - DataSizeOffset - sizeof(int64));
+	Seek(DataSizeOffset);
+	InnerArchive << DataSize;
+	Seek(DataEndOffset);
+}
+
+void FWeekendUtilsSubobjectProxyArchive::SerializeInline(UObject*& Obj)
 {
 	if (IsLoading())
 	{
@@ -51,7 +231,7 @@ FArchive& FWeekendUtilsSubobjectProxyArchive::operator<<(UObject*& Obj)
 			if (Class)
 			{
 				Obj = NewObject<UObject>(&SubobjectOwner, Class);
-				FObjectAndNameAsStringProxyArchive SubobjectArchive(InnerArchive, bLoadIfFindFails);
+				FWeekendUtilsAssetCollectingProxyArchive SubobjectArchive(InnerArchive, bLoadIfFindFails, ReferencedAssetPaths);
 				Obj->Serialize(SubobjectArchive);
 			}
 		}
@@ -61,16 +241,23 @@ FArchive& FWeekendUtilsSubobjectProxyArchive::operator<<(UObject*& Obj)
 		FString ObjectPath(GetPathNameSafe(Obj));
 		FString ClassPath (GetPathNameSafe(Obj ? Obj->GetClass() : nullptr));
 		FString IsSubObjectOfOwner = Obj->IsInOuter(&SubobjectOwner) ? "1" : "0";
+		if (IsSubObjectOfOwner != "1" && IsPreloadableAsset(Obj))
+		{
+			ReferencedAssetPaths.Add(ObjectPath);
+		}
+		else if (IsSubObjectOfOwner == "1" && IsPreloadableAsset(Obj->GetClass()))
+		{
+			ReferencedAssetPaths.Add(ClassPath);
+		}
 		InnerArchive << ObjectPath;
 		InnerArchive << ClassPath;
 		InnerArchive << IsSubObjectOfOwner;
 		if (Obj->IsInOuter(&SubobjectOwner))
 		{
-			FObjectAndNameAsStringProxyArchive SubobjectArchive(InnerArchive, bLoadIfFindFails);
+			FWeekendUtilsAssetCollectingProxyArchive SubobjectArchive(InnerArchive, bLoadIfFindFails, ReferencedAssetPaths);
 			Obj->Serialize(SubobjectArchive);
 		}
 	}
-	return *this;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -79,7 +266,14 @@ bool USaveGameSerializer::TrySerializeSaveGame(USaveGame& InSaveGameObject, TArr
 {
 	// (i) FWeekendUtilsSaveGameProxyArchive is not used here, because the base implementation of the USaveGameSerializer
 	// will just forward all calls to the default UE UGameplayStatics implementation. But see UModularSaveGameSerializer.
-	return UGameplayStatics::SaveGameToMemory(&InSaveGameObject, OUT OutSaveData);
+	LastContentHash.Reset();
+	LastSizeReport.Reset();
+	if (!UGameplayStatics::SaveGameToMemory(&InSaveGameObject, OUT OutSaveData))
+		return false;
+
+	LastContentHash = FXxHash64::HashBuffer(OutSaveData.GetData(), OutSaveData.Num()).Hash;
+	LastSizeReport.TotalBytes = OutSaveData.Num();
+	return true;
 }
 
 bool USaveGameSerializer::TryDeserializeSaveGame(const TArray<uint8>& InSaveData, USaveGame*& OutSaveGameObject) const
@@ -90,6 +284,70 @@ bool USaveGameSerializer::TryDeserializeSaveGame(const TArray<uint8>& InSaveData
 	return (OutSaveGameObject != nullptr);
 }
 
+FSaveGameSizeReport USaveGameSerializer::MeasureSaveGameSize(USaveGame& InSaveGameObject) const
+{
+	const TOptional<uint64> LastContentHashBefore = LastContentHash;
+	FSaveGameSizeReport LastSizeReportBefore = LastSizeReport;
+	const double LastCompressionTimeBefore = LastCompressionTime;
+	TMap<FName, double> LastModuleTimesBefore = LastModuleTimes;
+
+	FSaveGameSizeReport SizeReport;
+	const TSharedRef<TArray<uint8>> SaveData = GetBufferPool()->Acquire(LastSizeReport.TotalBytes);
+	if (TrySerializeSaveGame(InSaveGameObject, OUT *SaveData))
+	{
+		SizeReport = MoveTemp(LastSizeReport);
+	}
+
+	LastContentHash = LastContentHashBefore;
+	LastSizeReport = MoveTemp(LastSizeReportBefore);
+	LastCompressionTime = LastCompressionTimeBefore;
+	LastModuleTimes = MoveTemp(LastModuleTimesBefore);
+	return SizeReport;
+}
+
+void USaveGameSerializer::AsyncDeserializeSaveGame(const TArray<uint8>& InSaveData, FOnAsyncDeserializeCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken)
+{
+	LastAssetPreloadTime = 0.0;
+
+	TArray<FSoftObjectPath> AssetsToPreload;
+	if (GetDefault<USaveGameServiceSettings>()->bPreloadReferencedAssets)
+	{
+		GetUnloadedReferencedAssets(InSaveData, OUT AssetsToPreload);
+	}
+
+	if (AssetsToPreload.IsEmpty())
+	{
+		USaveGame* SaveGame = nullptr;
+		if (!FSaveLoadCancellationToken::IsCancelled(CancellationToken))
+		{
+			TryDeserializeSaveGame(InSaveData, OUT SaveGame);
+		}
+		Callback.ExecuteIfBound(SaveGame);
+		return;
+	}
+
+	// (i) Otherwise, resolving the references during deserialization would block on one package load after another:
+	if (!StreamableManager.IsValid())
+	{
+		StreamableManager = MakeShared<FStreamableManager>();
+	}
+
+	const TSharedRef<TArray<uint8>> SaveData = GetBufferPool()->Acquire(InSaveData.Num());
+	SaveData->Append(InSaveData);
+	StreamableManager->RequestAsyncLoad(MoveTemp(AssetsToPreload), FStreamableDelegate::CreateWeakLambda(this,
+		[this, SaveData, Callback, CancellationToken, PreloadStartTime = FPlatformTime::Seconds()]()
+		{
+			LastAssetPreloadTime = FPlatformTime::Seconds() - PreloadStartTime;
+
+			USaveGame* SaveGame = nullptr;
+			if (!FSaveLoadCancellationToken::IsCancelled(CancellationToken))
+			{
+				TryDeserializeSaveGame(*SaveData, OUT SaveGame);
+			}
+			Callback.ExecuteIfBound(SaveGame);
+		}), FStreamableManager::AsyncLoadHighPriority);
+}
+
 bool USaveGameSerializer::DoesSaveGameExist(const FSlotName& SlotName, const int32 UserIndex) const
 {
 	return UGameplayStatics::DoesSaveGameExist(SlotName, UserIndex);
@@ -97,7 +355,14 @@ bool USaveGameSerializer::DoesSaveGameExist(const FSlotName& SlotName, const int
 
 bool USaveGameSerializer::TrySaveDataToSlot(const TArray<uint8>& InSaveData, const FSlotName& SlotName, const int32 UserIndex)
 {
-	return UGameplayStatics::SaveDataToSlot(InSaveData, SlotName, UserIndex);
+	if (IsChunkStoreEnabled())
+		return TrySaveDataToSlotAsChunks(InSaveData, SlotName, UserIndex);
+
+	if (!GetStorageBackend().TryWriteSlot(SlotName, UserIndex, InSaveData))
+		return false;
+
+	UpdateSlotManifest(SlotName, InSaveData);
+	return true;
 }
 
 bool USaveGameSerializer::TrySaveGameToSlot(USaveGame& SaveGameObject, const FSlotName& SlotName, const int32 UserIndex)
@@ -109,23 +374,42 @@ bool USaveGameSerializer::TrySaveGameToSlot(USaveGame& SaveGameObject, const FSl
 	return false;
 }
 
-void USaveGameSerializer::AsyncSaveGameToSlot(USaveGame& SaveGameObject, const FSlotName& SlotName, const int32 UserIndex, FOnAsyncSaveCompleted Callback)
+void USaveGameSerializer::AsyncSaveGameToSlot(USaveGame& SaveGameObject, const FSlotName& SlotName, const int32 UserIndex, FOnAsyncSaveCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken, ESaveGameIOPriority Priority)
+{
+	const TSharedRef<TArray<uint8>> ObjectBytes = GetBufferPool()->AcquireForSlot(SlotName);
+	if (!FSaveLoadCancellationToken::IsCancelled(CancellationToken) && TrySerializeSaveGame(SaveGameObject, OUT *ObjectBytes))
+	{
+		AsyncSaveDataToSlot(ObjectBytes, SlotName, UserIndex, Callback, CancellationToken, Priority);
+	}
+	else
+	{
+		Callback.ExecuteIfBound(SlotName, UserIndex, false);
+	}
+}
+
+void USaveGameSerializer::AsyncSaveDataToSlot(const TSharedRef<TArray<uint8>>& InSaveData, const FSlotName& SlotName, const int32 UserIndex, FOnAsyncSaveCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken, ESaveGameIOPriority Priority)
 {
 	// (i) Mostly copied from UGameplayStatics::AsyncSaveGameToSlot,
-	// but using this serializers internal methods.
+	// but using this serializers internal methods and writing through the storage backend.
 
-	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
-	TSharedRef<TArray<uint8>> ObjectBytes(new TArray<uint8>());
+	GetBufferPool()->RecordSlotSize(SlotName, InSaveData->Num());
+	if (IsChunkStoreEnabled())
+	{
+		AsyncSaveDataToSlotAsChunks(InSaveData, SlotName, UserIndex, Callback, CancellationToken, Priority);
+		return;
+	}
 
-	if (SaveSystem && (SlotName.Len() > 0) && 
-		TrySerializeSaveGame(SaveGameObject, OUT *ObjectBytes) && (ObjectBytes->Num() > 0) )
+	if ((SlotName.Len() > 0) && (InSaveData->Num() > 0) && !FSaveLoadCancellationToken::IsCancelled(CancellationToken))
 	{
-		const FPlatformUserId PlatformUserId = FPlatformMisc::GetPlatformUserForUserIndex(UserIndex);
-		SaveSystem->SaveGameAsync(false, *SlotName, PlatformUserId, ObjectBytes, 
-			[Callback, UserIndex](const FString& ResultSlotName, FPlatformUserId, bool bSuccess)
+		GetStorageBackend().AsyncWriteSlot(SlotName, UserIndex, InSaveData, Priority, WriteThrottle,
+			[WeakThis = MakeWeakObjectPtr(this), InSaveData, Callback, SlotName, UserIndex](bool bSuccess)
 			{
 				check(IsInGameThread());
-				Callback.ExecuteIfBound(ResultSlotName, UserIndex, bSuccess);
+				if (bSuccess && WeakThis.IsValid())
+				{
+					WeakThis->UpdateSlotManifest(SlotName, *InSaveData);
+				}
+				Callback.ExecuteIfBound(SlotName, UserIndex, bSuccess);
 			}
 		);
 	}
@@ -137,7 +421,15 @@ void USaveGameSerializer::AsyncSaveGameToSlot(USaveGame& SaveGameObject, const F
 
 bool USaveGameSerializer::TryLoadDataFromSlot(const FSlotName& SlotName, const int32 UserIndex, TArray<uint8>& OutSaveData)
 {
-	return UGameplayStatics::LoadDataFromSlot(OUT OutSaveData, SlotName, UserIndex);
+	if (!GetStorageBackend().TryReadSlot(SlotName, UserIndex, OUT OutSaveData))
+		return false;
+
+	// (i) Save files referencing the chunk store are always assembled, even if the chunk store got disabled in the meantime.
+	if (!FSaveGameChunkList::IsChunkListData(OutSaveData))
+		return true;
+
+	FSaveGameChunkList ChunkList;
+	return (ChunkList.TryReadFromData(OutSaveData) && GetChunkStore()->TryAssembleData(ChunkList, OUT OutSaveData));
 }
 
 bool USaveGameSerializer::TryLoadGameFromSlot(const FSlotName& SlotName, const int32 UserIndex, USaveGame*& OutSaveGameObject)
@@ -149,45 +441,506 @@ bool USaveGameSerializer::TryLoadGameFromSlot(const FSlotName& SlotName, const i
 	return false;
 }
 
-void USaveGameSerializer::AsyncLoadGameFromSlot(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncLoadCompleted Callback)
+void USaveGameSerializer::AsyncLoadGameFromSlot(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncLoadCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken, ESaveGameIOPriority Priority)
+{
+	AsyncLoadDataFromSlot(SlotName, UserIndex, FOnAsyncLoadDataCompleted::CreateWeakLambda(this,
+		[this, Callback, CancellationToken](const FSlotName& ResultSlotName, const int32 ResultUserIndex, bool bSuccess, const TArray<uint8>& Data)
+		{
+			if (!bSuccess)
+			{
+				Callback.ExecuteIfBound(ResultSlotName, ResultUserIndex, nullptr);
+				return;
+			}
+
+			AsyncDeserializeSaveGame(Data, FOnAsyncDeserializeCompleted::CreateLambda(
+				[Callback, ResultSlotName, ResultUserIndex](USaveGame* LoadedGame)
+				{
+					Callback.ExecuteIfBound(ResultSlotName, ResultUserIndex, LoadedGame);
+				}), CancellationToken);
+		}), CancellationToken, Priority);
+}
+
+void USaveGameSerializer::AsyncLoadDataFromSlot(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncLoadDataCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken, ESaveGameIOPriority Priority)
 {
 	// (i) Mostly copied from UGameplayStatics::AsyncLoadGameFromSlot,
-	// but using this serializers internal methods.
+	// but without deserializing the loaded data and reading through the storage backend.
 
-	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
-	if (SaveSystem && (SlotName.Len() > 0))
+	if ((SlotName.Len() > 0) && !FSaveLoadCancellationToken::IsCancelled(CancellationToken))
 	{
-		const FPlatformUserId PlatformUserId = FPlatformMisc::GetPlatformUserForUserIndex(UserIndex);
-		SaveSystem->LoadGameAsync(false, *SlotName, PlatformUserId,
-			[this, Callback, UserIndex](const FString& ResultSlotName, FPlatformUserId, bool bSuccess, const TArray<uint8>& Data)
+		GetStorageBackend().AsyncReadSlot(SlotName, UserIndex, Priority,
+			[WeakThis = MakeWeakObjectPtr(this), Callback, ResultSlotName = SlotName, UserIndex, CancellationToken, Priority](bool bSuccess, const TArray<uint8>& Data)
 			{
 				check(IsInGameThread());
+				if (FSaveLoadCancellationToken::IsCancelled(CancellationToken))
+				{
+					// (i) Nobody wants the data anymore -> don't hand it out for deserialization:
+					Callback.ExecuteIfBound(ResultSlotName, UserIndex, false, TArray<uint8>());
+					return;
+				}
 
-				USaveGame* LoadedGame = nullptr;
-				if (bSuccess)
+				FSaveGameChunkList ChunkList;
+				if (!bSuccess || !FSaveGameChunkList::IsChunkListData(Data))
+				{
+					Callback.ExecuteIfBound(ResultSlotName, UserIndex, bSuccess, Data);
+					return;
+				}
+				if (!WeakThis.IsValid() || !ChunkList.TryReadFromData(Data))
 				{
-					TryDeserializeSaveGame(Data, OUT LoadedGame);
+					Callback.ExecuteIfBound(ResultSlotName, UserIndex, false, TArray<uint8>());
+					return;
 				}
 
-				Callback.ExecuteIfBound(ResultSlotName, UserIndex, LoadedGame);
+				// Save file only references its chunks -> read and assemble them on a worker thread:
+				AsyncTask(GetSaveGameIOTaskThread(Priority),
+					[ChunkStore = WeakThis->GetChunkStore(), BufferPool = WeakThis->GetBufferPool(), ChunkList = MoveTemp(ChunkList), Callback, ResultSlotName, UserIndex, CancellationToken]()
+					{
+						const TSharedRef<TArray<uint8>> AssembledData = BufferPool->Acquire(ChunkList.TotalSize);
+						const bool bAssembled = (!FSaveLoadCancellationToken::IsCancelled(CancellationToken) && ChunkStore->TryAssembleData(ChunkList, OUT *AssembledData));
+						AsyncTask(ENamedThreads::GameThread, [Callback, ResultSlotName, UserIndex, CancellationToken, bAssembled, AssembledData]()
+						{
+							if (!bAssembled || FSaveLoadCancellationToken::IsCancelled(CancellationToken))
+							{
+								Callback.ExecuteIfBound(ResultSlotName, UserIndex, false, TArray<uint8>());
+								return;
+							}
+							Callback.ExecuteIfBound(ResultSlotName, UserIndex, true, *AssembledData);
+						});
+					});
 			}
 		);
 	}
 	else
 	{
-		Callback.ExecuteIfBound(SlotName, UserIndex, nullptr);
+		Callback.ExecuteIfBound(SlotName, UserIndex, false, TArray<uint8>());
 	}
 }
 
 bool USaveGameSerializer::TryDeleteGameInSlot(const FSlotName& SlotName, const int32 UserIndex, TOptional<FString> OptionalBackupFolder)
 {
+	// (i) The manifest entry is only removed once the save file is actually gone. Otherwise it would be rebuilt from the file anyway.
 	if (OptionalBackupFolder.IsSet())
 	{
-		const FString SourceFilePath = FString(FPaths::ProjectSavedDir() / "SaveGames" / SlotName + ".sav");
+		// (i) When the save file only references its chunks, the backup keeps these references and moving it is all it takes.
+		const FString SourceFilePath = GetSlotFilePath(SlotName);
 		const FString BackupFilePath = FString(FPaths::ProjectSavedDir() / "SaveGames" / *OptionalBackupFolder / SlotName + ".sav");
+		FSaveGameChunkList ReplacedBackupChunkList;
+		const bool bReplacesBackupWithChunkList = TryReadChunkListFile(BackupFilePath, OUT ReplacedBackupChunkList);
 		if (IFileManager::Get().Move(*BackupFilePath, *SourceFilePath, true))
+		{
+			RemoveFromSlotManifest(SlotName);
+
+			// The previous backup is overwritten, so its chunks must not be kept alive by it anymore:
+			if (bReplacesBackupWithChunkList)
+			{
+				ReleaseChunkReferences(ReplacedBackupChunkList);
+			}
 			return true;
+		}
 	}
 
-	return UGameplayStatics::DeleteGameInSlot(SlotName, UserIndex);
+	FSaveGameChunkList ChunkList;
+	const bool bHasChunkList = TryReadChunkListFile(GetSlotFilePath(SlotName), OUT ChunkList);
+	if (!UGameplayStatics::DeleteGameInSlot(SlotName, UserIndex))
+		return false;
+
+	RemoveFromSlotManifest(SlotName);
+	if (bHasChunkList)
+	{
+		ReleaseChunkReferences(ChunkList);
+	}
+	return true;
+}
+
+bool USaveGameSerializer::TryReadSlotHeader(const FSlotName& SlotName, const int32 UserIndex, FSaveGameSlotManifestEntry& OutEntry)
+{
+	TMap<FSlotName, FSaveGameSlotManifestEntry> Result = ReadSlotHeaders({SlotName}, UserIndex);
+	if (FSaveGameSlotManifestEntry* Entry = Result.Find(SlotName))
+	{
+		OutEntry = MoveTemp(*Entry);
+		return true;
+	}
+	return false;
+}
+
+TMap<USaveGameSerializer::FSlotName, FSaveGameSlotManifestEntry> USaveGameSerializer::ReadSlotHeaders(const TSet<FSlotName>& SlotNames, const int32 UserIndex)
+{
+	TMap<FSlotName, FSaveGameSlotManifestEntry> Result = {};
+	if (SlotNames.IsEmpty())
+		return Result;
+
+	// Without manifest, every save file has to be opened to read its header:
+	if (!IsSlotManifestEnabled())
+	{
+		for (const FSlotName& SlotName : SlotNames)
+		{
+			FSaveGameSlotManifestEntry Entry;
+			if (TryReadHeaderFromSlotFile(SlotName, UserIndex, OUT Entry))
+			{
+				Result.Add(SlotName, MoveTemp(Entry));
+			}
+		}
+		return Result;
+	}
+
+	// Gather timestamps and sizes of all save files at once, to validate manifest entries against them:
+	TMap<FSlotName, FFileStatData> FileStatsBySlot = {};
+	const FString SaveGamesDirectory = FPaths::GetPath(GetSlotFilePath("_"));
+	IFileManager::Get().IterateDirectoryStat(*SaveGamesDirectory, [&FileStatsBySlot](const TCHAR* FilePath, const FFileStatData& StatData)
+	{
+		if (!StatData.bIsDirectory && FPaths::GetExtension(FilePath) == TEXT("sav"))
+		{
+			FileStatsBySlot.Add(FPaths::GetBaseFilename(FilePath), StatData);
+		}
+		return true;
+	});
+
+	FSaveGameSlotManifest& Manifest = GetSlotManifest();
+	bool bIsManifestDirty = false;
+	for (const FSlotName& SlotName : SlotNames)
+	{
+		const FFileStatData* FileStat = FileStatsBySlot.Find(SlotName);
+		if (!FileStat)
+		{
+			// Save file is gone (probably deleted externally) -> entry is stale:
+			bIsManifestDirty |= Manifest.Remove(SlotName);
+			continue;
+		}
+
+		if (Manifest.IsUpToDate(SlotName, FileStat->ModificationTime, FileStat->FileSize))
+		{
+			Result.Add(SlotName, *Manifest.Find(SlotName));
+			continue;
+		}
+
+		// Entry is missing or stale -> rebuild it from the actual save file:
+		FSaveGameSlotManifestEntry Entry;
+		if (TryReadHeaderFromSlotFile(SlotName, UserIndex, OUT Entry))
+		{
+			Entry.FileTimeStamp = FileStat->ModificationTime;
+			Entry.FileSize = FileStat->FileSize;
+			Manifest.Update(SlotName, Entry);
+			Result.Add(SlotName, MoveTemp(Entry));
+			bIsManifestDirty = true;
+		}
+		else
+		{
+			bIsManifestDirty |= Manifest.Remove(SlotName);
+		}
+	}
+
+	if (bIsManifestDirty)
+	{
+		Manifest.TrySaveToFile(GetSlotManifestFilePath());
+	}
+
+	return Result;
+}
+
+void USaveGameSerializer::AsyncReadSlotHeader(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncReadSlotHeaderCompleted Callback, ESaveGameIOPriority Priority)
+{
+	// (i) Like TryReadHeaderFromSlotFile(), only the beginning of the save file is read. The backend is shared with the worker thread,
+	// so the read doesn't depend on the lifetime of this serializer:
+	GetStorageBackend();
+	AsyncTask(GetSaveGameIOTaskThread(Priority), [WeakThis = MakeWeakObjectPtr(this), Backend = StorageBackend.ToSharedRef(), SlotName, UserIndex, Callback, Priority]()
+	{
+		const TSharedRef<TArray<uint8>> SaveData = MakeShared<TArray<uint8>>();
+		const bool bSuccess = Backend->TryReadSlotRange(SlotName, UserIndex, 0, HeaderReadSize, OUT *SaveData);
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, SlotName, UserIndex, Callback, Priority, bSuccess, SaveData]()
+		{
+			FSaveGameSlotManifestEntry Entry;
+			if (!bSuccess || !WeakThis.IsValid())
+			{
+				Callback.ExecuteIfBound(SlotName, false, Entry);
+				return;
+			}
+
+			if (!FSaveGameChunkList::IsChunkListData(*SaveData))
+			{
+				// (i) When less than requested was read, the whole file was read already:
+				const bool bHeaderRead = WeakThis->TryReadHeaderFromSaveData(*SaveData, OUT Entry);
+				if (bHeaderRead || SaveData->Num() < HeaderReadSize)
+				{
+					Callback.ExecuteIfBound(SlotName, bHeaderRead, Entry);
+					return;
+				}
+			}
+
+			// Header didn't fit or save file only references its chunks -> read the whole (assembled) save file:
+			WeakThis->AsyncLoadDataFromSlot(SlotName, UserIndex, FOnAsyncLoadDataCompleted::CreateLambda(
+				[WeakThis, Callback](const FSlotName& LoadedSlotName, const int32, bool bLoaded, const TArray<uint8>& LoadedData)
+				{
+					FSaveGameSlotManifestEntry LoadedEntry;
+					const bool bHeaderRead = (bLoaded && WeakThis.IsValid() && WeakThis->TryReadHeaderFromSaveData(LoadedData, OUT LoadedEntry));
+					Callback.ExecuteIfBound(LoadedSlotName, bHeaderRead, LoadedEntry);
+				}), nullptr, Priority);
+		});
+	});
+}
+
+FString USaveGameSerializer::GetSlotFilePath(const FSlotName& SlotName) const
+{
+	// (i) Matches the location where the generic ISaveGameSystem stores its files.
+	return FString(FPaths::ProjectSavedDir() / "SaveGames" / SlotName + ".sav");
+}
+
+FString USaveGameSerializer::GetSlotManifestFilePath() const
+{
+	return FString(FPaths::ProjectSavedDir() / "SaveGames" / "SaveGameSlots.manifest");
+}
+
+FString USaveGameSerializer::GetChunkStoreDirectory() const
+{
+	return FString(FPaths::ProjectSavedDir() / "SaveGames" / "Chunks");
+}
+
+bool USaveGameSerializer::IsSlotManifestEnabled() const
+{
+	// (i) Manifest entries are validated against the save files on disk, which only exist at the slot file paths with the generic ISaveGameSystem.
+	return (GetDefault<USaveGameServiceSettings>()->bUseSlotManifest && IsUsingGenericSaveGameSystem());
+}
+
+bool USaveGameSerializer::IsChunkStoreEnabled() const
+{
+	// (i) Chunks are stored next to the save files, which only works when these are plain files as well.
+	return (GetDefault<USaveGameServiceSettings>()->bUseChunkStore && IsUsingGenericSaveGameSystem());
+}
+
+TSharedRef<ISaveGameStorageBackend> USaveGameSerializer::CreateStorageBackend() const
+{
+	// (i) Synchronous and asynchronous reads and writes all go through the same backend, so an overridden ISaveGameSystem
+	// either sees all save files or none. Bypassing it is opt-in, as projects may override it e.g. for cloud saves.
+	// (i) Only the generic ISaveGameSystem stores plain files at the slot file paths. Other platforms (and overrides) may store them anywhere.
+	if (GetDefault<USaveGameServiceSettings>()->bReadSaveFilesDirectly && IsUsingGenericSaveGameSystem())
+		return MakeShared<FSaveGameFileStorageBackend>(FPaths::GetPath(GetSlotFilePath("_")), GetBufferPool());
+
+	return MakeShared<FSaveGameSystemStorageBackend>();
+}
+
+ISaveGameStorageBackend& USaveGameSerializer::GetStorageBackend()
+{
+	if (!StorageBackend.IsValid())
+	{
+		StorageBackend = CreateStorageBackend();
+		UE_LOG(LogSaveGameService, Log, TEXT("Reading and writing save files through storage backend: %s"), StorageBackend->GetName());
+	}
+	return *StorageBackend;
+}
+
+TSharedRef<FSaveGameBufferPool> USaveGameSerializer::GetBufferPool() const
+{
+	if (!BufferPool.IsValid())
+	{
+		BufferPool = MakeShared<FSaveGameBufferPool>(static_cast<int64>(GetDefault<USaveGameServiceSettings>()->BufferPoolBudgetKiB) * 1024);
+	}
+	return BufferPool.ToSharedRef();
+}
+
+bool USaveGameSerializer::TryReadHeaderFromSlotFile(const FSlotName& SlotName, const int32 UserIndex, FSaveGameSlotManifestEntry& OutEntry)
+{
+	// Read only the beginning of the save file, and more of it only when the header didn't fit:
+	TArray<uint8> SaveData;
+	for (int64 NumBytes = HeaderReadSize; true; NumBytes *= 4)
+	{
+		if (!GetStorageBackend().TryReadSlotRange(SlotName, UserIndex, 0, NumBytes, OUT SaveData))
+			return false;
+
+		// Save file only references its chunks -> header is in the first chunk, but the chunks have to be assembled anyway:
+		if (FSaveGameChunkList::IsChunkListData(SaveData))
+			return (TryLoadDataFromSlot(SlotName, UserIndex, OUT SaveData) && TryReadHeaderFromSaveData(SaveData, OUT OutEntry));
+
+		if (TryReadHeaderFromSaveData(SaveData, OUT OutEntry))
+			return true;
+
+		// Whole file was read already:
+		if (SaveData.Num() < NumBytes)
+			return false;
+	}
+}
+
+FSaveGameSlotManifest& USaveGameSerializer::GetSlotManifest()
+{
+	if (!SlotManifest.IsSet())
+	{
+		// (i) A missing or incompatible manifest is fine: Entries are rebuilt on demand when reading slot headers.
+		SlotManifest.Emplace();
+		SlotManifest->TryLoadFromFile(GetSlotManifestFilePath());
+	}
+	return *SlotManifest;
+}
+
+void USaveGameSerializer::UpdateSlotManifest(const FSlotName& SlotName, const TArray<uint8>& InSaveData)
+{
+	if (!IsSlotManifestEnabled())
+		return;
+
+	FSaveGameSlotManifestEntry Entry;
+	const FFileStatData FileStat = IFileManager::Get().GetStatData(*GetSlotFilePath(SlotName));
+	if (!FileStat.bIsValid || !TryReadHeaderFromSaveData(InSaveData, OUT Entry))
+	{
+		// Entry can't be validated against the file -> better have no entry than a stale one:
+		RemoveFromSlotManifest(SlotName);
+		return;
+	}
+
+	Entry.FileTimeStamp = FileStat.ModificationTime;
+	Entry.FileSize = FileStat.FileSize;
+
+	FSaveGameSlotManifest& Manifest = GetSlotManifest();
+	Manifest.Update(SlotName, Entry);
+	Manifest.TrySaveToFile(GetSlotManifestFilePath());
+}
+
+void USaveGameSerializer::RemoveFromSlotManifest(const FSlotName& SlotName)
+{
+	if (!IsSlotManifestEnabled())
+		return;
+
+	FSaveGameSlotManifest& Manifest = GetSlotManifest();
+	if (Manifest.Remove(SlotName))
+	{
+		Manifest.TrySaveToFile(GetSlotManifestFilePath());
+	}
+}
+
+FSaveGameChunkStoreIntegrityReport USaveGameSerializer::VerifyChunkStoreIntegrity(bool bRepair)
+{
+	if (bRepair && NumChunkWritesInFlight > 0)
+	{
+		// (i) Chunks of writes in flight aren't referenced yet and would be deleted as unreferenced.
+		UE_LOG(LogSaveGameService, Warning, TEXT("Can't repair SaveGame chunk store while save files are written. Only verifying it."));
+		bRepair = false;
+	}
+
+	return GetChunkStore()->VerifyIntegrity(ReadAllChunkLists(), bRepair);
+}
+
+TSharedRef<FSaveGameChunkStore> USaveGameSerializer::GetChunkStore()
+{
+	if (!ChunkStore.IsValid())
+	{
+		ChunkStore = MakeShared<FSaveGameChunkStore>(GetChunkStoreDirectory());
+		if (!ChunkStore->TryLoadIndex())
+		{
+			// (i) Without index, garbage collection could delete chunks that are still used by other save files -> rebuild it.
+			ChunkStore->RebuildReferences(ReadAllChunkLists());
+		}
+	}
+	return ChunkStore.ToSharedRef();
+}
+
+bool USaveGameSerializer::TrySaveDataToSlotAsChunks(const TArray<uint8>& InSaveData, const FSlotName& SlotName, const int32 UserIndex)
+{
+	const TSharedRef<FSaveGameChunkStore> Store = GetChunkStore();
+
+	FSaveGameChunkList PreviousChunkList;
+	TryReadChunkListFile(GetSlotFilePath(SlotName), OUT PreviousChunkList);
+
+	const FSaveGameChunkList ChunkList = FSaveGameChunkStore::SplitIntoChunks(InSaveData);
+	int64 WrittenBytes = 0;
+	const bool bChunksWritten = Store->TryWriteChunks(InSaveData, ChunkList, OUT WrittenBytes);
+	Store->AddReferences(ChunkList);
+
+	TArray<uint8> ChunkListData;
+	ChunkList.WriteToData(OUT ChunkListData);
+	if (!bChunksWritten || !GetStorageBackend().TryWriteSlot(SlotName, UserIndex, ChunkListData))
+	{
+		ReleaseChunkReferences(ChunkList);
+		return false;
+	}
+
+	UE_LOG(LogSaveGameService, Verbose, TEXT("Saved %s as %d chunks, of which %lld of %lld bytes were new."), *SlotName, ChunkList.Chunks.Num(), WrittenBytes, ChunkList.TotalSize);
+	ReleaseChunkReferences(PreviousChunkList);
+	UpdateSlotManifest(SlotName, InSaveData);
+	return true;
+}
+
+void USaveGameSerializer::AsyncSaveDataToSlotAsChunks(const TSharedRef<TArray<uint8>>& InSaveData, const FSlotName& SlotName, const int32 UserIndex, FOnAsyncSaveCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken, ESaveGameIOPriority Priority)
+{
+	if ((SlotName.Len() == 0) || (InSaveData->Num() == 0) || FSaveLoadCancellationToken::IsCancelled(CancellationToken))
+	{
+		Callback.ExecuteIfBound(SlotName, UserIndex, false);
+		return;
+	}
+
+	// Splitting, hashing and writing new chunks happens on a worker thread, then the slot file referencing them is written as usual:
+	++NumChunkWritesInFlight;
+	AsyncTask(GetSaveGameIOTaskThread(Priority),
+		[WeakThis = MakeWeakObjectPtr(this), Store = GetChunkStore(), Throttle = (Priority < ESaveGameIOPriority::High ? WriteThrottle.ToSharedPtr() : nullptr),
+			SlotFilePath = GetSlotFilePath(SlotName), InSaveData, SlotName, UserIndex, Callback, CancellationToken, Priority]()
+		{
+			FSaveGameChunkList PreviousChunkList;
+			TryReadChunkListFile(SlotFilePath, OUT PreviousChunkList);
+
+			FSaveGameChunkList ChunkList = FSaveGameChunkStore::SplitIntoChunks(*InSaveData);
+			int64 WrittenBytes = 0;
+			const bool bChunksWritten = (!FSaveLoadCancellationToken::IsCancelled(CancellationToken) && Store->TryWriteChunks(*InSaveData, ChunkList, OUT WrittenBytes, Throttle.Get()));
+
+			AsyncTask(ENamedThreads::GameThread,
+				[WeakThis, Store, InSaveData, SlotName, UserIndex, Callback, CancellationToken, Priority, bChunksWritten, WrittenBytes,
+					ChunkList = MoveTemp(ChunkList), PreviousChunkList = MoveTemp(PreviousChunkList)]()
+				{
+					USaveGameSerializer* This = WeakThis.Get();
+					if (!This)
+					{
+						Callback.ExecuteIfBound(SlotName, UserIndex, false);
+						return;
+					}
+
+					--This->NumChunkWritesInFlight;
+					Store->AddReferences(ChunkList);
+					if (!bChunksWritten || FSaveLoadCancellationToken::IsCancelled(CancellationToken))
+					{
+						This->ReleaseChunkReferences(ChunkList);
+						Callback.ExecuteIfBound(SlotName, UserIndex, false);
+						return;
+					}
+
+					UE_LOG(LogSaveGameService, Verbose, TEXT("Saving %s as %d chunks, of which %lld of %lld bytes were new."), *SlotName, ChunkList.Chunks.Num(), WrittenBytes, ChunkList.TotalSize);
+					const TSharedRef<TArray<uint8>> ChunkListData = MakeShared<TArray<uint8>>();
+					ChunkList.WriteToData(OUT *ChunkListData);
+
+					This->GetStorageBackend().AsyncWriteSlot(SlotName, UserIndex, ChunkListData, Priority, This->WriteThrottle,
+						[WeakThis, InSaveData, Callback, SlotName, UserIndex, ChunkList, PreviousChunkList](bool bSuccess)
+						{
+							check(IsInGameThread());
+							if (WeakThis.IsValid())
+							{
+								// (i) Whichever chunk list is not in the slot file anymore gives up its references:
+								WeakThis->ReleaseChunkReferences(bSuccess ? PreviousChunkList : ChunkList);
+								if (bSuccess)
+								{
+									WeakThis->UpdateSlotManifest(SlotName, *InSaveData);
+								}
+							}
+							Callback.ExecuteIfBound(SlotName, UserIndex, bSuccess);
+						}
+					);
+				});
+		});
+}
+
+void USaveGameSerializer::ReleaseChunkReferences(const FSaveGameChunkList& ChunkList)
+{
+	const TSharedRef<FSaveGameChunkStore> Store = GetChunkStore();
+	Store->ReleaseReferences(ChunkList);
+	if (NumChunkWritesInFlight == 0)
+	{
+		Store->CollectGarbage();
+	}
+	Store->TrySaveIndex();
+}
+
+TMap<FString, FSaveGameChunkList> USaveGameSerializer::ReadAllChunkLists() const
+{
+	TMap<FString, FSaveGameChunkList> ChunkListsByFile = {};
+	const FString SaveGamesDirectory = FPaths::GetPath(GetSlotFilePath("_"));
+	IFileManager::Get().IterateDirectoryStatRecursively(*SaveGamesDirectory, [&ChunkListsByFile](const TCHAR* FilePath, const FFileStatData& StatData)
+	{
+		if (FSaveGameChunkList ChunkList; !StatData.bIsDirectory && FPaths::GetExtension(FilePath) == TEXT("sav") && TryReadChunkListFile(FilePath, OUT ChunkList))
+		{
+			ChunkListsByFile.Add(FilePath, MoveTemp(ChunkList));
+		}
+		return true;
+	});
+	return ChunkListsByFile;
 }
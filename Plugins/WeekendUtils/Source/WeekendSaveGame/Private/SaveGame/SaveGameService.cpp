@@ -1,4 +1,4 @@
-///////////////////////////////////////////////////////////////////////////////////////
+﻿///////////////////////////////////////////////////////////////////////////////////////
 /// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
 ///
 /// This file is part of the WeekendUtils UE5 Plugin.
@@ -9,12 +9,17 @@
 
 #include "SaveGame/SaveGameService.h"
 
+#include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "GameFramework/SaveGame.h"
+#include "Misc/App.h"
+#include "SaveGame/ModularSaveGame.h"
+#include "SaveGame/SaveGameHeader.h"
 #include "SaveGame/SaveGameSerializer.h"
 #include "SaveGame/SaveGameUtils.h"
 #include "SaveGame/SaveLoadBehavior.h"
 #include "SaveGame/Settings/SaveGameServiceSettings.h"
+#include "WeekendSaveGame.h"
 
 DEFINE_LOG_CATEGORY(LogSaveGameService);
 
@@ -26,7 +31,7 @@ FAsyncSaveGameHandle USaveGameService::RequestAutosave(const FDebugContext& Cont
 		return FAsyncSaveGameHandle();
 	}
 
-	return RequestSaveCurrentSaveGameToSlot(Context, GetAutosaveSlotName());
+	return ScheduleAutosave(Context, MakeShared<FSaveCurrentSaveGameRequest>(*this, Context));
 }
 
 FAsyncSaveGameHandle USaveGameService::RequestAutosave(const FDebugContext& Context, const FOnSaveLoadCompleted& Callback)
@@ -37,42 +42,68 @@ FAsyncSaveGameHandle USaveGameService::RequestAutosave(const FDebugContext& Cont
 		return FAsyncSaveGameHandle();
 	}
 
-	return RequestSaveCurrentSaveGameToSlot(Context, GetAutosaveSlotName(), Callback);
+	return ScheduleAutosave(Context, MakeShared<FSaveCurrentSaveGameRequest>(*this, Context, Callback));
 }
 
 FAsyncSaveGameHandle USaveGameService::RequestSaveCurrentSaveGameToSlot(const FDebugContext& Context, const FSlotName& SlotName)
 {
-	AddDebugEntry("RequestSaveCurrentSaveGameToSlot", Context);
+	AddDebugEntry(FSaveLoadDebugEntry("RequestSaveCurrentSaveGameToSlot", Context, *SlotName));
 	return EnqueueSaveRequest(SlotName, MakeShared<FSaveCurrentSaveGameRequest>(*this, Context));
 }
 
 FAsyncSaveGameHandle USaveGameService::RequestSaveCurrentSaveGameToSlot(const FDebugContext& Context, const FSlotName& SlotName, const FOnSaveLoadCompleted& Callback)
 {
-	AddDebugEntry("RequestSaveCurrentSaveGameToSlot", Context);
+	AddDebugEntry(FSaveLoadDebugEntry("RequestSaveCurrentSaveGameToSlot", Context, *SlotName));
 	return EnqueueSaveRequest(SlotName, MakeShared<FSaveCurrentSaveGameRequest>(*this, Context, Callback));
 }
 
+FAsyncSaveGameHandle USaveGameService::RequestSaveCurrentSaveGameToSlots(const FDebugContext& Context, const TArray<FSlotName>& SlotNames)
+{
+	return RequestSaveCurrentSaveGameToSlots(Context, SlotNames, FOnMultiSlotSaveCompleted());
+}
+
+FAsyncSaveGameHandle USaveGameService::RequestSaveCurrentSaveGameToSlots(const FDebugContext& Context, const TArray<FSlotName>& SlotNames, const FOnMultiSlotSaveCompleted& Callback)
+{
+	AddDebugEntry(FSaveLoadDebugEntry("RequestSaveCurrentSaveGameToSlots", Context, *FString::Join(SlotNames, TEXT("+"))));
+	if (SlotNames.IsEmpty())
+		return FAsyncSaveGameHandle();
+
+	// (i) The request is queued for its first slot, and takes the other slots along when being processed:
+	return EnqueueSaveRequest(SlotNames[0], MakeShared<FSaveCurrentSaveGameToSlotsRequest>(*this, Context, SlotNames, Callback));
+}
+
 FAsyncLoadGameHandle USaveGameService::RequestLoadCurrentSaveGameFromSlot(const FDebugContext& Context, const FSlotName& SlotName)
 {
-	AddDebugEntry("RequestLoadCurrentSaveGameFromSlot", Context);
+	AddDebugEntry(FSaveLoadDebugEntry("RequestLoadCurrentSaveGameFromSlot", Context, *SlotName));
 	return EnqueueLoadRequest(SlotName, MakeShared<FLoadToCurrentSaveGameRequest>(*this, Context, SlotName));
 }
 
 FAsyncLoadGameHandle USaveGameService::RequestLoadCurrentSaveGameFromSlot(const FDebugContext& Context, const FSlotName& SlotName, const FOnSaveLoadCompleted& Callback)
 {
-	AddDebugEntry("RequestLoadCurrentSaveGameFromSlot", Context);
+	AddDebugEntry(FSaveLoadDebugEntry("RequestLoadCurrentSaveGameFromSlot", Context, *SlotName));
 	return EnqueueLoadRequest(SlotName, MakeShared<FLoadToCurrentSaveGameRequest>(*this, Context, Callback, SlotName));
 }
 
 FAsyncLoadGameHandle USaveGameService::RequestLoadAndTravelIntoCurrentSaveGameFromSlot(const FDebugContext& Context, const FSlotName& SlotName)
 {
-	AddDebugEntry("RequestLoadAndTravelIntoCurrentSaveGameFromSlot", Context);
-	return EnqueueLoadRequest(SlotName, MakeShared<FLoadAndTravelIntoToCurrentSaveGameRequest>(*this, Context, SlotName));
+	AddDebugEntry(FSaveLoadDebugEntry("RequestLoadAndTravelIntoCurrentSaveGameFromSlot", Context, *SlotName));
+	const FAsyncLoadGameHandle Handle = EnqueueLoadRequest(SlotName, MakeShared<FLoadAndTravelIntoToCurrentSaveGameRequest>(*this, Context, SlotName));
+	if (Handle.IsValid())
+	{
+		PrefetchTravelDestination(SlotName, Handle);
+	}
+	return Handle;
 }
 
 FAsyncLoadGameHandle USaveGameService::RequestLoadAndTravelIntoCurrentSaveGameFromSlot(const FDebugContext& Context, const FSlotName& SlotName, const FOnSaveLoadCompleted& Callback)
 {
-	return EnqueueLoadRequest(SlotName, MakeShared<FLoadAndTravelIntoToCurrentSaveGameRequest>(*this, Context, Callback, SlotName));
+	AddDebugEntry(FSaveLoadDebugEntry("RequestLoadAndTravelIntoCurrentSaveGameFromSlot", Context, *SlotName));
+	const FAsyncLoadGameHandle Handle = EnqueueLoadRequest(SlotName, MakeShared<FLoadAndTravelIntoToCurrentSaveGameRequest>(*this, Context, Callback, SlotName));
+	if (Handle.IsValid())
+	{
+		PrefetchTravelDestination(SlotName, Handle);
+	}
+	return Handle;
 }
 
 bool USaveGameService::IsSaveRequestAlive(const FAsyncSaveGameHandle& Handle) const
@@ -95,6 +126,12 @@ bool USaveGameService::IsSaveRequestAlive(const FAsyncSaveGameHandle& Handle) co
 			return true;
 	}
 
+	for (const TSharedRef<ISaveLoadRequest>& SaveRequest : DeferredAutosave.Requests)
+	{
+		if (SaveRequest->Handle == Handle)
+			return true;
+	}
+
 	return false;
 }
 
@@ -123,6 +160,17 @@ bool USaveGameService::IsLoadRequestAlive(const FAsyncLoadGameHandle& Handle) co
 
 void USaveGameService::CancelSaveRequest(const FAsyncSaveGameHandle& Handle)
 {
+	const int32 DeferredIndex = DeferredAutosave.Requests.IndexOfByPredicate([&Handle](const TSharedRef<ISaveLoadRequest>& Request)
+	{
+		return (Request->Handle == Handle);
+	});
+	if (DeferredIndex != INDEX_NONE)
+	{
+		DeferredAutosave.Requests[DeferredIndex]->Cancel();
+		DeferredAutosave.Requests.RemoveAt(DeferredIndex);
+		return;
+	}
+
 	for (TTuple<FSlotName, TArray<TSharedRef<ISaveLoadRequest>>>& RequestsBySlotName : PendingSaveRequestsBySlot)
 	{
 		TSharedPtr<ISaveLoadRequest> FoundRequest = nullptr;
@@ -145,6 +193,31 @@ void USaveGameService::CancelSaveRequest(const FAsyncSaveGameHandle& Handle)
 		}
 		return;
 	}
+
+	const int32 InProgressIndex = SaveRequestsInProgress.IndexOfByPredicate([&Handle](const TSharedRef<ISaveLoadRequest>& Request)
+	{
+		return (Request->Handle == Handle);
+	});
+	if (InProgressIndex == INDEX_NONE)
+		return;
+
+	SaveRequestsInProgress[InProgressIndex]->Cancel();
+	SaveRequestsInProgress.RemoveAt(InProgressIndex);
+
+	// Nobody waits for the save in progress anymore -> stop the work that didn't start yet:
+	if (SaveRequestsInProgress.IsEmpty() && SaveCancellationToken.IsValid())
+	{
+		SaveCancellationToken->Cancel();
+
+		// (i) Nothing would notice the cancellation before all contributions are ready -> abort right away and ignore contributions that complete later:
+		if (SlotAwaitingSaveContributions.IsSet())
+		{
+			const FSlotName SlotName = *SlotAwaitingSaveContributions;
+			SlotAwaitingSaveContributions.Reset();
+			PendingSaveContributions.Reset();
+			AbortCancelledSave(SlotName);
+		}
+	}
 }
 
 void USaveGameService::CancelLoadRequest(const FAsyncLoadGameHandle& Handle)
@@ -171,6 +244,23 @@ void USaveGameService::CancelLoadRequest(const FAsyncLoadGameHandle& Handle)
 		}
 		return;
 	}
+
+	const int32 InProgressIndex = LoadRequestsInProgress.IndexOfByPredicate([&Handle](const TSharedRef<ISaveLoadRequest>& Request)
+	{
+		return (Request->Handle == Handle);
+	});
+	if (InProgressIndex == INDEX_NONE)
+		return;
+
+	LoadRequestsInProgress[InProgressIndex]->Cancel();
+	LoadRequestsInProgress.RemoveAt(InProgressIndex);
+
+	// Nobody waits for the load in progress anymore -> discard its result and release the service right away:
+	if (LoadRequestsInProgress.IsEmpty() && LoadCancellationToken.IsValid())
+	{
+		LoadCancellationToken->Cancel();
+		AbortCancelledLoad(LoadMetricsInProgress.SlotName);
+	}
 }
 
 bool USaveGameService::TryLoadCurrentSaveGameFromSlotSynchronous(const FSlotName& SlotName)
@@ -190,9 +280,9 @@ bool USaveGameService::TryLoadCurrentSaveGameFromSlotSynchronous(const FSlotName
 	SetCurrentSaveGame(FCurrentSaveGame::CreateFromLoadedGame(*LoadedSaveGame, SlotName));
 
 	SetStatus(EStatus::Idle);
-	AddDebugEntry("[TryLoadCurrentSaveGameFromSlotSynchronous] " + SlotName);
+	AddDebugEntry(FSaveLoadDebugEntry("TryLoadCurrentSaveGameFromSlotSynchronous", FDebugContext(), *SlotName));
 
-	OnAfterRestored.Broadcast(CurrentSaveGame);
+	BroadcastAfterRestored();
 	return true;
 }
 
@@ -203,7 +293,7 @@ TSet<USaveGame*> USaveGameService::PreloadSaveGamesSynchronous(const TSet<FSlotN
 		return Result;
 
 	SetStatus(EStatus::Loading);
-	AddDebugEntry("[PreloadSaveGamesSynchronous] " + FString::Join(SlotNames, TEXT(", ")));
+	AddDebugEntry("PreloadSaveGamesSynchronous", FString::Join(SlotNames, TEXT(", ")));
 
 	CachedSaveGames.Clear();
 	for (const FSlotName& SlotName : SlotNames)
@@ -257,7 +347,7 @@ void USaveGameService::PreloadSaveGamesAsync(const TSet<FSlotName>& SlotNames, c
 			}
 			if (--(*RemainingSlots) <= 0)
 			{
-				Service.AddDebugEntry("PreloadSaveGamesAsync", "FPreloadRequest::Finish", bSuccess, Runtime);
+				AddFinishDebugEntry("PreloadSaveGamesAsync", bSuccess);
 				Callback.ExecuteIfBound(ResultSaveGames->Array(), ResultSlotNames->Array());
 			}
 		}
@@ -293,17 +383,31 @@ void USaveGameService::RestoreAsCurrentSaveGame(USaveGame& SaveGame, TOptional<F
 {
 	checkf(!IsCachedSaveGameSnapshot(SaveGame), TEXT("Restoring cached SaveGame snapshots is now allowed. Use runtime versions or restore by slot"));
 
-	AddDebugEntry("[RestoreAsCurrentSaveGame]");
+	AddDebugEntry(FSaveLoadDebugEntry("RestoreAsCurrentSaveGame", FDebugContext(), LoadedFromSlotName.IsSet() ? FName(*LoadedFromSlotName) : NAME_None));
 	SetCurrentSaveGame(FCurrentSaveGame::CreateFromLoadedGame(SaveGame, LoadedFromSlotName));
-	OnAfterRestored.Broadcast(CurrentSaveGame);
+	BroadcastAfterRestored();
 }
 
 void USaveGameService::RestoreAsAndTravelIntoCurrentSaveGame(USaveGame& SaveGame, TOptional<FSlotName> LoadedFromSlotName)
 {
 	checkf(!IsCachedSaveGameSnapshot(SaveGame), TEXT("Restoring cached SaveGame snapshots is now allowed. Use runtime versions or restore by slot"));
 
-	RestoreAsCurrentSaveGame(SaveGame, LoadedFromSlotName);
-	TryTravelIntoCurrentSaveGame();
+	const USaveGameServiceSettings& Settings = *GetDefault<USaveGameServiceSettings>();
+	if (!Settings.bOverlapLoadWithTravel)
+	{
+		RestoreAsCurrentSaveGame(SaveGame, LoadedFromSlotName);
+		TryTravelIntoCurrentSaveGame();
+		return;
+	}
+
+	// (i) Restoring into the world that is about to be left is wasted work. Restore once the new world has begun play instead:
+	AddDebugEntry(FSaveLoadDebugEntry("RestoreAsCurrentSaveGameAfterTravel", FDebugContext(), LoadedFromSlotName.IsSet() ? FName(*LoadedFromSlotName) : NAME_None));
+	SetCurrentSaveGame(FCurrentSaveGame::CreateFromLoadedGame(SaveGame, LoadedFromSlotName));
+	bIsRestorePendingAfterTravel = true;
+	if (!TryTravelIntoCurrentSaveGame())
+	{
+		FinishRestoreAfterTravel();
+	}
 }
 
 bool USaveGameService::TryTravelIntoCurrentSaveGame()
@@ -311,31 +415,33 @@ bool USaveGameService::TryTravelIntoCurrentSaveGame()
 	check(SaveLoadBehavior);
 	if (!SaveLoadBehavior->TryTravelToSavedLevel(CurrentSaveGame))
 	{
-		AddDebugEntry("[TryTravelIntoCurrentSaveGame] failed");
+		AddDebugEntry("TryTravelIntoCurrentSaveGame", FDebugContext(), false, 0.0);
 		return false;
 	}
 
-	AddDebugEntry("[TryTravelIntoCurrentSaveGame] succeeded");
+	AddDebugEntry("TryTravelIntoCurrentSaveGame", FDebugContext(), true, 0.0);
 	return true;
 }
 
 void USaveGameService::CreateNewSaveGameAsCurrent()
 {
-	AddDebugEntry("[CreateNewSaveGameAsCurrent]");
+	AddDebugEntry("CreateNewSaveGameAsCurrent");
 	USaveGame& SaveGameObject = SaveLoadBehavior->CreateNewSavegameObject(*this);
 	SetCurrentSaveGame(FCurrentSaveGame::CreateFromNewGame(SaveGameObject));
 }
 
 void USaveGameService::CreateAndRestoreNewSaveGameAsCurrent()
 {
-	AddDebugEntry("[CreateAndRestoreNewSaveGameAsCurrent]");
+	AddDebugEntry("CreateAndRestoreNewSaveGameAsCurrent");
 	USaveGame& SaveGameObject = SaveLoadBehavior->CreateNewSavegameObject(*this);
 	SetCurrentSaveGame(FCurrentSaveGame::CreateFromNewGame(SaveGameObject));
-	OnAfterRestored.Broadcast(CurrentSaveGame);
+	BroadcastAfterRestored();
 }
 
 void USaveGameService::DeleteSaveGameAtSlot(const FSlotName& SlotName, bool bMoveToBackupFolder)
 {
+	// (i) Slots are also decoded speculatively without being cached, and such a decode must not be loaded after deleting:
+	DiscardSpeculativeDecode(SlotName);
 	if (!CachedSaveGames.Contains(SlotName))
 		return;
  
@@ -346,12 +452,14 @@ void USaveGameService::DeleteSaveGameAtSlot(const FSlotName& SlotName, bool bMov
 	}
  
 	CachedSaveGames.Remove(SlotName);
+	ContentHashesBySlot.Remove(SlotName);
+	bMostLikelySlotToLoadDirty = true;
 	OnAvailableSaveGamesChanged.Broadcast();
 }
 
 void USaveGameService::ProcessPendingRequests()
 {
-	if (IsBusySavingOrLoading())
+	if (GetCurrentStatus() == EStatus::Uninitialized || IsBusySavingOrLoading())
 		return;
 
 	///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -366,12 +474,48 @@ void USaveGameService::ProcessPendingRequests()
 	{
 		auto RequestToProcess = PendingSaveRequestsBySlot.CreateIterator();
 		const FSlotName SlotName = RequestToProcess.Key();
+		BeginSaveLoadMetrics(OUT SaveMetricsInProgress, ESaveLoadOperation::Save, SlotName, RequestToProcess.Value());
 		SaveRequestsInProgress += RequestToProcess.Value();
-		for (TSharedRef<ISaveLoadRequest> Request : RequestToProcess.Value())
+		RequestToProcess.RemoveCurrent();
+
+		// Requests that write into multiple slots also complete pending requests of their other slots, since all of them get the same data:
+		SaveSlotsInProgress = { SlotName };
+		SaveResultsBySlot.Reset();
+		for (int32 RequestIndex = 0; RequestIndex < SaveRequestsInProgress.Num(); ++RequestIndex)
+		{
+			for (const FSlotName& AdditionalSlotName : SaveRequestsInProgress[RequestIndex]->AdditionalSlotNames)
+			{
+				if (SaveSlotsInProgress.Contains(AdditionalSlotName))
+					continue;
+
+				SaveSlotsInProgress.Add(AdditionalSlotName);
+				TArray<TSharedRef<ISaveLoadRequest>> MergedRequests;
+				if (PendingSaveRequestsBySlot.RemoveAndCopyValue(AdditionalSlotName, OUT MergedRequests))
+				{
+					SaveRequestsInProgress += MergedRequests;
+				}
+			}
+		}
+
+		// Deferred autosaves are completed as well, when the autosave slot is written anyway:
+		const FSlotName AutosaveSlotName = GetAutosaveSlotName();
+		if (!DeferredAutosave.Requests.IsEmpty() && SaveSlotsInProgress.Contains(AutosaveSlotName))
+		{
+			const double Now = FPlatformTime::Seconds();
+			for (const TSharedRef<ISaveLoadRequest>& Request : DeferredAutosave.Requests)
+			{
+				Request->SlotName = AutosaveSlotName;
+				Request->DeferralTime = (Now - Request->EnqueueTime);
+			}
+			AddDebugEntry(FSaveLoadDebugEntry("MergeDeferredAutosave", FString::Printf(TEXT("%d merged request(s)"), DeferredAutosave.Requests.Num()), *AutosaveSlotName));
+			SaveRequestsInProgress += DeferredAutosave.Requests;
+			DeferredAutosave = FDeferredAutosave();
+		}
+
+		for (TSharedRef<ISaveLoadRequest> Request : SaveRequestsInProgress)
 		{
 			Request->Process();
 		}
-		RequestToProcess.RemoveCurrent();
 
 		PerformAsyncSave(SlotName);
 		return;
@@ -381,6 +525,8 @@ void USaveGameService::ProcessPendingRequests()
 	{
 		auto RequestToProcess = PendingLoadRequestsBySlot.CreateIterator();
 		const FSlotName SlotName = RequestToProcess.Key();
+		const bool bRestoresSnapshot = RequestToProcess.Value().ContainsByPredicate([](const TSharedRef<ISaveLoadRequest>& Request) { return Request->SnapshotHandle.IsSet(); });
+		BeginSaveLoadMetrics(OUT LoadMetricsInProgress, bRestoresSnapshot ? ESaveLoadOperation::RestoreSnapshot : ESaveLoadOperation::Load, SlotName, RequestToProcess.Value());
 		LoadRequestsInProgress += RequestToProcess.Value();
 		for (TSharedRef<ISaveLoadRequest> Request : RequestToProcess.Value())
 		{
@@ -399,7 +545,10 @@ FSaveLoadLockHandle USaveGameService::LockAutosaving(const UObject& KeyHolder, c
 	FSaveLoadLock& NewLock = ActiveAutosaveLocks.Add(NewKey);
 	NewLock.KeyHolder = MakeWeakObjectPtr(&KeyHolder);
 	NewLock.ContextString = Context;
-	AddDebugEntry("LockAutosaving", FString::Printf(TEXT("KeyHolder: %s, Context: %s, Key: %s"), *KeyHolder.GetName(), *Context, *NewKey.ToString()));
+	FSaveLoadDebugEntry DebugEntry("LockAutosaving", Context);
+	DebugEntry.KeyHolder = KeyHolder.GetFName();
+	DebugEntry.Handle = NewKey;
+	AddDebugEntry(MoveTemp(DebugEntry));
 	return NewKey;
 }
 
@@ -409,7 +558,9 @@ void USaveGameService::UnlockAutosaving(const FSaveLoadLockHandle& Key, const FD
 		return;
 
 	ActiveAutosaveLocks.Remove(Key);
-	AddDebugEntry("UnlockAutosaving", FString::Printf(TEXT("Context: %s, Key: %s"), *Context, *Key.ToString()));
+	FSaveLoadDebugEntry DebugEntry("UnlockAutosaving", Context);
+	DebugEntry.Handle = Key;
+	AddDebugEntry(MoveTemp(DebugEntry));
 	ProcessPendingRequests();
 }
 
@@ -419,7 +570,10 @@ FSaveLoadLockHandle USaveGameService::LockSaving(const UObject& KeyHolder, const
 	FSaveLoadLock& NewLock = ActiveSaveLocks.Add(NewKey);
 	NewLock.KeyHolder = MakeWeakObjectPtr(&KeyHolder);
 	NewLock.ContextString = Context;
-	AddDebugEntry("LockSaving", FString::Printf(TEXT("KeyHolder: %s, Context: %s, Key: %s"), *KeyHolder.GetName(), *Context, *NewKey.ToString()));
+	FSaveLoadDebugEntry DebugEntry("LockSaving", Context);
+	DebugEntry.KeyHolder = KeyHolder.GetFName();
+	DebugEntry.Handle = NewKey;
+	AddDebugEntry(MoveTemp(DebugEntry));
 	return NewKey;
 }
 
@@ -429,7 +583,9 @@ void USaveGameService::UnlockSaving(const FSaveLoadLockHandle& Key, const FDebug
 		return;
 
 	ActiveSaveLocks.Remove(Key);
-	AddDebugEntry("UnlockSaving", FString::Printf(TEXT("Context: %s, Key: %s"), *Context, *Key.ToString()));
+	FSaveLoadDebugEntry DebugEntry("UnlockSaving", Context);
+	DebugEntry.Handle = Key;
+	AddDebugEntry(MoveTemp(DebugEntry));
 	ProcessPendingRequests();
 }
 
@@ -439,7 +595,10 @@ FSaveLoadLockHandle USaveGameService::LockLoading(const UObject& KeyHolder, cons
 	FSaveLoadLock& NewLock = ActiveLoadLocks.Add(NewKey);
 	NewLock.KeyHolder = MakeWeakObjectPtr(&KeyHolder);
 	NewLock.ContextString = Context;
-	AddDebugEntry("LockLoading", FString::Printf(TEXT("KeyHolder: %s, Context: %s, Key: %s"), *KeyHolder.GetName(), *Context, *NewKey.ToString()));
+	FSaveLoadDebugEntry DebugEntry("LockLoading", Context);
+	DebugEntry.KeyHolder = KeyHolder.GetFName();
+	DebugEntry.Handle = NewKey;
+	AddDebugEntry(MoveTemp(DebugEntry));
 	return NewKey;
 }
 
@@ -449,10 +608,20 @@ void USaveGameService::UnlockLoading(const FSaveLoadLockHandle& Key, const FDebu
 		return;
 
 	ActiveLoadLocks.Remove(Key);
-	AddDebugEntry("UnlockLoading", FString::Printf(TEXT("Context: %s, Key: %s"), *Context, *Key.ToString()));
+	FSaveLoadDebugEntry DebugEntry("UnlockLoading", Context);
+	DebugEntry.Handle = Key;
+	AddDebugEntry(MoveTemp(DebugEntry));
 	ProcessPendingRequests();
 }
 
+FSaveGameSizeReport USaveGameService::MeasureCurrentSaveGameSize()
+{
+	if (!SaveGameSerializer || !CurrentSaveGame.IsValid())
+		return FSaveGameSizeReport();
+
+	return SaveGameSerializer->MeasureSaveGameSize(CurrentSaveGame.GetRef());
+}
+
 bool USaveGameService::IsAutosavingAllowed() const
 {
 	return (IsSavingAllowed() && ActiveAutosaveLocks.IsEmpty());
@@ -470,7 +639,7 @@ bool USaveGameService::IsLoadingAllowed() const
 
 bool USaveGameService::IsBusyLoading() const
 {
-	return (LoadRequestsInProgress.Num() > 0);
+	return (LoadRequestsInProgress.Num() > 0 || bIsRestorePendingAfterTravel);
 }
 
 bool USaveGameService::IsBusySaving() const
@@ -487,9 +656,21 @@ void USaveGameService::SetCurrentSaveGame(const FCurrentSaveGame& NewCurrentSave
 {
 	OnBeforeCurrentSaveGameChanged.Broadcast(CurrentSaveGame);
 	CurrentSaveGame = NewCurrentSaveGame;
+	UModularSaveGame::InvalidateModuleHandles();
 	OnAfterCurrentSaveGameChanged.Broadcast(CurrentSaveGame);
 }
 
+void USaveGameService::BroadcastAfterRestored()
+{
+	OnAfterRestored.Broadcast(CurrentSaveGame);
+	RestorePipeline.Begin(CurrentSaveGame);
+
+	if (GetDefault<USaveGameServiceSettings>()->RestoreFrameBudget <= 0.0f)
+	{
+		RestorePipeline.Flush();
+	}
+}
+
 USaveLoadBehavior& USaveGameService::CreateSaveLoadBehavior(const USaveGameServiceSettings& Settings)
 {
 	checkf(!SaveLoadBehavior, TEXT("SaveLoadBehavior was already created"));
@@ -549,8 +730,8 @@ USaveGameSerializer& USaveGameService::CreateSaveGameSerializer()
 void USaveGameService::StartService()
 {
 	const USaveGameServiceSettings& Settings = *GetDefault<USaveGameServiceSettings>();
-	DebugHistoryEntriesToKeep = Settings.DebugHistoryEntriesToKeep;
-	DebugHistory.Empty(DebugHistoryEntriesToKeep);
+	DebugHistory.SetCapacity(Settings.DebugHistoryEntriesToKeep);
+	InMemorySnapshots.Configure(Settings.InMemorySnapshotsToKeep, static_cast<int64>(Settings.InMemorySnapshotsBudgetKiB) * 1024);
 
 	SaveLoadBehavior = &CreateSaveLoadBehavior(Settings);
 	SaveGameSerializer = &CreateSaveGameSerializer();
@@ -572,6 +753,11 @@ void USaveGameService::StartService()
 	{
 		HandleLevelChanged(World);
 	});
+
+	if (GEngine)
+	{
+		GEngine->OnTravelFailure().AddUObject(this, &ThisClass::HandleTravelFailure);
+	}
 }
 
 void USaveGameService::ShutdownService()
@@ -588,17 +774,90 @@ void USaveGameService::ShutdownService()
 		SaveLoadBehavior = nullptr;
 	}
 
+	RestorePipeline.Cancel();
+	PendingSaveContributions.Reset();
+	SlotAwaitingSaveContributions.Reset();
 	CurrentSaveGame.Reset();
+	UModularSaveGame::InvalidateModuleHandles();
 	CachedSaveGames.Clear();
+	InMemorySnapshots.Clear();
+	SaveDataInProgress.Reset();
+	ContentHashesBySlot.Empty();
+
+	// (i) Async work that is still in flight must not call back into the shut down service:
+	if (SaveCancellationToken.IsValid())
+	{
+		SaveCancellationToken->Cancel();
+		SaveCancellationToken.Reset();
+	}
+	if (LoadCancellationToken.IsValid())
+	{
+		LoadCancellationToken->Cancel();
+		LoadCancellationToken.Reset();
+	}
+	TArray<FSlotName> SpeculativelyDecodedSlotNames;
+	SpeculativeDecodes.GetKeys(OUT SpeculativelyDecodedSlotNames);
+	for (const FSlotName& SlotName : SpeculativelyDecodedSlotNames)
+	{
+		DiscardSpeculativeDecode(SlotName);
+	}
+	SpeculativeDecodeFocus.Reset();
+	MostLikelySlotToLoad.Reset();
+	bMostLikelySlotToLoadDirty = true;
+	ReleaseTravelPrefetch();
+	bIsRestorePendingAfterTravel = false;
+
+	// (i) Saves in progress won't complete anymore -> let their requesters know, before anything they request in response gets dropped below:
+	SaveResultsBySlot.Reset();
+	ConsumeSaveRequestsInProgress(nullptr, false);
 
 	PendingSaveRequestsBySlot.Empty();
 	PendingLoadRequestsBySlot.Empty();
+	SaveSlotsInProgress.Reset();
+	DeferredAutosave = FDeferredAutosave();
 
 	FWorldDelegates::OnPostWorldInitialization.RemoveAll(this);
+	if (GEngine)
+	{
+		GEngine->OnTravelFailure().RemoveAll(this);
+	}
+}
+
+bool USaveGameService::IsTickable() const
+{
+	const USaveGameServiceSettings& Settings = *GetDefault<USaveGameServiceSettings>();
+	return (Settings.AutosaveMaxDeferral > 0.0f || Settings.bSpeculativeDecode || RestorePipeline.IsRunning() || SlotAwaitingSaveContributions.IsSet()
+		|| (Settings.WriteBandwidthWhileStreamingKiB > 0 && GetCurrentStatus() == EStatus::Saving));
+}
+
+void USaveGameService::TickService(float DeltaTime)
+{
+	// (i) Use the real frame time (unaffected by pause and time dilation), smoothed to ignore single hitches:
+	SmoothedFrameTime = FMath::Lerp(SmoothedFrameTime, static_cast<float>(FApp::GetDeltaTime()), 0.1f);
+
+	if (RestorePipeline.IsRunning())
+	{
+		RestorePipeline.Process(GetDefault<USaveGameServiceSettings>()->RestoreFrameBudget / 1000.0);
+	}
+
+	UpdatePendingSaveContributions();
+	if (GetCurrentStatus() == EStatus::Saving)
+	{
+		UpdateWriteThrottle();
+	}
+
+	UpdateDeferredAutosave();
+	UpdateSpeculativeDecodes();
 }
 
 FAsyncSaveGameHandle USaveGameService::EnqueueSaveRequest(const FSlotName& SlotName, const TSharedRef<ISaveLoadRequest>& Request, bool bCancelIfSavingIsNotAllowed)
 {
+	// (i) Requests only learn about their slot here, which is needed to report their own result when merged with others:
+	if (!Request->SlotName.IsSet())
+	{
+		Request->SlotName = SlotName;
+	}
+
 	if (!IsSavingAllowed() && bCancelIfSavingIsNotAllowed)
 	{
 		UE_LOG(LogSaveGameService, Log, TEXT("Save request ignored, because saving is not allowed."));
@@ -613,12 +872,24 @@ FAsyncSaveGameHandle USaveGameService::EnqueueSaveRequest(const FSlotName& SlotN
 
 void USaveGameService::ConsumeSaveRequestsInProgress(USaveGame* SavedSaveGame, bool bSuccess)
 {
-	for (const TSharedRef<ISaveLoadRequest>& SaveRequest : SaveRequestsInProgress)
+	// (i) Moved out first, since finished requests may cancel other requests in progress:
+	const TArray<TSharedRef<ISaveLoadRequest>> FinishedRequests = MoveTemp(SaveRequestsInProgress);
+	SaveRequestsInProgress.Empty();
+	for (const TSharedRef<ISaveLoadRequest>& SaveRequest : FinishedRequests)
 	{
-		SaveRequest->Finish(SavedSaveGame, bSuccess);
+		// (i) Requests only fail for the slots they wanted to save to:
+		bool bRequestSuccess = bSuccess;
+		if (SaveRequest->SlotName.IsSet() && SaveResultsBySlot.Contains(*SaveRequest->SlotName))
+		{
+			bRequestSuccess = SaveResultsBySlot[*SaveRequest->SlotName];
+			for (const FSlotName& AdditionalSlotName : SaveRequest->AdditionalSlotNames)
+			{
+				const bool* bSlotSuccess = SaveResultsBySlot.Find(AdditionalSlotName);
+				bRequestSuccess &= (bSlotSuccess ? *bSlotSuccess : bSuccess);
+			}
+		}
+		SaveRequest->Finish(SavedSaveGame, bRequestSuccess);
 	}
-
-	SaveRequestsInProgress.Empty();
 }
 
 FAsyncLoadGameHandle USaveGameService::EnqueueLoadRequest(const FSlotName& SlotName, const TSharedRef<ISaveLoadRequest>& Request, bool bCancelIfLoadingIsNotAllowed)
@@ -629,10 +900,22 @@ FAsyncLoadGameHandle USaveGameService::EnqueueLoadRequest(const FSlotName& SlotN
 		return FAsyncLoadGameHandle();
 	}
 
-	if (CachedSaveGames.Contains(SlotName))
+	// (i) Restoring a snapshot has to decode the snapshot, which may differ from the cached or speculatively decoded content of its slot:
+	if (Request->SnapshotHandle.IsSet())
+	{
+		PendingLoadRequestsBySlot.FindOrAdd(SlotName).Emplace(Request);
+		ProcessPendingRequests();
+	}
+	else if (CachedSaveGames.Contains(SlotName))
 	{
 		Request->Finish(CachedSaveGames.CopyFromCache(*this, SlotName), true);
 	}
+	else if (USaveGame* DecodedSaveGame = TakeSpeculativeDecode(SlotName))
+	{
+		CachedSaveGames.CopyToCache(*this, SlotName, *DecodedSaveGame);
+		OnAvailableSaveGamesChanged.Broadcast();
+		Request->Finish(DecodedSaveGame, true);
+	}
 	else
 	{
 		PendingLoadRequestsBySlot.FindOrAdd(SlotName).Emplace(Request);
@@ -644,150 +927,972 @@ FAsyncLoadGameHandle USaveGameService::EnqueueLoadRequest(const FSlotName& SlotN
 
 void USaveGameService::ConsumeLoadRequestsInProgress(USaveGame* LoadedSaveGame, bool bSuccess)
 {
-	for (const TSharedRef<ISaveLoadRequest>& LoadRequest : LoadRequestsInProgress)
+	// (i) Moved out first, since finished requests may cancel other requests in progress:
+	const TArray<TSharedRef<ISaveLoadRequest>> FinishedRequests = MoveTemp(LoadRequestsInProgress);
+	LoadRequestsInProgress.Empty();
+	for (const TSharedRef<ISaveLoadRequest>& LoadRequest : FinishedRequests)
 	{
 		LoadRequest->Finish(LoadedSaveGame, bSuccess);
 	}
-
-	LoadRequestsInProgress.Empty();
-}
-
-USaveGameService::FSlotName USaveGameService::GetAutosaveSlotName() const
-{
-	ensure(SaveLoadBehavior);
-	return (SaveLoadBehavior ? SaveLoadBehavior->GetAutosaveSlotName(GetCurrentSaveGame()) : FSlotName());
 }
 
-TOptional<USaveGameService::FSlotName> USaveGameService::GetMostRecentlySavedSlotName() const
+FAsyncSaveGameHandle USaveGameService::ScheduleAutosave(const FDebugContext& Context, const TSharedRef<ISaveLoadRequest>& Request)
 {
-	return CurrentSaveGame.GetSlotLastSavedTo();
-}
+	const FSlotName SlotName = GetAutosaveSlotName();
+	if (GetDefault<USaveGameServiceSettings>()->AutosaveMaxDeferral <= 0.0f)
+	{
+		AddDebugEntry(FSaveLoadDebugEntry("RequestSaveCurrentSaveGameToSlot", Context, *SlotName));
+		return EnqueueSaveRequest(SlotName, Request);
+	}
 
-const USaveGame* USaveGameService::GetCachedSaveGameSnapshotAtSlot(const FSlotName& SlotName) const
-{
-	return CachedSaveGames.Find(SlotName);
+	// (i) Repeated requests are merged into the already deferred autosave, which restarts its debounce time:
+	AddDebugEntry(FSaveLoadDebugEntry("DeferAutosave", Context, *SlotName));
+	const double Now = FPlatformTime::Seconds();
+	if (DeferredAutosave.Requests.IsEmpty())
+	{
+		DeferredAutosave.FirstRequestTime = Now;
+	}
+	DeferredAutosave.LastRequestTime = Now;
+	DeferredAutosave.Requests.Add(Request);
+	return Request->Handle;
 }
 
-TMap<USaveGameService::FSlotName, const USaveGame*> USaveGameService::GetAllCachedSaveGameSnapshots() const
+void USaveGameService::UpdateDeferredAutosave()
 {
-	return CachedSaveGames.GetAllObjectsBySlot();
-}
+	if (DeferredAutosave.Requests.IsEmpty() || IsBusySavingOrLoading())
+		return;
 
-bool USaveGameService::IsCachedSaveGameSnapshot(const USaveGame& SaveGameObject) const
-{
-	return CachedSaveGames.GetAllObjectsBySlot().FindKey(&SaveGameObject) != nullptr;
-}
+	const USaveGameServiceSettings& Settings = *GetDefault<USaveGameServiceSettings>();
+	const double Now = FPlatformTime::Seconds();
+	if (Now - DeferredAutosave.FirstRequestTime >= Settings.AutosaveMaxDeferral)
+	{
+		ExecuteDeferredAutosave("Max deferral reached");
+		return;
+	}
 
-bool USaveGameService::HasAnyCachedSaveGameSnapshot() const
-{
-	return GetAllCachedSaveGameSnapshots().Num() > 0;
-}
+	if (Now - DeferredAutosave.LastRequestTime < Settings.AutosaveDebounceTime || !IsAutosavingAllowed())
+		return;
 
-bool USaveGameService::DoesSaveFileExist(const FSlotName& SlotName) const
-{
-	return (SaveGameSerializer && SaveGameSerializer->DoesSaveGameExist(SlotName, GetCurrentUserIndex()));
+	FString Reason;
+	if (SaveLoadBehavior && SaveLoadBehavior->IsLowLoadMomentForAutosave(*this, SmoothedFrameTime, OUT Reason))
+	{
+		ExecuteDeferredAutosave(Reason);
+	}
 }
 
-TSet<USaveGameService::FSlotName> USaveGameService::GetSlotNamesAllowedForSaving() const
+void USaveGameService::ExecuteDeferredAutosave(const FString& Reason)
 {
-	return SaveLoadBehavior->GetSaveSlotNamesAllowedForSaving(GetCurrentSaveGame());
-}
+	const double Now = FPlatformTime::Seconds();
+	const double DeferralTime = (Now - DeferredAutosave.FirstRequestTime);
+	const TArray<TSharedRef<ISaveLoadRequest>> Requests = MoveTemp(DeferredAutosave.Requests);
+	DeferredAutosave = FDeferredAutosave();
 
-TSet<USaveGameService::FSlotName> USaveGameService::GetSlotNamesAllowedForLoading() const
-{
-	if (!IsLoadingAllowed())
-		return {};
+	const FString Report = FString::Printf(TEXT("%s after %.2fs deferral, %d merged request(s)"), *Reason, DeferralTime, Requests.Num());
+	AddDebugEntry(FSaveLoadDebugEntry("ExecuteDeferredAutosave", Report, *GetAutosaveSlotName()));
 
-	TSet<FSlotName> Result = {};
-	for (const FSlotName& SlotName : SaveLoadBehavior->GetSaveSlotNamesAllowedForLoading(GetCurrentSaveGame()))
+	if (!IsAutosavingAllowed())
 	{
-		// Check if file exists and if the preloaded savegame is loadable:
-		if (DoesSaveFileExist(SlotName) && CachedSaveGames.Contains(SlotName))
+		UE_LOG(LogSaveGameService, Log, TEXT("Deferred autosave cancelled, because autosaving is not allowed. (%s)"), *Report);
+		for (const TSharedRef<ISaveLoadRequest>& Request : Requests)
 		{
-			Result.Add(SlotName);
+			Request->Finish(nullptr, false);
 		}
+		return;
 	}
 
-	return Result;
+	UE_LOG(LogSaveGameService, Log, TEXT("Executing deferred autosave: %s"), *Report);
+
+	// (i) Enqueue all merged requests at once, so they are processed by a single save:
+	const FSlotName AutosaveSlotName = GetAutosaveSlotName();
+	TArray<TSharedRef<ISaveLoadRequest>>& PendingRequests = PendingSaveRequestsBySlot.FindOrAdd(AutosaveSlotName);
+	for (const TSharedRef<ISaveLoadRequest>& Request : Requests)
+	{
+		Request->SlotName = AutosaveSlotName;
+		Request->DeferralTime = (Now - Request->EnqueueTime);
+		Request->EnqueueTime = Now;
+		PendingRequests.Add(Request);
+	}
+	ProcessPendingRequests();
 }
 
-void USaveGameService::PerformAsyncSave(const FSlotName& SlotName)
+void USaveGameService::UpdateSpeculativeDecodes()
 {
-	const int32& UserIndex = GetCurrentUserIndex();
-	if (!CurrentSaveGame.IsValid())
+	if (!GetDefault<USaveGameServiceSettings>()->bSpeculativeDecode || !SaveLoadBehavior || !SaveGameSerializer)
+		return;
+
+	// (i) Decoding ahead of time is wasted where nothing is likely to be loaded (e.g. during gameplay), so results are not kept either:
+	if (!SaveLoadBehavior->ShouldSpeculativelyDecode(*this))
 	{
-		HandleAsyncSaveCompleted(SlotName, UserIndex, false);
+		TArray<FSlotName> SpeculativelyDecodedSlotNames;
+		SpeculativeDecodes.GetKeys(OUT SpeculativelyDecodedSlotNames);
+		for (const FSlotName& SlotName : SpeculativelyDecodedSlotNames)
+		{
+			DiscardSpeculativeDecode(SlotName);
+		}
+		bMostLikelySlotToLoadDirty = true;
 		return;
 	}
 
-	SetStatus(EStatus::Saving);
-
-	// Last chance to populate the save game with data:
-	OnBeforeSaved.Broadcast(CurrentSaveGame);
+	if (bMostLikelySlotToLoadDirty)
+	{
+		bMostLikelySlotToLoadDirty = false;
+		MostLikelySlotToLoad = SaveLoadBehavior->FindMostLikelySlotToLoad(*this);
 
-	SaveGameSerializer->AsyncSaveGameToSlot(CurrentSaveGame.GetRef(), SlotName, UserIndex,
-		USaveGameSerializer::FOnAsyncSaveCompleted::CreateUObject(this, &ThisClass::HandleAsyncSaveCompleted));
-}
+		// (i) Also forget failed and consumed attempts, so they are tried again:
+		for (auto Itr = SpeculativeDecodes.CreateIterator(); Itr; ++Itr)
+		{
+			if (!Itr.Value().SaveGame.IsValid() && !Itr.Value().CancellationToken.IsValid())
+			{
+				Itr.RemoveCurrent();
+			}
+		}
+	}
 
-void USaveGameService::HandleAsyncSaveCompleted(const FSlotName& SlotName, const int32 UserIndex, bool bSuccess)
-{
-	CurrentSaveGame.UpdateTimeOfLastSave();
-	CurrentSaveGame.SetSlotLastSavedTo(SlotName);
+	TArray<FSlotName, TInlineAllocator<2>> WantedSlotNames;
+	if (MostLikelySlotToLoad.IsSet())
+	{
+		WantedSlotNames.Add(*MostLikelySlotToLoad);
+	}
+	if (SpeculativeDecodeFocus.IsSet())
+	{
+		WantedSlotNames.AddUnique(*SpeculativeDecodeFocus);
+	}
 
-	// Cache current save game as snapshot copy, so it can be restored as the state it was saved in:
-	CachedSaveGames.CopyToCache(*this, SlotName, CurrentSaveGame.GetRef());
-	OnAvailableSaveGamesChanged.Broadcast();
+	// Discard results that are not wanted anymore, e.g. when the player moved the focus to another slot:
+	TArray<FSlotName> UnwantedSlotNames;
+	for (const TTuple<FSlotName, FSpeculativeDecode>& SlotAndDecode : SpeculativeDecodes)
+	{
+		if (!WantedSlotNames.Contains(SlotAndDecode.Key))
+		{
+			UnwantedSlotNames.Add(SlotAndDecode.Key);
+		}
+	}
+	for (const FSlotName& SlotName : UnwantedSlotNames)
+	{
+		DiscardSpeculativeDecode(SlotName);
+	}
 
-	ConsumeSaveRequestsInProgress(CurrentSaveGame.GetMutablePtr(), bSuccess);
-	SetStatus(EStatus::Idle);
+	// (i) Only start new work when there is nothing else to do, so actual requests are never delayed by it:
+	if (CurrentStatus != EStatus::Idle || !PendingSaveRequestsBySlot.IsEmpty() || !PendingLoadRequestsBySlot.IsEmpty())
+		return;
 
-	OnAfterSaved.Broadcast(CurrentSaveGame);
+	for (const FSlotName& SlotName : WantedSlotNames)
+	{
+		if (SpeculativeDecodes.Contains(SlotName) || CachedSaveGames.Contains(SlotName))
+			continue;
 
-	ProcessPendingRequests();
+		StartSpeculativeDecode(SlotName);
+		return; // One at a time.
+	}
 }
 
-void USaveGameService::PerformAsyncLoad(const FSlotName& SlotName)
+void USaveGameService::StartSpeculativeDecode(const FSlotName& SlotName)
 {
+	// (i) Adding the entry first also marks the attempt, so it won't be retried when the file doesn't exist or exceeds the budget.
+	const FSaveLoadCancellationTokenPtr CancellationToken = MakeShared<FSaveLoadCancellationToken, ESPMode::ThreadSafe>();
+	SpeculativeDecodes.Add(SlotName).CancellationToken = CancellationToken;
 	if (!DoesSaveFileExist(SlotName))
+	{
+		SpeculativeDecodes[SlotName].CancellationToken.Reset();
 		return;
+	}
 
-	SetStatus(EStatus::Loading);
+	AddDebugEntry(FSaveLoadDebugEntry("StartSpeculativeDecode", FDebugContext(), *SlotName));
+	SaveGameSerializer->AsyncLoadDataFromSlot(SlotName, GetCurrentUserIndex(), USaveGameSerializer::FOnAsyncLoadDataCompleted::CreateWeakLambda(this,
+		[this, CancellationToken](const FSlotName& ResultSlotName, const int32 ResultUserIndex, bool bSuccess, const TArray<uint8>& SaveData)
+		{
+			FSpeculativeDecode* Decode = SpeculativeDecodes.Find(ResultSlotName);
+			if (CancellationToken->IsCancelled() || !Decode || Decode->CancellationToken != CancellationToken)
+				return;
 
-	const int32& UserIndex = GetCurrentUserIndex();
-	SaveGameSerializer->AsyncLoadGameFromSlot(SlotName, UserIndex,
-		USaveGameSerializer::FOnAsyncLoadCompleted::CreateUObject(this, &ThisClass::HandleAsyncLoadCompleted));
+			const int64 BudgetBytes = static_cast<int64>(GetDefault<USaveGameServiceSettings>()->SpeculativeDecodeBudgetKiB) * 1024;
+			if (!bSuccess || !SaveGameSerializer || GetSpeculativeDecodesNumBytes() + SaveData.Num() > BudgetBytes)
+			{
+				UE_LOG(LogSaveGameService, Verbose, TEXT("Speculative decode of slot %s skipped (%d bytes)"), *ResultSlotName, SaveData.Num());
+				Decode->CancellationToken.Reset();
+				return;
+			}
+
+			// (i) Referenced assets are preloaded as well, so the token stays valid (= in flight) until the decode is done:
+			SaveGameSerializer->AsyncDeserializeSaveGame(SaveData, USaveGameSerializer::FOnAsyncDeserializeCompleted::CreateWeakLambda(this,
+				[this, CancellationToken, ResultSlotName, NumBytes = SaveData.Num()](USaveGame* DecodedSaveGame)
+				{
+					FSpeculativeDecode* Decode = SpeculativeDecodes.Find(ResultSlotName);
+					if (CancellationToken->IsCancelled() || !Decode || Decode->CancellationToken != CancellationToken)
+						return;
+
+					Decode->CancellationToken.Reset();
+					if (DecodedSaveGame)
+					{
+						Decode->SaveGame = TStrongObjectPtr<USaveGame>(DecodedSaveGame);
+						Decode->NumBytes = NumBytes;
+					}
+				}), CancellationToken);
+		}), CancellationToken, ESaveGameIOPriority::Low);
 }
 
-USaveGame* USaveGameService::PerformSyncLoad(const FSlotName& SlotName)
+void USaveGameService::DiscardSpeculativeDecode(const FSlotName& SlotName)
 {
-	const int32 UserIndex = GetCurrentUserIndex();
+	FSpeculativeDecode Decode;
+	if (!SpeculativeDecodes.RemoveAndCopyValue(SlotName, OUT Decode))
+		return;
 
-	USaveGame* LoadedSaveGame = nullptr;
-	SaveGameSerializer->TryLoadGameFromSlot(SlotName, UserIndex, OUT LoadedSaveGame);
-	if (LoadedSaveGame && !CachedSaveGames.Contains(SlotName))
+	if (Decode.CancellationToken.IsValid())
 	{
-		CachedSaveGames.CopyToCache(*this, SlotName, *LoadedSaveGame);
-		OnAvailableSaveGamesChanged.Broadcast();
+		Decode.CancellationToken->Cancel();
+	}
+	if (Decode.SaveGame.IsValid())
+	{
+		AddDebugEntry(FSaveLoadDebugEntry("DiscardSpeculativeDecode", FDebugContext(), *SlotName));
 	}
-
-	return LoadedSaveGame;
 }
 
-void USaveGameService::HandleAsyncLoadCompleted(const FSlotName& SlotName, const int32 UserIndex, USaveGame* LoadedSaveGame)
+USaveGame* USaveGameService::TakeSpeculativeDecode(const FSlotName& SlotName)
 {
-	UE_CLOG(!IsValid(LoadedSaveGame), LogSaveGameService, Log, TEXT("AsyncLoad of SaveGame in slot %s failed."), *SlotName);
-	if (IsValid(LoadedSaveGame) && !CachedSaveGames.Contains(SlotName))
-	{
+	FSpeculativeDecode* Decode = SpeculativeDecodes.Find(SlotName);
+	if (!Decode)
+		return nullptr;
+
+	// (i) A decode still in flight is dropped in favor of the actual load. The remaining entry prevents decoding the slot again.
+	if (Decode->CancellationToken.IsValid())
+	{
+		Decode->CancellationToken->Cancel();
+		Decode->CancellationToken.Reset();
+	}
+
+	USaveGame* DecodedSaveGame = Decode->SaveGame.Get();
+	Decode->SaveGame.Reset();
+	Decode->NumBytes = 0;
+	if (DecodedSaveGame)
+	{
+		AddDebugEntry(FSaveLoadDebugEntry("TakeSpeculativeDecode", FDebugContext(), *SlotName));
+	}
+	return DecodedSaveGame;
+}
+
+int64 USaveGameService::GetSpeculativeDecodesNumBytes() const
+{
+	int64 NumBytes = 0;
+	for (const TTuple<FSlotName, FSpeculativeDecode>& SlotAndDecode : SpeculativeDecodes)
+	{
+		NumBytes += SlotAndDecode.Value.NumBytes;
+	}
+	return NumBytes;
+}
+
+void USaveGameService::PrefetchTravelDestination(const FSlotName& SlotName, const FAsyncLoadGameHandle& LoadHandle)
+{
+	const USaveGameServiceSettings& Settings = *GetDefault<USaveGameServiceSettings>();
+	if (!Settings.bOverlapLoadWithTravel || !SaveGameSerializer || !IsLoadRequestAlive(LoadHandle))
+		return;
+
+	// (i) The header is cheap to read and already tells which level we are going to travel to.
+	// It is read with high priority, because the level prefetch can only start once it is known:
+	SaveGameSerializer->AsyncReadSlotHeader(SlotName, GetCurrentUserIndex(), USaveGameSerializer::FOnAsyncReadSlotHeaderCompleted::CreateWeakLambda(this,
+		[this, LoadHandle](const FSlotName& HeaderSlotName, bool bSuccess, const FSaveGameSlotManifestEntry& HeaderEntry)
+		{
+			// (i) Once the load completed, travel is on its way (or already done) and would never pick the prefetched level up:
+			if (bSuccess && IsLoadRequestAlive(LoadHandle))
+			{
+				PrefetchTravelDestinationLevel(HeaderSlotName, HeaderEntry);
+			}
+		}), ESaveGameIOPriority::High);
+}
+
+void USaveGameService::PrefetchTravelDestinationLevel(const FSlotName& SlotName, const FSaveGameSlotManifestEntry& HeaderEntry)
+{
+	const FSimpleSaveGameHeaderData* HeaderData = HeaderEntry.GetCustomHeaderData<FSimpleSaveGameHeaderData>();
+	if (!HeaderData || !HeaderData->LoadedLevel.IsValid())
+		return;
+
+	const FSoftObjectPath Level = HeaderData->LoadedLevel;
+	if (TravelPrefetch.IsSet() && TravelPrefetch->Level == Level)
+		return;
+
+	ReleaseTravelPrefetch();
+	TravelPrefetch = FTravelPrefetch();
+	TravelPrefetch->Level = Level;
+	TravelPrefetch->StartTime = FPlatformTime::Seconds();
+	AddDebugEntry(FSaveLoadDebugEntry("PrefetchTravelDestination", FDebugContext(), *SlotName));
+
+	// (i) The level is loaded on the async loading thread, while the SaveGame is read and decoded. OpenLevel then finds it in memory:
+	LoadPackageAsync(Level.GetLongPackageName(), FLoadPackageAsyncDelegate::CreateWeakLambda(this,
+		[this, Level](const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+		{
+			if (!TravelPrefetch.IsSet() || TravelPrefetch->Level != Level)
+				return; // Prefetch was released in the meantime.
+
+			if (Result != EAsyncLoadingResult::Succeeded || !LoadedPackage)
+			{
+				UE_LOG(LogSaveGameService, Warning, TEXT("Failed to prefetch level %s. It will be loaded during travel instead."), *PackageName.ToString());
+				TravelPrefetch.Reset();
+				return;
+			}
+
+			TravelPrefetch->Package.Reset(LoadedPackage);
+			UE_LOG(LogSaveGameService, Log, TEXT("Prefetched level %s for travel in %.3fs."), *PackageName.ToString(), FPlatformTime::Seconds() - TravelPrefetch->StartTime);
+		}));
+}
+
+void USaveGameService::ReleaseTravelPrefetch()
+{
+	TravelPrefetch.Reset();
+}
+
+void USaveGameService::HandleTravelDestinationInitialized(UWorld& NewWorld)
+{
+	// (i) The new world references its level package itself from now on:
+	ReleaseTravelPrefetch();
+
+	if (NewWorld.HasBegunPlay())
+	{
+		FinishRestoreAfterTravel();
+		return;
+	}
+
+	// (i) Not bound to this object, because the world transition locks remove all of our BeginPlay bindings when unlocking:
+	NewWorld.OnWorldBeginPlay.AddLambda([WeakThis = TWeakObjectPtr<USaveGameService>(this)]()
+	{
+		if (WeakThis.IsValid())
+		{
+			WeakThis->FinishRestoreAfterTravel();
+		}
+	});
+}
+
+void USaveGameService::HandleTravelFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString)
+{
+	ReleaseTravelPrefetch();
+	if (!bIsRestorePendingAfterTravel)
+		return;
+
+	UE_LOG(LogSaveGameService, Warning, TEXT("Travel into loaded SaveGame failed (%s). Restoring it into the current world instead."), *ErrorString);
+	FinishRestoreAfterTravel();
+}
+
+void USaveGameService::FinishRestoreAfterTravel()
+{
+	if (!bIsRestorePendingAfterTravel)
+		return;
+
+	bIsRestorePendingAfterTravel = false;
+	AddDebugEntry("FinishRestoreAfterTravel");
+	BroadcastAfterRestored();
+
+	// (i) Requests that arrived while the restore was pending have been waiting for it:
+	ProcessPendingRequests();
+}
+
+USaveGameService::FSlotName USaveGameService::GetAutosaveSlotName() const
+{
+	ensure(SaveLoadBehavior);
+	return (SaveLoadBehavior ? SaveLoadBehavior->GetAutosaveSlotName(GetCurrentSaveGame()) : FSlotName());
+}
+
+TOptional<USaveGameService::FSlotName> USaveGameService::GetMostRecentlySavedSlotName() const
+{
+	return CurrentSaveGame.GetSlotLastSavedTo();
+}
+
+const USaveGame* USaveGameService::GetCachedSaveGameSnapshotAtSlot(const FSlotName& SlotName) const
+{
+	return CachedSaveGames.Find(SlotName);
+}
+
+TMap<USaveGameService::FSlotName, const USaveGame*> USaveGameService::GetAllCachedSaveGameSnapshots() const
+{
+	return CachedSaveGames.GetAllObjectsBySlot();
+}
+
+bool USaveGameService::IsCachedSaveGameSnapshot(const USaveGame& SaveGameObject) const
+{
+	return CachedSaveGames.GetAllObjectsBySlot().FindKey(&SaveGameObject) != nullptr;
+}
+
+bool USaveGameService::HasAnyCachedSaveGameSnapshot() const
+{
+	return GetAllCachedSaveGameSnapshots().Num() > 0;
+}
+
+TArray<FSaveGameSnapshotHandle> USaveGameService::GetInMemorySnapshotHandles() const
+{
+	return InMemorySnapshots.GetHandles();
+}
+
+const FSaveGameSnapshot* USaveGameService::FindInMemorySnapshot(const FSaveGameSnapshotHandle& Handle) const
+{
+	return InMemorySnapshots.Find(Handle);
+}
+
+bool USaveGameService::TryRestoreInMemorySnapshot(const FSaveGameSnapshotHandle& Handle, const FDebugContext& Context, const FOnSaveLoadCompleted& Callback)
+{
+	const FSaveGameSnapshot* Snapshot = InMemorySnapshots.Find(Handle);
+	if (!Snapshot || !IsLoadingAllowed())
+		return false;
+
+	const FSlotName SlotName = Snapshot->SlotName;
+	AddDebugEntry(FSaveLoadDebugEntry("TryRestoreInMemorySnapshot", Context, *SlotName));
+	const TSharedRef<ISaveLoadRequest> Request = MakeShared<FLoadToCurrentSaveGameRequest>(*this, Context, Callback, SlotName);
+	Request->SnapshotHandle = Handle;
+	return EnqueueLoadRequest(SlotName, Request).IsValid();
+}
+
+bool USaveGameService::TryRestoreMostRecentInMemorySnapshot(const FDebugContext& Context, const FOnSaveLoadCompleted& Callback)
+{
+	const FSaveGameSnapshot* Snapshot = InMemorySnapshots.FindMostRecent();
+	return (Snapshot && TryRestoreInMemorySnapshot(Snapshot->Handle, Context, Callback));
+}
+
+void USaveGameService::SetSpeculativeDecodeFocus(const TOptional<FSlotName>& SlotName)
+{
+	SpeculativeDecodeFocus = SlotName;
+}
+
+bool USaveGameService::HasSpeculativeDecode(const FSlotName& SlotName) const
+{
+	const FSpeculativeDecode* Decode = SpeculativeDecodes.Find(SlotName);
+	return (Decode && Decode->SaveGame.IsValid());
+}
+
+bool USaveGameService::DoesSaveFileExist(const FSlotName& SlotName) const
+{
+	return (SaveGameSerializer && SaveGameSerializer->DoesSaveGameExist(SlotName, GetCurrentUserIndex()));
+}
+
+TMap<USaveGameService::FSlotName, FSaveGameSlotManifestEntry> USaveGameService::GetSaveGameSlotHeaders(const TSet<FSlotName>& SlotNames) const
+{
+	if (!SaveGameSerializer)
+		return {};
+
+	return SaveGameSerializer->ReadSlotHeaders(SlotNames, GetCurrentUserIndex());
+}
+
+TSet<USaveGameService::FSlotName> USaveGameService::GetSlotNamesAllowedForSaving() const
+{
+	return SaveLoadBehavior->GetSaveSlotNamesAllowedForSaving(GetCurrentSaveGame());
+}
+
+TSet<USaveGameService::FSlotName> USaveGameService::GetSlotNamesAllowedForLoading() const
+{
+	if (!IsLoadingAllowed())
+		return {};
+
+	TSet<FSlotName> Result = {};
+	for (const FSlotName& SlotName : SaveLoadBehavior->GetSaveSlotNamesAllowedForLoading(GetCurrentSaveGame()))
+	{
+		// Check if file exists and if the preloaded savegame is loadable:
+		if (DoesSaveFileExist(SlotName) && CachedSaveGames.Contains(SlotName))
+		{
+			Result.Add(SlotName);
+		}
+	}
+
+	return Result;
+}
+
+void USaveGameService::PerformAsyncSave(const FSlotName& SlotName)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("USaveGameService.PerformAsyncSave"), STAT_SaveGameService_PerformAsyncSave, STATGROUP_SaveGame);
+
+	const int32& UserIndex = GetCurrentUserIndex();
+	if (!CurrentSaveGame.IsValid())
+	{
+		HandleAsyncSaveCompleted(SlotName, UserIndex, false);
+		return;
+	}
+
+	SetStatus(EStatus::Saving);
+	SaveCancellationToken = MakeShared<FSaveLoadCancellationToken, ESPMode::ThreadSafe>();
+
+	// Last chance to populate the save game with data (listeners that were not restored yet would save outdated data):
+	double PhaseStartTime = FPlatformTime::Seconds();
+	RestorePipeline.Flush();
+	OnBeforeSaved.Broadcast(CurrentSaveGame);
+	const bool bHasPendingContributions = StartSaveContributions();
+	SaveMetricsInProgress.SetPhaseTime(ESaveLoadPhase::Capture, FPlatformTime::Seconds() - PhaseStartTime);
+	if (bHasPendingContributions)
+	{
+		// (i) Continued from TickService, once all contributions are ready:
+		SlotAwaitingSaveContributions = SlotName;
+		return;
+	}
+
+	ContinueAsyncSave(SlotName);
+}
+
+void USaveGameService::ContinueAsyncSave(const FSlotName& SlotName)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("USaveGameService.ContinueAsyncSave"), STAT_SaveGameService_ContinueAsyncSave, STATGROUP_SaveGame);
+
+	const int32& UserIndex = GetCurrentUserIndex();
+	if (SaveCancellationToken->IsCancelled())
+	{
+		AbortCancelledSave(SlotName);
+		return;
+	}
+
+	if (!CurrentSaveGame.IsValid())
+	{
+		HandleAsyncSaveCompleted(SlotName, UserIndex, false);
+		return;
+	}
+
+	// (i) Serialized here instead of inside the serializer, so the encoded data can be kept as in-memory snapshot.
+	const double PhaseStartTime = FPlatformTime::Seconds();
+	// (i) Pooled buffer is pre-sized with the last encoded size of the slot, so serializing doesn't reallocate it over and over:
+	const TSharedRef<TArray<uint8>> SaveData = SaveGameSerializer->GetBufferPool()->AcquireForSlot(SlotName);
+	const bool bSerialized = SaveGameSerializer->TrySerializeSaveGame(CurrentSaveGame.GetRef(), OUT *SaveData);
+	const double CompressionTime = SaveGameSerializer->GetLastCompressionTime();
+	SaveMetricsInProgress.SetPhaseTime(ESaveLoadPhase::Serialize, FPlatformTime::Seconds() - PhaseStartTime - CompressionTime);
+	SaveMetricsInProgress.SetPhaseTime(ESaveLoadPhase::Compress, CompressionTime);
+	SaveMetricsInProgress.SecondsByModule = SaveGameSerializer->GetLastModuleTimes();
+	SaveMetricsInProgress.NumBytes = SaveData->Num();
+	if (!bSerialized)
+	{
+		HandleAsyncSaveCompleted(SlotName, UserIndex, false);
+		return;
+	}
+
+	if (SaveCancellationToken->IsCancelled())
+	{
+		AbortCancelledSave(SlotName);
+		return;
+	}
+
+	SaveDataInProgress = SaveData;
+	ContentHashInProgress = SaveGameSerializer->GetLastContentHash();
+	CheckSaveSizeBudgets(SlotName, SaveGameSerializer->GetLastSizeReport());
+
+	TArray<FSlotName> SlotNamesToWrite;
+	for (const FSlotName& SaveSlotName : SaveSlotsInProgress)
+	{
+		if (ShouldSkipUnchangedWrite(SaveSlotName, ContentHashInProgress))
+		{
+			// Nothing changed since the last write into this slot -> complete it without touching the disk:
+			UE_LOG(LogSaveGameService, Verbose, TEXT("Skipped writing unchanged SaveGame to slot %s (%d bytes)"), *SaveSlotName, SaveData->Num());
+			SaveResultsBySlot.Add(SaveSlotName, true);
+			continue;
+		}
+		SlotNamesToWrite.Add(SaveSlotName);
+	}
+
+	if (SlotNamesToWrite.IsEmpty())
+	{
+		SaveMetricsInProgress.bSkippedWrite = true;
+		HandleAsyncSaveCompleted(SlotName, UserIndex, true);
+		return;
+	}
+
+	UpdateWriteThrottle();
+	ThrottledSecondsAtSaveIOStart = SaveGameSerializer->GetWriteThrottle().GetTotalThrottledSeconds();
+	WriteSaveDataToSlots(SlotName, MoveTemp(SlotNamesToWrite), FPlatformTime::Seconds());
+}
+
+void USaveGameService::WriteSaveDataToSlots(const FSlotName& SlotName, TArray<FSlotName> RemainingSlotNames, double IOStartTime)
+{
+	const FSlotName SlotNameToWrite = RemainingSlotNames[0];
+	RemainingSlotNames.RemoveAt(0);
+
+	// (i) A write that already started completes regularly even when cancelled, as the file on disk did change:
+	SaveGameSerializer->AsyncSaveDataToSlot(SaveDataInProgress.ToSharedRef(), SlotNameToWrite, GetCurrentUserIndex(), USaveGameSerializer::FOnAsyncSaveCompleted::CreateWeakLambda(this,
+		[this, SlotName, RemainingSlotNames, CancellationToken = SaveCancellationToken, IOStartTime](const FSlotName& ResultSlotName, const int32 ResultUserIndex, bool bSuccess)
+		{
+			// (i) The service was shut down, or already finished this save, while the write was in flight -> nothing left to complete:
+			if (GetCurrentStatus() == EStatus::Uninitialized || CancellationToken != SaveCancellationToken)
+				return;
+
+			SaveResultsBySlot.Add(ResultSlotName, bSuccess);
+			if (!RemainingSlotNames.IsEmpty() && !CancellationToken->IsCancelled())
+			{
+				WriteSaveDataToSlots(SlotName, RemainingSlotNames, IOStartTime);
+				return;
+			}
+
+			SaveMetricsInProgress.SetPhaseTime(ESaveLoadPhase::IO, FPlatformTime::Seconds() - IOStartTime);
+			if (SaveGameSerializer)
+			{
+				SaveMetricsInProgress.SetPhaseTime(ESaveLoadPhase::Throttle, SaveGameSerializer->GetWriteThrottle().GetTotalThrottledSeconds() - ThrottledSecondsAtSaveIOStart);
+			}
+			bool bAnySucceeded = false, bAllSucceeded = true;
+			for (const TTuple<FSlotName, bool>& SlotAndResult : SaveResultsBySlot)
+			{
+				bAnySucceeded |= SlotAndResult.Value;
+				bAllSucceeded &= SlotAndResult.Value;
+			}
+
+			if (!bAnySucceeded && CancellationToken->IsCancelled())
+			{
+				AbortCancelledSave(SlotName);
+				return;
+			}
+			HandleAsyncSaveCompleted(SlotName, ResultUserIndex, bAllSucceeded);
+		}), SaveCancellationToken, SaveLoadBehavior->GetWriteIOPriority(*this, SlotNameToWrite));
+}
+
+void USaveGameService::UpdateWriteThrottle()
+{
+	if (!SaveGameSerializer)
+		return;
+
+	const int64 BandwidthWhileStreaming = static_cast<int64>(GetDefault<USaveGameServiceSettings>()->WriteBandwidthWhileStreamingKiB) * 1024;
+	const bool bThrottle = (BandwidthWhileStreaming > 0 && SaveLoadBehavior->IsStreamingActive(*this));
+	SaveGameSerializer->GetWriteThrottle().SetBandwidthLimit(bThrottle ? BandwidthWhileStreaming : 0);
+}
+
+FDelegateHandle USaveGameService::AddSaveContributor(const FName& ContributorName, const FCurrentSaveGame::FOnContributeToSave& Contributor)
+{
+	FSaveContributor& SaveContributor = SaveContributors.AddDefaulted_GetRef();
+	SaveContributor.Name = ContributorName;
+	SaveContributor.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+	SaveContributor.Delegate = Contributor;
+	return SaveContributor.Handle;
+}
+
+void USaveGameService::RemoveSaveContributor(const FDelegateHandle& Handle)
+{
+	SaveContributors.RemoveAll([&Handle](const FSaveContributor& Contributor) { return (Contributor.Handle == Handle); });
+}
+
+void USaveGameService::RemoveAllSaveContributors(const void* UserObject)
+{
+	SaveContributors.RemoveAll([UserObject](const FSaveContributor& Contributor) { return Contributor.Delegate.IsBoundToObject(UserObject); });
+}
+
+bool USaveGameService::StartSaveContributions()
+{
+	PendingSaveContributions.Reset();
+	SaveMetricsInProgress.SecondsByContributor.Reset();
+	SaveContributionsStartTime = FPlatformTime::Seconds();
+
+	// (i) Iterate a copy, since contributors may (un-)register others:
+	const TArray<FSaveContributor> Contributors = SaveContributors;
+	for (const FSaveContributor& Contributor : Contributors)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		TFuture<FCurrentSaveGame::FSaveContributionWriter> Future = (Contributor.Delegate.IsBound() ? Contributor.Delegate.Execute(CurrentSaveGame) : TFuture<FCurrentSaveGame::FSaveContributionWriter>());
+		if (!Future.IsValid())
+			continue;
+
+		// (i) The continuation runs on whichever thread completes the contribution, to measure when it actually was ready:
+		FPendingSaveContribution& PendingContribution = PendingSaveContributions.AddDefaulted_GetRef();
+		PendingContribution.ContributorName = Contributor.Name;
+		PendingContribution.StartTime = StartTime;
+		PendingContribution.Contribution = Future.Next([](FCurrentSaveGame::FSaveContributionWriter Writer)
+		{
+			return FSaveContribution{ MoveTemp(Writer), FPlatformTime::Seconds() };
+		});
+	}
+
+	if (PendingSaveContributions.IsEmpty())
+		return false;
+
+	// Contributions that completed synchronously don't need to wait for the next tick:
+	for (const FPendingSaveContribution& PendingContribution : PendingSaveContributions)
+	{
+		if (!PendingContribution.Contribution.IsReady())
+			return true;
+	}
+
+	ApplySaveContributions();
+	return false;
+}
+
+void USaveGameService::UpdatePendingSaveContributions()
+{
+	if (!SlotAwaitingSaveContributions.IsSet())
+		return;
+
+	const float Timeout = GetDefault<USaveGameServiceSettings>()->SaveContributionTimeout;
+	const bool bTimedOut = (Timeout > 0.0f && FPlatformTime::Seconds() - SaveContributionsStartTime > Timeout);
+	for (const FPendingSaveContribution& PendingContribution : PendingSaveContributions)
+	{
+		if (!PendingContribution.Contribution.IsReady() && !bTimedOut)
+			return;
+	}
+
+	// (i) A contributor that never completes must not block saving forever -> save without the contributions that aren't ready yet:
+	if (bTimedOut)
+	{
+		PendingSaveContributions.RemoveAll([Timeout](const FPendingSaveContribution& PendingContribution)
+		{
+			if (PendingContribution.Contribution.IsReady())
+				return false;
+
+			UE_LOG(LogSaveGameService, Warning, TEXT("Dropped save contribution of %s, because it wasn't ready within %.2f seconds."), *PendingContribution.ContributorName.ToString(), Timeout);
+			return true;
+		});
+	}
+
+	const FSlotName SlotName = *SlotAwaitingSaveContributions;
+	SlotAwaitingSaveContributions.Reset();
+	ApplySaveContributions();
+	ContinueAsyncSave(SlotName);
+}
+
+void USaveGameService::ApplySaveContributions()
+{
+	TArray<FPendingSaveContribution> Contributions = MoveTemp(PendingSaveContributions);
+	PendingSaveContributions.Reset();
+	for (FPendingSaveContribution& PendingContribution : Contributions)
+	{
+		FSaveContribution Contribution = PendingContribution.Contribution.Consume();
+		const double WriteStartTime = FPlatformTime::Seconds();
+		if (Contribution.Writer && CurrentSaveGame.IsValid())
+		{
+			Contribution.Writer(CurrentSaveGame);
+		}
+
+		const double Seconds = (Contribution.ReadyTime - PendingContribution.StartTime) + (FPlatformTime::Seconds() - WriteStartTime);
+		SaveMetricsInProgress.SecondsByContributor.Add(PendingContribution.ContributorName, Seconds);
+	}
+
+	SaveMetricsInProgress.SetPhaseTime(ESaveLoadPhase::Contribute, FPlatformTime::Seconds() - SaveContributionsStartTime);
+}
+
+void USaveGameService::CheckSaveSizeBudgets(const FSlotName& SlotName, const FSaveGameSizeReport& SizeReport) const
+{
+	const USaveGameServiceSettings& Settings = *GetDefault<USaveGameServiceSettings>();
+	for (const TTuple<FName, int32>& ModuleAndBudget : Settings.ModuleSizeBudgetsKiB)
+	{
+		const int64* NumBytes = SizeReport.BytesByModule.Find(ModuleAndBudget.Key);
+		const int64 BudgetBytes = static_cast<int64>(ModuleAndBudget.Value) * 1024;
+		if (NumBytes && *NumBytes > BudgetBytes)
+		{
+			UE_LOG(LogSaveGameService, Warning, TEXT("SaveGame module %s exceeds its size budget when saving to slot %s: %lld of %lld bytes"),
+				*ModuleAndBudget.Key.ToString(), *SlotName, *NumBytes, BudgetBytes);
+		}
+	}
+}
+
+void USaveGameService::AbortCancelledSave(const FSlotName& SlotName)
+{
+	UE_LOG(LogSaveGameService, Log, TEXT("Save to slot %s aborted, because all of its requests were cancelled."), *SlotName);
+	AddDebugEntry(FSaveLoadDebugEntry("AbortCancelledSave", FDebugContext(), *SlotName));
+
+	SaveDataInProgress.Reset();
+	ContentHashInProgress.Reset();
+	SaveCancellationToken.Reset();
+	SaveSlotsInProgress.Reset();
+	SaveResultsBySlot.Reset();
+
+	ConsumeSaveRequestsInProgress(nullptr, false);
+	SetStatus(EStatus::Idle);
+	FinishSaveLoadMetrics(SaveMetricsInProgress, false);
+
+	ProcessPendingRequests();
+}
+
+bool USaveGameService::ShouldSkipUnchangedWrite(const FSlotName& SlotName, const TOptional<uint64>& ContentHash) const
+{
+	if (!ContentHash.IsSet() || !GetDefault<USaveGameServiceSettings>()->bSkipUnchangedWrites)
+		return false;
+
+	const uint64* LastWrittenContentHash = ContentHashesBySlot.Find(SlotName);
+	return (LastWrittenContentHash && *LastWrittenContentHash == *ContentHash && DoesSaveFileExist(SlotName));
+}
+
+void USaveGameService::HandleAsyncSaveCompleted(const FSlotName& SlotName, const int32 UserIndex, bool bSuccess)
+{
+	// (i) The same data may have been written into multiple slots (see @RequestSaveCurrentSaveGameToSlots):
+	const TArray<FSlotName> SavedSlotNames = (SaveSlotsInProgress.IsEmpty() ? TArray<FSlotName>{ SlotName } : SaveSlotsInProgress);
+	CurrentSaveGame.UpdateTimeOfLastSave();
+	CurrentSaveGame.SetSlotLastSavedTo(SlotName);
+
+	// Cache current save game as snapshot copy, so it can be restored as the state it was saved in:
+	CachedSaveGames.CopyToCache(*this, SavedSlotNames, CurrentSaveGame.GetRef());
+	OnAvailableSaveGamesChanged.Broadcast();
+
+	// Keep encoded data in memory, so it can be restored again without disk I/O:
+	if (bSuccess && SaveDataInProgress.IsValid())
+	{
+		const FString Context = FString::JoinBy(SaveRequestsInProgress, TEXT(", "),
+			[](const TSharedRef<ISaveLoadRequest>& Request) { return Request->Context; });
+		InMemorySnapshots.Add(SlotName, Context, SaveDataInProgress.ToSharedRef());
+	}
+	SaveDataInProgress.Reset();
+
+	for (const FSlotName& SavedSlotName : SavedSlotNames)
+	{
+		// Remember what was written, or forget it if the state on disk is unknown:
+		const bool* bSlotSuccess = SaveResultsBySlot.Find(SavedSlotName);
+		if ((bSlotSuccess ? *bSlotSuccess : bSuccess) && ContentHashInProgress.IsSet())
+		{
+			ContentHashesBySlot.Add(SavedSlotName, *ContentHashInProgress);
+		}
+		else
+		{
+			ContentHashesBySlot.Remove(SavedSlotName);
+		}
+
+		// The file changed, so a speculative decode of it would be outdated:
+		DiscardSpeculativeDecode(SavedSlotName);
+	}
+	ContentHashInProgress.Reset();
+	SaveCancellationToken.Reset();
+	bMostLikelySlotToLoadDirty = true;
+
+	ConsumeSaveRequestsInProgress(CurrentSaveGame.GetMutablePtr(), bSuccess);
+	SaveSlotsInProgress.Reset();
+	SaveResultsBySlot.Reset();
+	SetStatus(EStatus::Idle);
+	FinishSaveLoadMetrics(SaveMetricsInProgress, bSuccess);
+
+	OnAfterSaved.Broadcast(CurrentSaveGame);
+
+	ProcessPendingRequests();
+}
+
+void USaveGameService::PerformAsyncLoad(const FSlotName& SlotName)
+{
+	const TOptional<FSaveGameSnapshotHandle> SnapshotHandle = GetSnapshotHandleOfLoadInProgress();
+	if (!SnapshotHandle.IsSet() && !DoesSaveFileExist(SlotName))
+		return;
+
+	SetStatus(EStatus::Loading);
+	LoadCancellationToken = MakeShared<FSaveLoadCancellationToken, ESPMode::ThreadSafe>();
+
+	const int32& UserIndex = GetCurrentUserIndex();
+	if (SnapshotHandle.IsSet())
+	{
+		// (i) Restoring an in-memory snapshot skips the I/O. Its data is kept alive, since restoring could trigger new saves that evict the snapshot:
+		const FSaveGameSnapshot* Snapshot = InMemorySnapshots.Find(*SnapshotHandle);
+		const TSharedPtr<const TArray<uint8>> EncodedData = (Snapshot ? Snapshot->EncodedData : nullptr);
+		if (!EncodedData.IsValid())
+		{
+			HandleAsyncLoadCompleted(SlotName, UserIndex, nullptr);
+			return;
+		}
+
+		LoadMetricsInProgress.NumBytes = EncodedData->Num();
+		DeserializeLoadedData(SlotName, UserIndex, *EncodedData);
+		return;
+	}
+
+	// (i) Loads raw data first and deserializes here, so I/O and deserialization can be measured separately.
+	SaveGameSerializer->AsyncLoadDataFromSlot(SlotName, UserIndex, USaveGameSerializer::FOnAsyncLoadDataCompleted::CreateWeakLambda(this,
+		[this, CancellationToken = LoadCancellationToken, IOStartTime = FPlatformTime::Seconds()](const FSlotName& ResultSlotName, const int32 ResultUserIndex, bool bSuccess, const TArray<uint8>& SaveData)
+		{
+			// (i) Cancelled loads were already aborted, so the service may even be busy with another operation by now:
+			if (CancellationToken->IsCancelled())
+				return;
+
+			LoadMetricsInProgress.SetPhaseTime(ESaveLoadPhase::IO, FPlatformTime::Seconds() - IOStartTime);
+			LoadMetricsInProgress.NumBytes = SaveData.Num();
+
+			if (!bSuccess || !SaveGameSerializer)
+			{
+				HandleAsyncLoadCompleted(ResultSlotName, ResultUserIndex, nullptr);
+				return;
+			}
+
+			DeserializeLoadedData(ResultSlotName, ResultUserIndex, SaveData);
+		}), LoadCancellationToken, ESaveGameIOPriority::High);
+}
+
+void USaveGameService::DeserializeLoadedData(const FSlotName& SlotName, const int32 UserIndex, const TArray<uint8>& SaveData)
+{
+	SaveGameSerializer->AsyncDeserializeSaveGame(SaveData, USaveGameSerializer::FOnAsyncDeserializeCompleted::CreateWeakLambda(this,
+		[this, CancellationToken = LoadCancellationToken, SlotName, UserIndex, DeserializeStartTime = FPlatformTime::Seconds()](USaveGame* LoadedSaveGame)
+		{
+			if (CancellationToken->IsCancelled())
+				return;
+
+			const double AssetPreloadTime = SaveGameSerializer->GetLastAssetPreloadTime();
+			const double CompressionTime = SaveGameSerializer->GetLastCompressionTime();
+			LoadMetricsInProgress.SetPhaseTime(ESaveLoadPhase::AssetPreload, AssetPreloadTime);
+			LoadMetricsInProgress.SetPhaseTime(ESaveLoadPhase::Deserialize, FPlatformTime::Seconds() - DeserializeStartTime - AssetPreloadTime - CompressionTime);
+			LoadMetricsInProgress.SetPhaseTime(ESaveLoadPhase::Compress, CompressionTime);
+			LoadMetricsInProgress.SecondsByModule = SaveGameSerializer->GetLastModuleTimes();
+
+			HandleAsyncLoadCompleted(SlotName, UserIndex, LoadedSaveGame);
+		}), LoadCancellationToken);
+}
+
+TOptional<FSaveGameSnapshotHandle> USaveGameService::GetSnapshotHandleOfLoadInProgress() const
+{
+	for (const TSharedRef<ISaveLoadRequest>& Request : LoadRequestsInProgress)
+	{
+		if (Request->SnapshotHandle.IsSet())
+			return Request->SnapshotHandle;
+	}
+	return {};
+}
+
+void USaveGameService::AbortCancelledLoad(const FSlotName& SlotName)
+{
+	UE_LOG(LogSaveGameService, Log, TEXT("Load from slot %s aborted, because all of its requests were cancelled."), *SlotName);
+	AddDebugEntry(FSaveLoadDebugEntry("AbortCancelledLoad", FDebugContext(), *SlotName));
+
+	LoadCancellationToken.Reset();
+
+	ConsumeLoadRequestsInProgress(nullptr, false);
+	SetStatus(EStatus::Idle);
+	FinishSaveLoadMetrics(LoadMetricsInProgress, false);
+
+	ProcessPendingRequests();
+}
+
+USaveGame* USaveGameService::PerformSyncLoad(const FSlotName& SlotName)
+{
+	const int32 UserIndex = GetCurrentUserIndex();
+
+	USaveGame* LoadedSaveGame = nullptr;
+	SaveGameSerializer->TryLoadGameFromSlot(SlotName, UserIndex, OUT LoadedSaveGame);
+	if (LoadedSaveGame && !CachedSaveGames.Contains(SlotName))
+	{
+		CachedSaveGames.CopyToCache(*this, SlotName, *LoadedSaveGame);
+		OnAvailableSaveGamesChanged.Broadcast();
+	}
+
+	return LoadedSaveGame;
+}
+
+void USaveGameService::HandleAsyncLoadCompleted(const FSlotName& SlotName, const int32 UserIndex, USaveGame* LoadedSaveGame)
+{
+	LoadCancellationToken.Reset();
+	UE_CLOG(!IsValid(LoadedSaveGame), LogSaveGameService, Log, TEXT("AsyncLoad of SaveGame in slot %s failed."), *SlotName);
+
+	// (i) Restored snapshots only represent the content of their slot, as long as no newer SaveGame was written into it:
+	const TOptional<FSaveGameSnapshotHandle> SnapshotHandle = GetSnapshotHandleOfLoadInProgress();
+	const FSaveGameSnapshot* MostRecentSnapshotOfSlot = InMemorySnapshots.FindMostRecentOfSlot(SlotName);
+	const bool bRepresentsSlot = (!SnapshotHandle.IsSet() || (MostRecentSnapshotOfSlot && MostRecentSnapshotOfSlot->Handle == *SnapshotHandle));
+	if (IsValid(LoadedSaveGame) && bRepresentsSlot && !CachedSaveGames.Contains(SlotName))
+	{
 		CachedSaveGames.CopyToCache(*this, SlotName, *LoadedSaveGame);
 		OnAvailableSaveGamesChanged.Broadcast();
 	}
 
 	ConsumeLoadRequestsInProgress(LoadedSaveGame, IsValid(LoadedSaveGame));
+	FinishSaveLoadMetrics(LoadMetricsInProgress, IsValid(LoadedSaveGame));
 
 	SetStatus(EStatus::Idle);
 	ProcessPendingRequests();
 }
 
+void USaveGameService::BeginSaveLoadMetrics(FSaveLoadMetrics& OutMetrics, ESaveLoadOperation Operation, const FSlotName& SlotName, const TArray<TSharedRef<ISaveLoadRequest>>& Requests) const
+{
+	const double Now = FPlatformTime::Seconds();
+	OutMetrics = FSaveLoadMetrics(Operation, SlotName);
+	OutMetrics.StartTime = Now;
+	for (const TSharedRef<ISaveLoadRequest>& Request : Requests)
+	{
+		OutMetrics.StartTime = FMath::Min(OutMetrics.StartTime, Request->EnqueueTime);
+		if (Request->DeferralTime > 0.0)
+		{
+			OutMetrics.SetPhaseTime(ESaveLoadPhase::Deferral, FMath::Max(OutMetrics.GetPhaseTime(ESaveLoadPhase::Deferral), Request->DeferralTime));
+		}
+	}
+	OutMetrics.SetPhaseTime(ESaveLoadPhase::QueueWait, Now - OutMetrics.StartTime);
+}
+
+void USaveGameService::FinishSaveLoadMetrics(FSaveLoadMetrics& Metrics, bool bSuccess)
+{
+	Metrics.bSuccess = bSuccess;
+	Metrics.SetPhaseTime(ESaveLoadPhase::Total, FPlatformTime::Seconds() - Metrics.StartTime);
+	SaveLoadMetrics.Record(Metrics);
+	UE_LOG(LogSaveGameService, Verbose, TEXT("%s"), *Metrics.ToString());
+}
+
 void USaveGameService::HandleLevelChanged(UWorld* NewWorld)
 {
 	// don't update save locks for e.g. editor preview worlds such as the thumbnail renderer worlds
@@ -796,6 +1901,11 @@ void USaveGameService::HandleLevelChanged(UWorld* NewWorld)
 	
 	UpdateSaveLockForLevel(NewWorld);
 
+	if (bIsRestorePendingAfterTravel)
+	{
+		HandleTravelDestinationInitialized(*NewWorld);
+	}
+
 	SaveLoadBehavior->HandleLevelChanged(*this, NewWorld);
 }
 
@@ -886,24 +1996,21 @@ void USaveGameService::SetStatus(const EStatus& NewStatus)
 	OnStatusChanged.Broadcast(NewStatus);
 }
 
-void USaveGameService::AddDebugEntry(const FString& Entry)
+void USaveGameService::AddDebugEntry(FSaveLoadDebugEntry&& Entry)
 {
-	DebugHistory.Add(FString::Printf(TEXT("(%s UTC)\t %s"), *FDateTime::UtcNow().ToString(), *Entry));
-	while (DebugHistory.Num() >= DebugHistoryEntriesToKeep)
-	{
-		// Shrink head-first to fit desired size:
-		DebugHistory.RemoveAt(0);
-	}
+	DebugHistory.Add(MoveTemp(Entry));
 }
 
-void USaveGameService::AddDebugEntry(const FString& Operation, const FDebugContext& Context)
+void USaveGameService::AddDebugEntry(const FName& Operation, const FDebugContext& Context)
 {
-	AddDebugEntry(FString::Printf(TEXT("[%s] %s"), *Operation, *Context));
+	AddDebugEntry(FSaveLoadDebugEntry(Operation, Context));
 }
 
-void USaveGameService::AddDebugEntry(const FString& Operation, const FDebugContext& Context, bool bSuccess, double ExecTime)
+void USaveGameService::AddDebugEntry(const FName& Operation, const FDebugContext& Context, bool bSuccess, double ExecTime)
 {
-	AddDebugEntry(FString::Printf(TEXT("[%s] %s (took %.3fsec): %s"), *Operation, (bSuccess ? TEXT("succeeded") : TEXT("failed")), ExecTime, *Context));
+	FSaveLoadDebugEntry Entry(Operation, Context);
+	Entry.SetResult(bSuccess, ExecTime);
+	AddDebugEntry(MoveTemp(Entry));
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -930,6 +2037,15 @@ void USaveGameService::FSaveGamesCache::CopyToCache(USaveGameService& InService,
 	SnapshotsBySlot.FindOrAdd(SlotName) = TStrongObjectPtr(&Copy);
 }
 
+void USaveGameService::FSaveGamesCache::CopyToCache(USaveGameService& InService, const TArray<FSlotName>& SlotNames, const USaveGame& SaveGame)
+{
+	const USaveGame& Copy = InService.SaveLoadBehavior->DuplicateSaveGameObject(InService, SaveGame);
+	for (const FSlotName& SlotName : SlotNames)
+	{
+		SnapshotsBySlot.FindOrAdd(SlotName) = TStrongObjectPtr(&Copy);
+	}
+}
+
 USaveGame* USaveGameService::FSaveGamesCache::CopyFromCache(USaveGameService& InService, const FSlotName& SlotName) const
 {
 	if (!Contains(SlotName))
@@ -967,6 +2083,14 @@ void USaveGameService::ISaveLoadRequest::Finish(USaveGame* RequestedSaveGame, bo
 	}
 }
 
+void USaveGameService::ISaveLoadRequest::AddFinishDebugEntry(const FName& Operation, bool bSuccess) const
+{
+	FSaveLoadDebugEntry Entry(Operation, Context, SlotName.IsSet() ? FName(**SlotName) : NAME_None);
+	Entry.Handle = Handle;
+	Entry.SetResult(bSuccess, Runtime);
+	Service.AddDebugEntry(MoveTemp(Entry));
+}
+
 void USaveGameService::FLoadToCurrentSaveGameRequest::Finish(USaveGame* RequestedSaveGame, bool bSuccess)
 {
 	if (bSuccess)
@@ -975,7 +2099,7 @@ void USaveGameService::FLoadToCurrentSaveGameRequest::Finish(USaveGame* Requeste
 	}
 
 	Runtime = FPlatformTime::Seconds() - StartTime;
-	Service.AddDebugEntry("LoadToCurrentSaveGameRequest", Context, bSuccess, Runtime);
+	AddFinishDebugEntry("LoadToCurrentSaveGameRequest", bSuccess);
 	ISaveLoadRequest::Finish(RequestedSaveGame, bSuccess);
 }
 
@@ -985,19 +2109,65 @@ void USaveGameService::FLoadAndTravelIntoToCurrentSaveGameRequest::Finish(USaveG
 	{
 		Service.RestoreAsAndTravelIntoCurrentSaveGame(*RequestedSaveGame, SlotName);
 	}
+	else
+	{
+		Service.ReleaseTravelPrefetch();
+	}
 
 	Runtime = FPlatformTime::Seconds() - StartTime;
-	Service.AddDebugEntry("LoadAndTravelIntoToCurrentSaveGameRequest", Context, bSuccess, Runtime);
+	AddFinishDebugEntry("LoadAndTravelIntoToCurrentSaveGameRequest", bSuccess);
 	ISaveLoadRequest::Finish(RequestedSaveGame, bSuccess);
 }
 
+void USaveGameService::FLoadAndTravelIntoToCurrentSaveGameRequest::Cancel()
+{
+	Service.ReleaseTravelPrefetch();
+}
+
 void USaveGameService::FSaveCurrentSaveGameRequest::Finish(USaveGame* RequestedSaveGame, bool bSuccess)
 {
 	Runtime = FPlatformTime::Seconds() - StartTime;
-	Service.AddDebugEntry("SaveCurrentSaveGameRequest", Context, bSuccess, Runtime);
+	AddFinishDebugEntry("SaveCurrentSaveGameRequest", bSuccess);
 	ISaveLoadRequest::Finish(RequestedSaveGame, bSuccess);
 }
 
+USaveGameService::FSaveCurrentSaveGameToSlotsRequest::FSaveCurrentSaveGameToSlotsRequest(USaveGameService& InService, const FDebugContext& InContext, const TArray<FSlotName>& InSlotNames) :
+	ISaveLoadRequest(InService, InContext, InSlotNames[0])
+{
+	AdditionalSlotNames = TArray<FSlotName>(InSlotNames.GetData() + 1, InSlotNames.Num() - 1);
+}
+
+USaveGameService::FSaveCurrentSaveGameToSlotsRequest::FSaveCurrentSaveGameToSlotsRequest(USaveGameService& InService, const FDebugContext& InContext, const TArray<FSlotName>& InSlotNames, const FOnMultiSlotSaveCompleted& Callback) :
+	FSaveCurrentSaveGameToSlotsRequest(InService, InContext, InSlotNames)
+{
+	MultiSlotCallback = Callback;
+}
+
+void USaveGameService::FSaveCurrentSaveGameToSlotsRequest::Finish(USaveGame* RequestedSaveGame, bool bSuccess)
+{
+	Runtime = FPlatformTime::Seconds() - StartTime;
+	AddFinishDebugEntry("SaveCurrentSaveGameToSlotsRequest", bSuccess);
+	ISaveLoadRequest::Finish(RequestedSaveGame, bSuccess);
+
+	if (MultiSlotCallback.IsSet())
+	{
+		// (i) Results of the individual slots are only known when this request was actually processed:
+		auto IsSlotSaved = [this, RequestedSaveGame, bSuccess](const FSlotName& RequestedSlotName)
+		{
+			const bool* bSlotSuccess = (RequestedSaveGame ? Service.SaveResultsBySlot.Find(RequestedSlotName) : nullptr);
+			return (bSlotSuccess ? *bSlotSuccess : bSuccess);
+		};
+
+		TMap<FSlotName, bool> SuccessBySlot;
+		SuccessBySlot.Add(*SlotName, IsSlotSaved(*SlotName));
+		for (const FSlotName& AdditionalSlotName : AdditionalSlotNames)
+		{
+			SuccessBySlot.Add(AdditionalSlotName, IsSlotSaved(AdditionalSlotName));
+		}
+		MultiSlotCallback->ExecuteIfBound(RequestedSaveGame, SuccessBySlot);
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////
 
 FString LexToString(const USaveGameService::EStatus& Status)
@@ -0,0 +1,122 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#include "SaveGame/SaveGameSlotManifest.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSaveGameSlotManifest, Log, All);
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveGameSlotManifestEntry
+
+void FSaveGameSlotManifestEntry::Serialize(FArchive& Ar)
+{
+	Ar << SaveGameFileVersion;
+	Ar << SavedEngineVersion;
+	Ar << SaveGameClassName;
+	Ar << FileTimeStamp;
+	Ar << FileSize;
+
+	FObjectAndNameAsStringProxyArchive ProxyArchive(Ar, true);
+	CustomHeaderData.Serialize(ProxyArchive);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveGameSlotManifest
+
+bool FSaveGameSlotManifest::TryLoadFromFile(const FString& FilePath)
+{
+	Clear();
+
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(OUT FileData, *FilePath, FILEREAD_Silent))
+		return false;
+
+	FMemoryReader MemoryReader(FileData, true);
+
+	// Check incompatible manifest file type and version:
+	int32 FileTypeTag = 0;
+	int32 FileVersion = 0;
+	MemoryReader << FileTypeTag;
+	MemoryReader << FileVersion;
+	if (FileTypeTag != MODULAR_SAVEGAME_MANIFEST_FILE_TYPE_TAG || FileVersion != MODULAR_SAVEGAME_MANIFEST_FILE_VERSION)
+	{
+		UE_LOG(LogSaveGameSlotManifest, Log, TEXT("Ignoring incompatible slot manifest: %s"), *FilePath);
+		return false;
+	}
+
+	int32 NumEntries = 0;
+	MemoryReader << NumEntries;
+	EntriesBySlot.Reserve(NumEntries);
+	for (int32 i = 0; i < NumEntries && !MemoryReader.IsError(); ++i)
+	{
+		FSlotName SlotName;
+		MemoryReader << SlotName;
+		EntriesBySlot.Add(SlotName).Serialize(MemoryReader);
+	}
+
+	if (MemoryReader.IsError())
+	{
+		UE_LOG(LogSaveGameSlotManifest, Warning, TEXT("Slot manifest is corrupted and will be rebuilt: %s"), *FilePath);
+		Clear();
+		return false;
+	}
+
+	return true;
+}
+
+bool FSaveGameSlotManifest::TrySaveToFile(const FString& FilePath) const
+{
+	TArray<uint8> FileData;
+	FMemoryWriter MemoryWriter(FileData, true);
+
+	int32 FileTypeTag = MODULAR_SAVEGAME_MANIFEST_FILE_TYPE_TAG;
+	int32 FileVersion = MODULAR_SAVEGAME_MANIFEST_FILE_VERSION;
+	MemoryWriter << FileTypeTag;
+	MemoryWriter << FileVersion;
+
+	int32 NumEntries = EntriesBySlot.Num();
+	MemoryWriter << NumEntries;
+	for (const TTuple<FSlotName, FSaveGameSlotManifestEntry>& SlotAndEntry : EntriesBySlot)
+	{
+		FSlotName SlotName = SlotAndEntry.Key;
+		FSaveGameSlotManifestEntry Entry = SlotAndEntry.Value;
+		MemoryWriter << SlotName;
+		Entry.Serialize(MemoryWriter);
+	}
+
+	// (i) Write to a temporary file first and replace the actual manifest when complete,
+	// so a crash or power loss during the write can never leave a half-written manifest behind.
+	const FString TempFilePath = FilePath + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(FileData, *TempFilePath))
+	{
+		UE_LOG(LogSaveGameSlotManifest, Warning, TEXT("Failed to write slot manifest: %s"), *TempFilePath);
+		return false;
+	}
+
+	if (!IFileManager::Get().Move(*FilePath, *TempFilePath, true))
+	{
+		UE_LOG(LogSaveGameSlotManifest, Warning, TEXT("Failed to replace slot manifest: %s"), *FilePath);
+		IFileManager::Get().Delete(*TempFilePath, false, false, true);
+		return false;
+	}
+
+	return true;
+}
+
+bool FSaveGameSlotManifest::IsUpToDate(const FSlotName& SlotName, const FDateTime& FileTimeStamp, int64 FileSize) const
+{
+	const FSaveGameSlotManifestEntry* Entry = Find(SlotName);
+	return (Entry && Entry->FileTimeStamp == FileTimeStamp && Entry->FileSize == FileSize);
+}
@@ -0,0 +1,170 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#include "SaveGame/SaveGameSnapshotRing.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveGameSnapshotRing
+
+void FSaveGameSnapshotRing::Configure(int32 InCapacity, int64 InMaxNumBytes)
+{
+	// Keep existing snapshots, oldest first:
+	TArray<FSaveGameSnapshot> ExistingSnapshots;
+	for (int32 Age = NumEntries - 1; Age >= 0; --Age)
+	{
+		ExistingSnapshots.Add(MoveTemp(Entries[GetRingIndex(Age)]));
+	}
+
+	Entries.Reset();
+	Entries.SetNum(FMath::Max(InCapacity, 0));
+	NextIndex = 0;
+	NumEntries = 0;
+	NumBytes = 0;
+	MaxNumBytes = FMath::Max<int64>(InMaxNumBytes, 0);
+
+	for (FSaveGameSnapshot& Snapshot : ExistingSnapshots)
+	{
+		TryPush(MoveTemp(Snapshot));
+	}
+}
+
+FSaveGameSnapshotHandle FSaveGameSnapshotRing::Add(const FSaveGameSnapshot::FSlotName& SlotName, const FString& Context, const TSharedRef<const TArray<uint8>>& EncodedData)
+{
+	FSaveGameSnapshot Snapshot;
+	Snapshot.Handle = FSaveGameSnapshotHandle::NewGuid();
+	Snapshot.SlotName = SlotName;
+	Snapshot.Context = Context;
+	Snapshot.UtcTimeOfCapture = FDateTime::UtcNow();
+	Snapshot.EncodedData = EncodedData;
+
+	const FSaveGameSnapshotHandle Handle = Snapshot.Handle;
+	return (TryPush(MoveTemp(Snapshot)) ? Handle : FSaveGameSnapshotHandle());
+}
+
+const FSaveGameSnapshot* FSaveGameSnapshotRing::Find(const FSaveGameSnapshotHandle& Handle) const
+{
+	if (!Handle.IsValid())
+		return nullptr;
+
+	for (int32 Age = 0; Age < NumEntries; ++Age)
+	{
+		const FSaveGameSnapshot& Snapshot = Entries[GetRingIndex(Age)];
+		if (Snapshot.Handle == Handle)
+			return &Snapshot;
+	}
+	return nullptr;
+}
+
+const FSaveGameSnapshot* FSaveGameSnapshotRing::FindMostRecent() const
+{
+	return (NumEntries > 0 ? &Entries[GetRingIndex(0)] : nullptr);
+}
+
+const FSaveGameSnapshot* FSaveGameSnapshotRing::FindMostRecentOfSlot(const FSaveGameSnapshot::FSlotName& SlotName) const
+{
+	for (int32 Age = 0; Age < NumEntries; ++Age)
+	{
+		const FSaveGameSnapshot& Snapshot = Entries[GetRingIndex(Age)];
+		if (Snapshot.SlotName == SlotName)
+			return &Snapshot;
+	}
+	return nullptr;
+}
+
+TArray<FSaveGameSnapshotHandle> FSaveGameSnapshotRing::GetHandles() const
+{
+	TArray<FSaveGameSnapshotHandle> Result;
+	Result.Reserve(NumEntries);
+	for (int32 Age = 0; Age < NumEntries; ++Age)
+	{
+		Result.Add(Entries[GetRingIndex(Age)].Handle);
+	}
+	return Result;
+}
+
+bool FSaveGameSnapshotRing::Remove(const FSaveGameSnapshotHandle& Handle)
+{
+	int32 RemovedAge = INDEX_NONE;
+	for (int32 Age = 0; Age < NumEntries; ++Age)
+	{
+		if (Entries[GetRingIndex(Age)].Handle == Handle)
+		{
+			RemovedAge = Age;
+			break;
+		}
+	}
+
+	if (RemovedAge == INDEX_NONE)
+		return false;
+
+	NumBytes -= Entries[GetRingIndex(RemovedAge)].GetNumBytes();
+
+	// Shift all more recent snapshots one step into the gap, to keep the ring contiguous:
+	for (int32 Age = RemovedAge; Age > 0; --Age)
+	{
+		Entries[GetRingIndex(Age)] = MoveTemp(Entries[GetRingIndex(Age - 1)]);
+	}
+
+	const int32 MostRecentIndex = GetRingIndex(0);
+	Entries[MostRecentIndex] = FSaveGameSnapshot();
+	NextIndex = MostRecentIndex;
+	NumEntries--;
+	return true;
+}
+
+void FSaveGameSnapshotRing::Clear()
+{
+	for (FSaveGameSnapshot& Snapshot : Entries)
+	{
+		Snapshot = FSaveGameSnapshot();
+	}
+	NextIndex = 0;
+	NumEntries = 0;
+	NumBytes = 0;
+}
+
+int32 FSaveGameSnapshotRing::GetRingIndex(int32 Age) const
+{
+	// (i) Age 0 is the most recent snapshot, Age (NumEntries - 1) the oldest one.
+	return (NextIndex - 1 - Age + Entries.Num()) % Entries.Num();
+}
+
+bool FSaveGameSnapshotRing::TryPush(FSaveGameSnapshot&& Snapshot)
+{
+	const int64 SnapshotNumBytes = Snapshot.GetNumBytes();
+	if (!IsEnabled() || !Snapshot.EncodedData.IsValid() || SnapshotNumBytes > MaxNumBytes)
+		return false;
+
+	// Evict oldest snapshots until the new one fits:
+	if (NumEntries == Entries.Num())
+	{
+		RemoveOldest();
+	}
+	while (NumBytes + SnapshotNumBytes > MaxNumBytes)
+	{
+		RemoveOldest();
+	}
+
+	Entries[NextIndex] = MoveTemp(Snapshot);
+	NextIndex = (NextIndex + 1) % Entries.Num();
+	NumEntries++;
+	NumBytes += SnapshotNumBytes;
+	return true;
+}
+
+void FSaveGameSnapshotRing::RemoveOldest()
+{
+	if (NumEntries <= 0)
+		return;
+
+	FSaveGameSnapshot& Oldest = Entries[GetRingIndex(NumEntries - 1)];
+	NumBytes -= Oldest.GetNumBytes();
+	Oldest = FSaveGameSnapshot();
+	NumEntries--;
+}
@@ -0,0 +1,328 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#include "SaveGame/SaveGameStorageBackend.h"
+
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+#include "Async/Async.h"
+#include "Async/AsyncFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "SaveGame/SaveGameBufferPool.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSaveGameStorage, Log, All);
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// UTILS
+
+namespace
+{
+	EAsyncIOPriorityAndFlags ToAsyncIOPriority(ESaveGameIOPriority Priority)
+	{
+		switch (Priority)
+		{
+		case ESaveGameIOPriority::Low: return AIOP_Low;
+		case ESaveGameIOPriority::High: return AIOP_High;
+		default: return AIOP_Normal;
+		}
+	}
+}
+
+const TCHAR* LexToString(ESaveGameIOPriority Priority)
+{
+	switch (Priority)
+	{
+	case ESaveGameIOPriority::Low: return TEXT("Low");
+	case ESaveGameIOPriority::Normal: return TEXT("Normal");
+	case ESaveGameIOPriority::High: return TEXT("High");
+	default: return TEXT("???");
+	}
+}
+
+ENamedThreads::Type GetSaveGameIOTaskThread(ESaveGameIOPriority Priority)
+{
+	switch (Priority)
+	{
+	case ESaveGameIOPriority::Low: return ENamedThreads::AnyBackgroundThreadNormalTask;
+	case ESaveGameIOPriority::High: return ENamedThreads::AnyHiPriThreadHiPriTask;
+	default: return ENamedThreads::AnyBackgroundHiPriTask;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveGameWriteThrottle
+
+double FSaveGameWriteThrottle::ThrottleBlock(int64 NumBytes, double WriteSeconds)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	while (true)
+	{
+		// (i) Limit is checked again after every short sleep, so a lifted limit (e.g. when streaming finished) takes effect right away.
+		const int64 Limit = GetBandwidthLimit();
+		if (Limit <= 0)
+			break;
+
+		const double RemainingSeconds = static_cast<double>(NumBytes) / Limit - WriteSeconds - (FPlatformTime::Seconds() - StartTime);
+		if (RemainingSeconds <= 0.0)
+			break;
+
+		FPlatformProcess::Sleep(static_cast<float>(FMath::Min(RemainingSeconds, 0.01)));
+	}
+
+	const double ThrottledSeconds = FPlatformTime::Seconds() - StartTime;
+	TotalThrottledMicroseconds.fetch_add(static_cast<int64>(ThrottledSeconds * 1000000.0));
+	return ThrottledSeconds;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveGameSystemStorageBackend
+
+bool FSaveGameSystemStorageBackend::TryReadSlot(const FSlotName& SlotName, const int32 UserIndex, TArray<uint8>& OutData) const
+{
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	if (!SaveSystem || SlotName.IsEmpty())
+		return false;
+
+	const FPlatformUserId PlatformUserId = FPlatformMisc::GetPlatformUserForUserIndex(UserIndex);
+	return SaveSystem->LoadGame(false, *SlotName, PlatformUserId, OUT OutData);
+}
+
+bool FSaveGameSystemStorageBackend::TryReadSlotRange(const FSlotName& SlotName, const int32 UserIndex, int64 Offset, int64 NumBytes, TArray<uint8>& OutData) const
+{
+	TArray<uint8> FileData;
+	if (Offset < 0 || !TryReadSlot(SlotName, UserIndex, OUT FileData) || Offset > FileData.Num())
+		return false;
+
+	const int32 NumBytesToCopy = static_cast<int32>(FMath::Min<int64>(NumBytes, FileData.Num() - Offset));
+	OutData = TArray<uint8>(FileData.GetData() + Offset, NumBytesToCopy);
+	return true;
+}
+
+void FSaveGameSystemStorageBackend::AsyncReadSlot(const FSlotName& SlotName, const int32 UserIndex, ESaveGameIOPriority Priority, FOnReadCompleted Callback) const
+{
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	if (!SaveSystem || SlotName.IsEmpty())
+	{
+		Callback(false, TArray<uint8>());
+		return;
+	}
+
+	const FPlatformUserId PlatformUserId = FPlatformMisc::GetPlatformUserForUserIndex(UserIndex);
+	SaveSystem->LoadGameAsync(false, *SlotName, PlatformUserId,
+		[Callback](const FString&, FPlatformUserId, bool bSuccess, const TArray<uint8>& Data)
+		{
+			check(IsInGameThread());
+			Callback(bSuccess, Data);
+		}
+	);
+}
+
+bool FSaveGameSystemStorageBackend::TryWriteSlot(const FSlotName& SlotName, const int32 UserIndex, const TArray<uint8>& Data) const
+{
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	if (!SaveSystem || SlotName.IsEmpty() || Data.IsEmpty())
+		return false;
+
+	const FPlatformUserId PlatformUserId = FPlatformMisc::GetPlatformUserForUserIndex(UserIndex);
+	return SaveSystem->SaveGame(false, *SlotName, PlatformUserId, Data);
+}
+
+void FSaveGameSystemStorageBackend::AsyncWriteSlot(const FSlotName& SlotName, const int32 UserIndex, const TSharedRef<TArray<uint8>>& Data, ESaveGameIOPriority Priority,
+	const TSharedPtr<FSaveGameWriteThrottle>& Throttle, FOnWriteCompleted Callback) const
+{
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	if (!SaveSystem || SlotName.IsEmpty())
+	{
+		Callback(false);
+		return;
+	}
+
+	const FPlatformUserId PlatformUserId = FPlatformMisc::GetPlatformUserForUserIndex(UserIndex);
+	SaveSystem->SaveGameAsync(false, *SlotName, PlatformUserId, Data,
+		[Callback](const FString&, FPlatformUserId, bool bSuccess)
+		{
+			check(IsInGameThread());
+			Callback(bSuccess);
+		}
+	);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @FSaveGameFileStorageBackend
+
+FSaveGameFileStorageBackend::FSaveGameFileStorageBackend(const FString& InSaveGamesDirectory, const TSharedPtr<FSaveGameBufferPool>& InBufferPool) :
+	SaveGamesDirectory(InSaveGamesDirectory), BufferPool(InBufferPool)
+{
+}
+
+bool FSaveGameFileStorageBackend::TryReadSlot(const FSlotName& SlotName, const int32 UserIndex, TArray<uint8>& OutData) const
+{
+	return TryReadSlotWithPriority(SlotName, ESaveGameIOPriority::Normal, OUT OutData);
+}
+
+bool FSaveGameFileStorageBackend::TryReadSlotRange(const FSlotName& SlotName, const int32 UserIndex, int64 Offset, int64 NumBytes, TArray<uint8>& OutData) const
+{
+	const FString FilePath = GetSlotFilePath(SlotName);
+	const int64 FileSize = IFileManager::Get().FileSize(*FilePath);
+	if (FileSize < 0 || Offset < 0 || Offset > FileSize)
+		return false;
+
+	const int64 NumBytesToRead = FMath::Min(NumBytes, FileSize - Offset);
+	if (NumBytesToRead <= 0)
+	{
+		OutData.Reset();
+		return true;
+	}
+
+	return TryReadFileRange(FilePath, Offset, NumBytesToRead, ESaveGameIOPriority::Normal, OUT OutData);
+}
+
+void FSaveGameFileStorageBackend::AsyncReadSlot(const FSlotName& SlotName, const int32 UserIndex, ESaveGameIOPriority Priority, FOnReadCompleted Callback) const
+{
+	// (i) The backend is copied, so the read doesn't depend on the lifetime of the serializer that owns this backend.
+	AsyncTask(GetSaveGameIOTaskThread(Priority), [Backend = *this, SlotName, Priority, Callback]()
+	{
+		// (i) Pooled buffers are pre-sized to the file, so reading never reallocates:
+		const TSharedRef<TArray<uint8>> Data = Backend.BufferPool.IsValid()
+			? Backend.BufferPool->Acquire(IFileManager::Get().FileSize(*Backend.GetSlotFilePath(SlotName)))
+			: MakeShared<TArray<uint8>>();
+		const bool bSuccess = Backend.TryReadSlotWithPriority(SlotName, Priority, OUT *Data);
+		AsyncTask(ENamedThreads::GameThread, [Callback, bSuccess, Data]()
+		{
+			Callback(bSuccess, *Data);
+		});
+	});
+}
+
+bool FSaveGameFileStorageBackend::TryWriteSlot(const FSlotName& SlotName, const int32 UserIndex, const TArray<uint8>& Data) const
+{
+	return (!SlotName.IsEmpty() && !Data.IsEmpty() && TryWriteSlotThrottled(SlotName, Data, nullptr));
+}
+
+void FSaveGameFileStorageBackend::AsyncWriteSlot(const FSlotName& SlotName, const int32 UserIndex, const TSharedRef<TArray<uint8>>& Data, ESaveGameIOPriority Priority,
+	const TSharedPtr<FSaveGameWriteThrottle>& Throttle, FOnWriteCompleted Callback) const
+{
+	if (SlotName.IsEmpty())
+	{
+		Callback(false);
+		return;
+	}
+
+	AsyncTask(GetSaveGameIOTaskThread(Priority), [Backend = *this, SlotName, Data, Throttle = (Priority < ESaveGameIOPriority::High ? Throttle : TSharedPtr<FSaveGameWriteThrottle>()), Callback]()
+	{
+		const bool bSuccess = Backend.TryWriteSlotThrottled(SlotName, *Data, Throttle.Get());
+		AsyncTask(ENamedThreads::GameThread, [Callback, bSuccess]()
+		{
+			Callback(bSuccess);
+		});
+	});
+}
+
+FString FSaveGameFileStorageBackend::GetSlotFilePath(const FSlotName& SlotName) const
+{
+	return FString(SaveGamesDirectory / SlotName + TEXT(".sav"));
+}
+
+bool FSaveGameFileStorageBackend::TryWriteSlotThrottled(const FSlotName& SlotName, const TArray<uint8>& Data, FSaveGameWriteThrottle* Throttle) const
+{
+	// (i) Write to a temporary file first and replace the actual save file when complete, so a crash or
+	// power loss during a (throttled and therefore longer) write can never leave a half-written save file behind.
+	// The temporary file is unique per writing thread, so concurrent writes of the same slot don't share it.
+	const FString FilePath = GetSlotFilePath(SlotName);
+	const FString TempFilePath = FString::Printf(TEXT("%s.%u.tmp"), *FilePath, FPlatformTLS::GetCurrentThreadId());
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*TempFilePath));
+	if (!FileWriter.IsValid())
+	{
+		UE_LOG(LogSaveGameStorage, Warning, TEXT("Failed to open save file for writing: %s"), *TempFilePath);
+		return false;
+	}
+
+	for (int64 Offset = 0; Offset < Data.Num() && !FileWriter->IsError(); Offset += WriteBlockSize)
+	{
+		const double BlockStartTime = FPlatformTime::Seconds();
+		const int64 BlockSize = FMath::Min(WriteBlockSize, Data.Num() - Offset);
+		FileWriter->Serialize(const_cast<uint8*>(Data.GetData() + Offset), BlockSize);
+		if (Throttle)
+		{
+			FileWriter->Flush();
+			Throttle->ThrottleBlock(BlockSize, FPlatformTime::Seconds() - BlockStartTime);
+		}
+	}
+
+	const bool bWritten = (FileWriter->Close() && !FileWriter->IsError());
+	FileWriter.Reset();
+	if (!bWritten || !IFileManager::Get().Move(*FilePath, *TempFilePath, true))
+	{
+		UE_LOG(LogSaveGameStorage, Warning, TEXT("Failed to write save file: %s"), *FilePath);
+		IFileManager::Get().Delete(*TempFilePath, false, false, true);
+		return false;
+	}
+	return true;
+}
+
+bool FSaveGameFileStorageBackend::TryReadSlotWithPriority(const FSlotName& SlotName, ESaveGameIOPriority Priority, TArray<uint8>& OutData) const
+{
+	const FString FilePath = GetSlotFilePath(SlotName);
+	const int64 FileSize = IFileManager::Get().FileSize(*FilePath);
+	if (FileSize <= 0)
+		return false;
+
+	return TryReadFileRange(FilePath, 0, FileSize, Priority, OUT OutData);
+}
+
+bool FSaveGameFileStorageBackend::TryReadFileRange(const FString& FilePath, int64 Offset, int64 NumBytes, ESaveGameIOPriority Priority, TArray<uint8>& OutData) const
+{
+	if (NumBytes > MAX_int32)
+	{
+		UE_LOG(LogSaveGameStorage, Error, TEXT("Save file is too large to be read: %s"), *FilePath);
+		return false;
+	}
+
+	return TryReadFileRangeInBlocks(FilePath, Offset, NumBytes, Priority, OUT OutData);
+}
+
+bool FSaveGameFileStorageBackend::TryReadFileRangeInBlocks(const FString& FilePath, int64 Offset, int64 NumBytes, ESaveGameIOPriority Priority, TArray<uint8>& OutData) const
+{
+	const TUniquePtr<IAsyncReadFileHandle> FileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenAsyncRead(*FilePath));
+	if (!FileHandle.IsValid())
+		return false;
+
+	// (i) All blocks are requested at once, so the platform can process them in parallel, and are read straight into the result:
+	OutData.SetNumUninitialized(static_cast<int32>(NumBytes));
+	TArray<TUniquePtr<IAsyncReadRequest>> ReadRequests;
+	ReadRequests.Reserve(FMath::DivideAndRoundUp(NumBytes, ReadBlockSize));
+	bool bSuccess = true;
+	for (int64 BlockOffset = 0; BlockOffset < NumBytes && bSuccess; BlockOffset += ReadBlockSize)
+	{
+		const int64 BlockSize = FMath::Min(ReadBlockSize, NumBytes - BlockOffset);
+		IAsyncReadRequest* ReadRequest = FileHandle->ReadRequest(Offset + BlockOffset, BlockSize, ToAsyncIOPriority(Priority), nullptr, OutData.GetData() + BlockOffset);
+		bSuccess = (ReadRequest != nullptr);
+		ReadRequests.Emplace(ReadRequest);
+	}
+
+	for (const TUniquePtr<IAsyncReadRequest>& ReadRequest : ReadRequests)
+	{
+		if (ReadRequest.IsValid())
+		{
+			ReadRequest->WaitCompletion();
+			bSuccess &= (ReadRequest->GetReadResults() != nullptr);
+		}
+	}
+
+	// (i) Requests must be deleted before their file handle.
+	ReadRequests.Reset();
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogSaveGameStorage, Warning, TEXT("Failed to read save file: %s"), *FilePath);
+		OutData.Reset();
+	}
+	return bSuccess;
+}
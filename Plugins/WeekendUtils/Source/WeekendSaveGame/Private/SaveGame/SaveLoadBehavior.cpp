@@ -120,6 +120,87 @@ bool USaveLoadBehavior::TryTravelToSavedLevel(const FCurrentSaveGame& SaveGame)
 	return true;
 }
 
+bool USaveLoadBehavior::IsLowLoadMomentForAutosave(const USaveGameService& SaveGameService, float SmoothedFrameTime, FString& OutReason) const
+{
+	if (IsShowingLoadingScreen(SaveGameService))
+	{
+		OutReason = "Loading screen";
+		return true;
+	}
+
+	const UWorld* World = SaveGameService.GetWorld();
+	if (IsValid(World) && World->IsPaused())
+	{
+		OutReason = "Game paused";
+		return true;
+	}
+
+	// Streaming competes with the autosave for the same resources (game thread time, memory and disk I/O):
+	if (IsStreamingActive(SaveGameService))
+		return false;
+
+	const float FrameTimeThreshold = GetDefault<USaveGameServiceSettings>()->AutosaveFrameTimeThreshold / 1000.0f;
+	if (SmoothedFrameTime > FrameTimeThreshold)
+		return false;
+
+	OutReason = FString::Printf(TEXT("Frame time headroom (%.1fms)"), SmoothedFrameTime * 1000.0f);
+	return true;
+}
+
+TOptional<USaveLoadBehavior::FSlotName> USaveLoadBehavior::FindMostLikelySlotToLoad(const USaveGameService& SaveGameService) const
+{
+	TOptional<FSlotName> MostRecentSlotName = {};
+	FDateTime MostRecentTimeStamp = FDateTime::MinValue();
+	auto ConsiderSlot = [&MostRecentSlotName, &MostRecentTimeStamp](const FSlotName& SlotName, const FDateTime& TimeStamp)
+	{
+		if (TimeStamp > MostRecentTimeStamp)
+		{
+			MostRecentTimeStamp = TimeStamp;
+			MostRecentSlotName = SlotName;
+		}
+	};
+
+	// (i) Cached slots already know when they were saved. Only the remaining slots need their headers, so no save file needs to be loaded:
+	TSet<FSlotName> SlotNamesWithoutCache = {};
+	for (const FSlotName& SlotName : GetSaveSlotNamesAllowedForLoading(SaveGameService.GetCurrentSaveGame()))
+	{
+		const USaveGame* CachedSaveGame = SaveGameService.GetCachedSaveGameSnapshotAtSlot(SlotName);
+		const TOptional<FDateTime> TimeOfLastSave = (CachedSaveGame ? FindTimeOfLastSaveFromSaveGame(*CachedSaveGame) : TOptional<FDateTime>());
+		if (TimeOfLastSave.IsSet())
+		{
+			ConsiderSlot(SlotName, *TimeOfLastSave);
+			continue;
+		}
+		SlotNamesWithoutCache.Add(SlotName);
+	}
+
+	if (!SlotNamesWithoutCache.IsEmpty())
+	{
+		for (const TTuple<FSlotName, FSaveGameSlotManifestEntry>& SlotAndHeader : SaveGameService.GetSaveGameSlotHeaders(SlotNamesWithoutCache))
+		{
+			ConsiderSlot(SlotAndHeader.Key, SlotAndHeader.Value.FileTimeStamp);
+		}
+	}
+	return MostRecentSlotName;
+}
+
+bool USaveLoadBehavior::ShouldSpeculativelyDecode(const USaveGameService& SaveGameService) const
+{
+	return SaveGameService.GetSpeculativeDecodeFocus().IsSet();
+}
+
+bool USaveLoadBehavior::IsStreamingActive(const USaveGameService& SaveGameService) const
+{
+	const UWorld* World = SaveGameService.GetWorld();
+	return (IsAsyncLoading() || (IsValid(World) && World->IsVisibilityRequestPending()));
+}
+
+ESaveGameIOPriority USaveLoadBehavior::GetWriteIOPriority(const USaveGameService& SaveGameService, const FSlotName& SlotName) const
+{
+	// (i) Nobody waits for autosaves, so they shouldn't take disk bandwidth away from the game:
+	return (SlotName == GetAutosaveSlotName(SaveGameService.GetCurrentSaveGame())) ? ESaveGameIOPriority::Low : ESaveGameIOPriority::Normal;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////
 /// @UDefaultSaveLoadBehavior
 
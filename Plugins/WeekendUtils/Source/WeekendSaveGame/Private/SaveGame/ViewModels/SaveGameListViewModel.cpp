@@ -63,6 +63,7 @@ void USaveGameListViewModel::Update()
 void USaveGameListViewModel::EndUsage()
 {
 	Slots.Reset();
+	ClearFocusedSlot();
 
 	if (SaveGameService.IsValid())
 	{
@@ -71,6 +72,22 @@ void USaveGameListViewModel::EndUsage()
 	}
 }
 
+void USaveGameListViewModel::SetFocusedSlot(const FString& SlotName)
+{
+	if (SaveGameService.IsValid() && AllowsLoadingFromWidget())
+	{
+		SaveGameService->SetSpeculativeDecodeFocus(SlotName);
+	}
+}
+
+void USaveGameListViewModel::ClearFocusedSlot()
+{
+	if (SaveGameService.IsValid() && AllowsLoadingFromWidget())
+	{
+		SaveGameService->SetSpeculativeDecodeFocus({});
+	}
+}
+
 void USaveGameListViewModel::BeginDestroy()
 {
 	EndUsage();
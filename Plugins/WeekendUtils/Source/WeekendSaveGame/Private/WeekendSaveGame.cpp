@@ -9,14 +9,28 @@
 
 #include "WeekendSaveGame.h"
 
+#include "SaveGame/SaveGameSchema.h"
+#include "UObject/UObjectGlobals.h"
+
 #define LOCTEXT_NAMESPACE "FWeekendSaveGameModule"
 
 void FWeekendSaveGameModule::StartupModule()
 {
+#if WITH_EDITOR
+	// (i) Compiled SaveGame schemas point to properties, which are replaced when classes are recompiled.
+	ObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda([](const TMap<UObject*, UObject*>&)
+	{
+		FSaveGameSchema::ResetCache();
+	});
+#endif
 }
 
 void FWeekendSaveGameModule::ShutdownModule()
 {
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ObjectsReinstancedHandle);
+#endif
+	FSaveGameSchema::ResetCache();
 }
 
 #undef LOCTEXT_NAMESPACE
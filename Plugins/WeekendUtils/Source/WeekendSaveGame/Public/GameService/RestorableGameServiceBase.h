@@ -11,6 +11,8 @@
 
 #include "CoreMinimal.h"
 #include "GameService/AsyncGameServiceBase.h"
+#include "SaveGame/CurrentSaveGame.h"
+#include "SaveGame/SaveGameRestorePipeline.h"
 
 #include "RestorableGameServiceBase.generated.h"
 
@@ -45,6 +47,13 @@ public:
 	/** Called every time the current SaveGame is about to be saved, so the service can write data into it. */
 	virtual void WriteToSaveGame(const FCurrentSaveGame& InOutSaveGame) {}
 
+	/**
+	 * Called after @WriteToSaveGame when @bWritesToSaveGameAsync is enabled, for data that is expensive to prepare.
+	 * Should copy the needed data and prepare it on a worker thread. The returned writer is called on the game thread before encoding.
+	 * (i) See @USaveGameService::AddSaveContributor.
+	 */
+	virtual TFuture<FCurrentSaveGame::FSaveContributionWriter> WriteToSaveGameAsync(const FCurrentSaveGame& SaveGame) { return {}; }
+
 	/**
 	 * Called after the current SaveGame was loaded. This is not fired if the service is not yet running.
 	 * The initial restoration is being forwarded to @StartRestorableService instead.
@@ -54,6 +63,19 @@ public:
 protected:
 	TWeakObjectPtr<USaveGameService> SaveGameService = nullptr;
 
+	/**
+	 * Tier of the restore pipeline in which this service is restored (see @USaveGameService::RestorePipeline).
+	 * Services that are not needed for the first playable frame should set a later tier in their constructor,
+	 * e.g. @ESaveGameRestoreTier::Deferred for non-critical state that nothing else depends on.
+	 */
+	ESaveGameRestoreTier RestoreTier = ESaveGameRestoreTier::Critical;
+
+	/** Services with higher priority are restored first within their tier. */
+	int32 RestorePriority = 0;
+
+	/** Whether this service contributes to saves asynchronously through @WriteToSaveGameAsync. Should be set in the constructor. */
+	bool bWritesToSaveGameAsync = false;
+
 private:
 	bool bIsWaitingForSaveGameRestore = false;
 
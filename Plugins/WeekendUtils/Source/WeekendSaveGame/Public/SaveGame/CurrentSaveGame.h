@@ -10,6 +10,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Async/Future.h"
 
 #include "CurrentSaveGame.generated.h"
 
@@ -28,6 +29,10 @@ struct WEEKENDSAVEGAME_API FCurrentSaveGame
 	DECLARE_MULTICAST_DELEGATE_OneParam(FOnBeforeSaved, const FCurrentSaveGame&);
 	DECLARE_MULTICAST_DELEGATE_OneParam(FOnAfterSaved, const FCurrentSaveGame&);
 
+	/** Writes data that was prepared asynchronously into the SaveGame. Always called on the game thread. */
+	using FSaveContributionWriter = TUniqueFunction<void(const FCurrentSaveGame&)>;
+	DECLARE_DELEGATE_RetVal_OneParam(TFuture<FSaveContributionWriter>, FOnContributeToSave, const FCurrentSaveGame&);
+
 	using FSlotName = FString;
 
 public:
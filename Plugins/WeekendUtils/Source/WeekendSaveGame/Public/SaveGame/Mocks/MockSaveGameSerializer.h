@@ -30,6 +30,10 @@ public:
 	UPROPERTY(Transient)
 	mutable TArray<TObjectPtr<USaveGame>> SerializedSaveGameObjects = {};
 	TMap<FSlotName, TArray<uint8>> PretendedSaveGamesOnDisk = {};
+	/** Slots that pretend to fail being written, e.g. because the disk is full. */
+	TSet<FSlotName> SlotsFailingToSave = {};
+	/** Pretends async loads to hang, e.g. to test what happens while a load is still in progress. */
+	bool bAsyncLoadsNeverComplete = false;
 
 	// - USaveGameSerializer
 	using USaveGameSerializer::TrySaveGameToSlot;
@@ -38,9 +42,20 @@ public:
 	virtual bool TryDeserializeSaveGame(const TArray<uint8>& InSaveData, USaveGame*& OutSaveGameObject) const override;
 	virtual bool DoesSaveGameExist(const FSlotName& SlotName, const int32 UserIndex) const override;
 	virtual bool TrySaveDataToSlot(const TArray<uint8>& InSaveData, const FSlotName& SlotName, const int32 UserIndex) override;
-	virtual void AsyncSaveGameToSlot(USaveGame& SaveGameObject, const FSlotName& SlotName, const int32 UserIndex, FOnAsyncSaveCompleted Callback) override;
+	virtual void AsyncSaveGameToSlot(USaveGame& SaveGameObject, const FSlotName& SlotName, const int32 UserIndex, FOnAsyncSaveCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken = nullptr, ESaveGameIOPriority Priority = ESaveGameIOPriority::Normal) override;
+	virtual void AsyncSaveDataToSlot(const TSharedRef<TArray<uint8>>& InSaveData, const FSlotName& SlotName, const int32 UserIndex, FOnAsyncSaveCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken = nullptr, ESaveGameIOPriority Priority = ESaveGameIOPriority::Normal) override;
 	virtual bool TryLoadDataFromSlot(const FSlotName& SlotName, const int32 UserIndex, TArray<uint8>& OutSaveData) override;
-	virtual void AsyncLoadGameFromSlot(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncLoadCompleted Callback) override;
+	virtual void AsyncLoadGameFromSlot(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncLoadCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken = nullptr, ESaveGameIOPriority Priority = ESaveGameIOPriority::Normal) override;
+	virtual void AsyncLoadDataFromSlot(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncLoadDataCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken = nullptr, ESaveGameIOPriority Priority = ESaveGameIOPriority::Normal) override;
 	virtual bool TryDeleteGameInSlot(const FSlotName& SlotName, const int32 UserIndex, TOptional<FString> OptionalBackupFolder) override;
+	virtual void AsyncReadSlotHeader(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncReadSlotHeaderCompleted Callback, ESaveGameIOPriority Priority = ESaveGameIOPriority::Normal) override;
+	virtual bool TryReadHeaderFromSaveData(const TArray<uint8>& InSaveData, FSaveGameSlotManifestEntry& OutEntry) const override;
+	// --
+
+protected:
+	// - USaveGameSerializer
+	virtual bool IsSlotManifestEnabled() const override { return false; } // (i) Nothing on disk to mirror.
+	virtual bool IsChunkStoreEnabled() const override { return false; } // (i) Nothing on disk to share.
+	virtual bool TryReadHeaderFromSlotFile(const FSlotName& SlotName, const int32 UserIndex, FSaveGameSlotManifestEntry& OutEntry) override;
 	// --
 };
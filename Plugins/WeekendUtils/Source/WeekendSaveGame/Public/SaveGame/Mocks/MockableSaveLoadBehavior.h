@@ -30,6 +30,7 @@ class WEEKENDSAVEGAME_API UMockableSaveLoadBehavior : public USaveLoadBehavior
 
 public:
 	bool bIsAutosavingAllowed = false;
+	bool bIsLowLoadMomentForAutosave = false;
 	FString AutosaveSlotName = "Test_Autosave";
 	TSet<FString> SavableSlotNames = { "Test_Slot1", "Test_Slot2" };
 	TSet<FString> LoadableSlotNames = { "Test_Slot1", "Test_Slot2", AutosaveSlotName };
@@ -96,5 +97,11 @@ public:
 	}
 
 	virtual TSubclassOf<USaveGameSerializer> GetSaveGameSerializerClass() const override { return SaveGameSerializerClass; }
+
+	virtual bool IsLowLoadMomentForAutosave(const USaveGameService& SaveGameService, float SmoothedFrameTime, FString& OutReason) const override
+	{
+		OutReason = "Test";
+		return bIsLowLoadMomentForAutosave;
+	}
 	// --
 };
@@ -74,7 +74,41 @@ public:
 	bool HasModule(const FName& ModuleName, const TSubclassOf<T>& ModuleClass = T::StaticClass()) const;
 	bool HasModule(const FName& ModuleName) const { return Modules.Contains(ModuleName); }
 
-	bool DeleteModule(const FName& ModuleName) { return (Modules.Remove(ModuleName) > 0); }
+	bool DeleteModule(const FName& ModuleName);
+	const TMap<FName, TObjectPtr<USaveGameModule>>& GetModules() const { return Modules; }
+
+	/**
+	 * @returns generation counter that changes whenever the current ModularSaveGame is swapped or modules are added/removed.
+	 * Used by @TSaveGameModuleHandle to revalidate cached modules without looking them up again.
+	 */
+	static uint32 GetModuleHandleGeneration() { return ModuleHandleGeneration; }
+
+	/** Invalidates all @TSaveGameModuleHandle, so they look up their module again on next access. */
+	static void InvalidateModuleHandles() { ++ModuleHandleGeneration; }
+
+	///////////////////////////////////////////////////////////////////////////////////////
+	/// STRUCT MODULES
+
+	/** @returns requested struct module (see @FSaveGameStructModule), which is added if it doesn't exist yet. None = default name of the struct. */
+	template <typename T>
+	T& FindOrAddStructModule(const FName& ModuleName = NAME_None);
+
+	template <typename T>
+	T* FindStructModule(const FName& ModuleName = NAME_None);
+
+	template <typename T>
+	const T* FindStructModule(const FName& ModuleName = NAME_None) const;
+
+	template <typename T>
+	bool HasStructModule(const FName& ModuleName = NAME_None) const { return (FindStructModule<T>(ModuleName) != nullptr); }
+	bool HasStructModule(const FName& ModuleName) const { return StructModules.Contains(ModuleName); }
+
+	bool DeleteStructModule(const FName& ModuleName) { return (StructModules.Remove(ModuleName) > 0); }
+	const TMap<FName, FInstancedStruct>& GetStructModules() const { return StructModules; }
+
+	/** @returns the name that struct modules of given type are registered by, if not registered by custom name. */
+	template <typename T>
+	static FName GetDefaultStructModuleName() { return T::StaticStruct()->GetFName(); }
 
 	///////////////////////////////////////////////////////////////////////////////////////
 	/// HEADER
@@ -98,6 +132,11 @@ public:
 	void SetInstancedHeaderData(const FInstancedStruct& HeaderData) { InstancedHeaderData = MakeShared<FInstancedStruct>(HeaderData); }
 
 	///////////////////////////////////////////////////////////////////////////////////////
+
+	// - UObject
+	virtual void Serialize(FArchive& Ar) override;
+	// --
+
 protected:
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
@@ -106,7 +145,56 @@ protected:
 	UPROPERTY(SaveGame, Instanced, EditDefaultsOnly, Category = "Modular Save Game")
 	TMap<FName, TObjectPtr<USaveGameModule>> Modules = {};
 
+	UPROPERTY(SaveGame, EditDefaultsOnly, Category = "Modular Save Game", meta = (BaseStruct = "/Script/WeekendSaveGame.SaveGameStructModule", ExcludeBaseStruct))
+	TMap<FName, FInstancedStruct> StructModules = {};
+
 	TSharedPtr<FInstancedStruct> InstancedHeaderData = nullptr;
+
+	friend class UModularSaveGameSerializer;
+
+private:
+	static uint32 ModuleHandleGeneration;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// MODULE HANDLE
+
+/**
+ * Typed handle to a module of the current @UModularSaveGame, for code that accesses save modules frequently (e.g. every frame).
+ * The module is looked up once and cached until the generation counter of @UModularSaveGame changes, which happens
+ * when the current SaveGame is swapped or modules are added/removed. Accessing a still valid handle is O(1).
+ * (i) Handles are only meant to be used on the game thread.
+ */
+template <typename T>
+class TSaveGameModuleHandle
+{
+	static_assert(TIsDerivedFrom<T, USaveGameModule>::IsDerived, "Type is not derived from USaveGameModule.");
+
+public:
+	explicit TSaveGameModuleHandle(const TSubclassOf<T>& InModuleClass = T::StaticClass()) :
+		ModuleName(GetDefault<T>(InModuleClass)->DefaultModuleName), ModuleClass(InModuleClass) {}
+	explicit TSaveGameModuleHandle(const FName& InModuleName, const TSubclassOf<T>& InModuleClass = T::StaticClass()) :
+		ModuleName(InModuleName.IsNone() ? GetDefault<T>(InModuleClass)->DefaultModuleName : InModuleName), ModuleClass(InModuleClass) {}
+
+	/** @returns module of the current ModularSaveGame - or nullptr, if there is none. */
+	T* Get() const;
+
+	/** @returns module of the current ModularSaveGame, which is added if it doesn't exist yet - or nullptr, if there is no current ModularSaveGame. */
+	T* GetOrAdd() const;
+
+	/** Forces the next access to look up the module again. */
+	void Reset() const { CachedGeneration = 0; }
+
+	FORCEINLINE T* operator->() const { return Get(); }
+	FORCEINLINE explicit operator bool() const { return (Get() != nullptr); }
+
+	FORCEINLINE const FName& GetModuleName() const { return ModuleName; }
+
+private:
+	FName ModuleName;
+	TSubclassOf<T> ModuleClass;
+	mutable TWeakObjectPtr<T> CachedModule = nullptr;
+	mutable uint32 CachedGeneration = 0;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -114,6 +202,7 @@ protected:
 
 /**
  * Custom serializer for the @UModularSaveGame, to be used within the @USaveGameService.
+ * Modules are encoded into separate buffers in parallel, compressed independently and stored behind a module table.
  */
 UCLASS()
 class WEEKENDSAVEGAME_API UModularSaveGameSerializer : public USaveGameSerializer
@@ -124,6 +213,10 @@ public:
 	// - USaveGameSerializer
 	virtual bool TrySerializeSaveGame(USaveGame& InSaveGameObject, TArray<uint8>& OutSaveData) const override;
 	virtual bool TryDeserializeSaveGame(const TArray<uint8>& InSaveData, USaveGame*& OutSaveGameObject) const override;
+	virtual void GetUnloadedReferencedAssets(const TArray<uint8>& InSaveData, TArray<FSoftObjectPath>& OutAssetPaths) const override;
+	virtual bool TryReadHeaderFromSaveData(const TArray<uint8>& InSaveData, FSaveGameSlotManifestEntry& OutEntry) const override;
+	// - UObject
+	virtual void PostInitProperties() override;
 	// --
 };
 
@@ -166,6 +259,7 @@ T& UModularSaveGame::FindOrAddModule(const FName& ModuleName, const TSubclassOf<
 
 	T* NewModule = NewObject<T>(this, ModuleClass);
 	Modules.Add(ModuleName, NewModule);
+	InvalidateModuleHandles();
 	return *NewModule;
 }
 
@@ -217,6 +311,67 @@ bool UModularSaveGame::HasModule(const FName& ModuleName, const TSubclassOf<T>&
 	return (FoundModule && (FoundModule->GetClass() == ModuleClass));
 }
 
+///////////////////////////////////////////////////////////////////////////////////////
+/// TEMPLATES @TSaveGameModuleHandle
+
+template <typename T>
+T* TSaveGameModuleHandle<T>::Get() const
+{
+	const uint32 Generation = UModularSaveGame::GetModuleHandleGeneration();
+	if (CachedGeneration != Generation)
+	{
+		UModularSaveGame* SaveGame = UModularSaveGame::GetMutableCurrent();
+		CachedModule = (IsValid(SaveGame) ? SaveGame->FindModule<T>(ModuleName, ModuleClass) : nullptr);
+		CachedGeneration = Generation;
+	}
+	return CachedModule.Get();
+}
+
+template <typename T>
+T* TSaveGameModuleHandle<T>::GetOrAdd() const
+{
+	if (T* Module = Get())
+		return Module;
+
+	UModularSaveGame* SaveGame = UModularSaveGame::GetMutableCurrent();
+	if (!IsValid(SaveGame))
+		return nullptr;
+
+	CachedModule = &SaveGame->FindOrAddModule<T>(ModuleName, ModuleClass);
+	CachedGeneration = UModularSaveGame::GetModuleHandleGeneration();
+	return CachedModule.Get();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// TEMPLATES @UModularSaveGame (STRUCT MODULES)
+
+template <typename T>
+T& UModularSaveGame::FindOrAddStructModule(const FName& ModuleName)
+{
+	static_assert(TIsDerivedFrom<T, FSaveGameStructModule>::IsDerived, "Type is not derived from FSaveGameStructModule.");
+	if (T* ExistingModule = FindStructModule<T>(ModuleName))
+		return *ExistingModule;
+
+	const FName& AddModuleName = (ModuleName.IsNone() ? GetDefaultStructModuleName<T>() : ModuleName);
+	return StructModules.Add(AddModuleName, FInstancedStruct::Make<T>()).template GetMutable<T>();
+}
+
+template <typename T>
+T* UModularSaveGame::FindStructModule(const FName& ModuleName)
+{
+	static_assert(TIsDerivedFrom<T, FSaveGameStructModule>::IsDerived, "Type is not derived from FSaveGameStructModule.");
+	FInstancedStruct* FoundModule = StructModules.Find(ModuleName.IsNone() ? GetDefaultStructModuleName<T>() : ModuleName);
+	return ((FoundModule && FoundModule->GetScriptStruct() == T::StaticStruct()) ? FoundModule->template GetMutablePtr<T>() : nullptr);
+}
+
+template <typename T>
+const T* UModularSaveGame::FindStructModule(const FName& ModuleName) const
+{
+	static_assert(TIsDerivedFrom<T, FSaveGameStructModule>::IsDerived, "Type is not derived from FSaveGameStructModule.");
+	const FInstancedStruct* FoundModule = StructModules.Find(ModuleName.IsNone() ? GetDefaultStructModuleName<T>() : ModuleName);
+	return ((FoundModule && FoundModule->GetScriptStruct() == T::StaticStruct()) ? FoundModule->template GetPtr<T>() : nullptr);
+}
+
 template <typename T>
 TSharedPtr<FInstancedStruct> UModularSaveGame::CreateHeaderData(const T& HeaderData)
 {
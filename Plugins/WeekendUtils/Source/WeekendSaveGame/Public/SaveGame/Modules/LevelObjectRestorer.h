@@ -48,6 +48,9 @@ public:
 	{
 		DefaultModuleName = "LevelObjectRestorer";
 		ModuleVersion = 0;
+
+		// (i) Saving and restoring serializes the registered level objects themselves, which must stay on the game thread.
+		bSupportsParallelSerialization = false;
 	}
 
 	/**
@@ -69,11 +72,16 @@ public:
 	void UnregisterLevelObjectWithTransform(AActor& Actor, TOptional<FString> CustomUniqueObjectId = {}, bool bKeepObjectState = true);
 	void UnregisterLevelObjectWithTransform(USceneComponent& SceneComponent, TOptional<FString> CustomUniqueObjectId = {}, bool bKeepObjectState = true);
 
+	/** @returns payload bytes of all object states by the class of the object, as of the last save. Objects that are not registered count as "Unregistered". */
+	FORCEINLINE const TMap<FName, int64>& GetLastSavedSizesByObjectClass() const { return LastSavedSizesByObjectClass; }
+
 	// - UObject
 	virtual void Serialize(FArchive& Ar) override;
 	// --
 
 protected:
+	TMap<FName, int64> LastSavedSizesByObjectClass = {};
+
 	UPROPERTY(Transient, VisibleAnywhere, meta = (DisplayThumbnail = "false"), Category = "Weekend Utils|Save Game")
 	TSet<TWeakObjectPtr<UObject>> SimpleRegisteredObjects = {};
 	UPROPERTY(Transient, VisibleAnywhere, meta = (DisplayThumbnail = "false"), Category = "Weekend Utils|Save Game")
@@ -29,6 +29,7 @@ public:
 	{
 		DefaultModuleName = "ExecuteCheats";
 		ModuleVersion = 0;
+		bSupportsParallelSerialization = true; // (i) Plain SaveGame properties only.
 	}
 
 	/** Cheat commands (with args) that will be executed as soon as the SaveGame is restored and travelled into. */
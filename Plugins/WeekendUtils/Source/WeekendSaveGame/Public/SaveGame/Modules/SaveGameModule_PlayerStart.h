@@ -29,6 +29,7 @@ public:
 	{
 		DefaultModuleName = "PlayerStart";
 		ModuleVersion = 0;
+		bSupportsParallelSerialization = true; // (i) Plain SaveGame properties only.
 	}
 
 	UPROPERTY(SaveGame, EditAnywhere, Category = "Weekend Utils|Save Game")
@@ -30,6 +30,10 @@ public:
 	{
 		DefaultModuleName = "SaveLoadDebugHistory";
 		ModuleVersion = 0;
+
+		// (i) History changes with every save, which would otherwise prevent skipping the write of unchanged SaveGames.
+		bAffectsContentHash = false;
+		bSupportsParallelSerialization = true; // (i) Plain SaveGame properties only.
 	}
 
 	UPROPERTY(Transient)
@@ -0,0 +1,73 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Statistics of a @FSaveGameBufferPool since it was created.
+ */
+struct WEEKENDSAVEGAME_API FSaveGameBufferPoolStats
+{
+	int32 NumAcquires = 0;
+	int32 NumHits = 0; // (i) Acquires that were served with a pooled buffer, instead of a new allocation.
+	int32 NumGrownBuffers = 0; // (i) Buffers that had to grow beyond the capacity they were handed out with.
+	int32 NumReallocationsAvoided = 0; // (i) Estimated reallocations that growing empty buffers to the same sizes would have needed.
+	int64 PooledBytes = 0; // (i) Capacity of all buffers that are waiting in the pool.
+	int64 InUseBytes = 0; // (i) Capacity of all pooled buffers that are currently handed out.
+	int64 PeakBytes = 0; // (i) Highest sum of pooled and handed out capacity.
+
+	FString ToString() const;
+};
+
+/**
+ * Thread-safe pool of large byte arrays for encoded SaveGames, which are reused across save and load operations
+ * instead of growing a new array through many reallocations every time. Buffers are handed out as shared arrays,
+ * which return to the pool when the last reference is released (on any thread), so they can be passed around like any
+ * other encoded save data (e.g. into worker threads or in-memory snapshots). Buffers that don't fit into the memory
+ * budget are freed instead (see @USaveGameServiceSettings::BufferPoolBudgetKiB).
+ * Mainly used by the @USaveGameSerializer, which also pre-sizes buffers for saves with the last encoded size of their slot.
+ */
+class WEEKENDSAVEGAME_API FSaveGameBufferPool : public TSharedFromThis<FSaveGameBufferPool, ESPMode::ThreadSafe>
+{
+public:
+	using FSlotName = FString;
+
+	explicit FSaveGameBufferPool(int64 InMaxPooledBytes);
+
+	/** @returns empty buffer with at least given capacity. Prefers the smallest pooled buffer that fits, otherwise grows the largest one. */
+	TSharedRef<TArray<uint8>> Acquire(int64 MinCapacity);
+	/** @returns empty buffer pre-sized for encoded save data of given slot (see @RecordSlotSize). */
+	TSharedRef<TArray<uint8>> AcquireForSlot(const FSlotName& SlotName);
+
+	/** Remembers the size of the save data last encoded for given slot, which the next @AcquireForSlot pre-sizes for. */
+	void RecordSlotSize(const FSlotName& SlotName, int64 NumBytes);
+	int64 GetExpectedSlotSize(const FSlotName& SlotName) const;
+
+	/** Frees all buffers that are waiting in the pool. Buffers in use still return to the pool afterwards. */
+	void Trim();
+
+	FSaveGameBufferPoolStats GetStats() const;
+
+private:
+	mutable FCriticalSection Mutex;
+	TArray<TUniquePtr<TArray<uint8>>> PooledBuffers = {};
+	TMap<FSlotName, int64> ExpectedSizeBySlot = {};
+	FSaveGameBufferPoolStats Stats;
+	int64 MaxPooledBytes = 0;
+
+	void Release(TArray<uint8>* Buffer, int64 HandedOutCapacity);
+	void UpdateStats();
+
+	/** @returns number of reallocations of an empty array growing to given size with the default slack policy. */
+	static int32 EstimateNumReallocations(int64 NumBytes);
+};
@@ -0,0 +1,159 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FSaveGameWriteThrottle;
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Content address of a single chunk in the @FSaveGameChunkStore: 128-bit hash and size of the chunk data.
+ */
+struct WEEKENDSAVEGAME_API FSaveGameChunkId
+{
+	uint64 HashHigh = 0;
+	uint64 HashLow = 0;
+	int32 Size = 0;
+
+	static FSaveGameChunkId FromData(const uint8* Data, int32 Size);
+
+	/** @returns hex representation of the hash, which is also the file name of the chunk. */
+	FString ToString() const;
+
+	void Serialize(FArchive& Ar);
+
+	FORCEINLINE bool operator==(const FSaveGameChunkId& Other) const { return (HashHigh == Other.HashHigh && HashLow == Other.HashLow && Size == Other.Size); }
+	FORCEINLINE bool operator!=(const FSaveGameChunkId& Other) const { return !(*this == Other); }
+	friend FORCEINLINE uint32 GetTypeHash(const FSaveGameChunkId& ChunkId) { return static_cast<uint32>(ChunkId.HashLow); }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+#define MODULAR_SAVEGAME_CHUNK_LIST_FILE_TYPE_TAG	0x53414352 // = "SACR"
+#define MODULAR_SAVEGAME_CHUNK_LIST_FILE_VERSION	1 // Increase when the chunk list format becomes incompatible to previous version
+
+/**
+ * Ordered list of chunks that make up the save data of a single slot. Written into the save file
+ * instead of the actual save data, when the chunk store is enabled (see @USaveGameServiceSettings::bUseChunkStore).
+ */
+struct WEEKENDSAVEGAME_API FSaveGameChunkList
+{
+	int64 TotalSize = 0;
+	uint64 DataHash = 0;
+	TArray<FSaveGameChunkId> Chunks = {};
+
+	/** @returns whether given save file content is a chunk list, instead of actual save data. */
+	static bool IsChunkListData(const TArray<uint8>& InFileData);
+
+	bool TryReadFromData(const TArray<uint8>& InFileData);
+	void WriteToData(TArray<uint8>& OutFileData) const;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Result of @FSaveGameChunkStore::VerifyIntegrity.
+ */
+struct WEEKENDSAVEGAME_API FSaveGameChunkStoreIntegrityReport
+{
+	int32 NumReferencedChunks = 0;
+	int32 NumMissingChunks = 0;
+	int32 NumCorruptChunks = 0;
+	int32 NumUnreferencedChunks = 0;
+	int32 NumWrongReferenceCounts = 0;
+	int64 StoredBytes = 0;
+	int64 ReferencedBytes = 0;
+
+	/** Files (or slot names) of all chunk lists that reference missing or corrupt chunks and can't be loaded anymore. */
+	TArray<FString> BrokenChunkLists = {};
+
+	FORCEINLINE bool IsHealthy() const { return (NumMissingChunks == 0 && NumCorruptChunks == 0); }
+
+	FString ToString() const;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+#define MODULAR_SAVEGAME_CHUNK_INDEX_FILE_TYPE_TAG	0x53414349 // = "SACI"
+#define MODULAR_SAVEGAME_CHUNK_INDEX_FILE_VERSION	1 // Increase when the chunk index format becomes incompatible to previous version
+
+/**
+ * Content-addressed store of save data chunks, which is shared by all save slots (including backups).
+ * Save data is split into content-defined chunks, so unchanged parts of the data produce the same chunks,
+ * no matter whether data was inserted or removed before them. Every chunk is stored only once, so writing
+ * a mostly unchanged save file only writes a few new chunks.
+ * Chunks are reference-counted by the chunk lists that use them (see @FSaveGameChunkList) and are deleted
+ * by @CollectGarbage, once no chunk list references them anymore. Mainly used by @USaveGameSerializer.
+ *
+ * (i) Splitting, writing and assembling chunks only touches chunk files and is safe to call from worker threads.
+ * The reference counts must only be changed from the game thread.
+ */
+class WEEKENDSAVEGAME_API FSaveGameChunkStore
+{
+public:
+	/** Chunk boundaries are never placed closer than this, so small changes don't produce lots of tiny chunks. */
+	static constexpr int32 MinChunkSize = 4 * 1024;
+	/** Number of hash bits that must be zero at a chunk boundary. Defines the average chunk size beyond @MinChunkSize (16 KiB). */
+	static constexpr int32 ChunkBoundaryBits = 14;
+	/** Chunks are always split at this size, even if their content has no boundary. */
+	static constexpr int32 MaxChunkSize = 64 * 1024;
+
+	explicit FSaveGameChunkStore(const FString& InDirectory);
+
+	/** @returns the content-defined chunks that given data is made of. Doesn't write anything. */
+	static FSaveGameChunkList SplitIntoChunks(const TArray<uint8>& InData);
+
+	/**
+	 * Writes all chunks of given list that aren't stored yet. The chunk list must have been created from given data (see @SplitIntoChunks).
+	 * (i) Written chunks are unreferenced until @AddReferences is called, so garbage collection must not run in between.
+	 * Every written chunk is reported to the optional throttle, which may block the calling thread.
+	 */
+	bool TryWriteChunks(const TArray<uint8>& InData, const FSaveGameChunkList& ChunkList, int64& OutWrittenBytes, FSaveGameWriteThrottle* Throttle = nullptr) const;
+
+	/** Reads and concatenates all chunks of given list. Fails if any chunk is missing or doesn't match its hash. */
+	bool TryAssembleData(const FSaveGameChunkList& ChunkList, TArray<uint8>& OutData) const;
+
+	/** Replaces all reference counts with the ones stored in the index file. @returns false if the file is missing or incompatible. */
+	bool TryLoadIndex();
+
+	/** Atomically writes all reference counts into the index file (via temporary file that replaces the old file when complete). */
+	bool TrySaveIndex() const;
+
+	/** Replaces all reference counts with the actual usage by given chunk lists (i.e. of all existing save files), e.g. when the index file is missing. */
+	void RebuildReferences(const TMap<FString, FSaveGameChunkList>& ChunkListsByFile);
+
+	void AddReferences(const FSaveGameChunkList& ChunkList);
+	void ReleaseReferences(const FSaveGameChunkList& ChunkList);
+
+	/** Deletes all chunks that aren't referenced anymore. @returns number of deleted chunks. */
+	int32 CollectGarbage();
+
+	/**
+	 * Compares the reference counts with the actual usage by given chunk lists (i.e. of all existing save files)
+	 * and checks whether all referenced chunks exist and match their hash. When repairing, the reference counts are
+	 * replaced by the actual usage and unreferenced chunks, e.g. left behind by an interrupted write, are deleted.
+	 */
+	FSaveGameChunkStoreIntegrityReport VerifyIntegrity(const TMap<FString, FSaveGameChunkList>& ChunkListsByFile, bool bRepair);
+
+	FORCEINLINE const FString& GetDirectory() const { return Directory; }
+	FORCEINLINE int32 GetNumChunks() const { return ReferenceCounts.Num(); }
+
+private:
+	FString Directory;
+	TMap<FSaveGameChunkId, int32> ReferenceCounts = {};
+
+	FString GetChunkFilePath(const FSaveGameChunkId& ChunkId) const;
+	FString GetIndexFilePath() const;
+
+	static int32 FindChunkBoundary(const uint8* Data, int32 NumBytes);
+	bool TryReadChunk(const FSaveGameChunkId& ChunkId, TArray<uint8>& OutChunkData) const;
+};
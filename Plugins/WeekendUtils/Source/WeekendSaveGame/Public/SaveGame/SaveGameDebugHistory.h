@@ -0,0 +1,70 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/RingBuffer.h"
+
+/**
+ * Compact record of a single operation of the @USaveGameService.
+ * Only formatted into a string when it is displayed or saved (see @ToString).
+ */
+struct WEEKENDSAVEGAME_API FSaveLoadDebugEntry
+{
+	enum class EResult : uint8
+	{
+		None,
+		Succeeded,
+		Failed
+	};
+
+	FSaveLoadDebugEntry() = default;
+	explicit FSaveLoadDebugEntry(const FName& InOperation, const FString& InContext = FString(), const FName& InSlotName = NAME_None) :
+		Operation(InOperation), SlotName(InSlotName), Context(InContext) {}
+
+	FDateTime UtcTime = FDateTime::UtcNow();
+	FName Operation = NAME_None;
+	FName SlotName = NAME_None;
+	FName KeyHolder = NAME_None;
+	FGuid Handle = FGuid();
+	EResult Result = EResult::None;
+	float Duration = 0.0f;
+	FString Context = FString();
+
+	FSaveLoadDebugEntry& SetResult(bool bSuccess, double InDuration);
+
+	FString ToString() const;
+};
+
+/**
+ * Fixed-capacity ring of @FSaveLoadDebugEntry records. When full, the oldest entry is overwritten.
+ * Mainly used by @USaveGameService.
+ */
+struct WEEKENDSAVEGAME_API FSaveLoadDebugHistory
+{
+	/** Sets the maximum number of entries to keep. Drops the oldest entries if there are more. */
+	void SetCapacity(int32 InCapacity);
+	void Add(FSaveLoadDebugEntry&& Entry);
+	void Clear();
+
+	FORCEINLINE int32 Num() const { return Entries.Num(); }
+	FORCEINLINE int32 GetCapacity() const { return Capacity; }
+	/** @returns entry by index, where 0 is the oldest kept entry. */
+	FORCEINLINE const FSaveLoadDebugEntry& operator[](int32 Index) const { return Entries[Index]; }
+
+	/** Formats up to given number of most recent entries into strings (oldest first). */
+	TArray<FString> FormatMostRecent(int32 MaxEntries) const;
+	/** Formats all kept entries into strings (oldest first). */
+	FORCEINLINE TArray<FString> FormatAll() const { return FormatMostRecent(Entries.Num()); }
+
+private:
+	TRingBuffer<FSaveLoadDebugEntry> Entries = {};
+	int32 Capacity = 0;
+};
@@ -29,6 +29,15 @@ USTRUCT()
 struct WEEKENDSAVEGAME_API FSaveGameHeaderDataBase
 {
 	GENERATED_BODY()
+
+public:
+	virtual ~FSaveGameHeaderDataBase() = default;
+
+	/**
+	 * Resets all data that changes with every save or restore without representing game state, like counters and timestamps.
+	 * Called on a copy of the header data, which counts as content when detecting unchanged SaveGames.
+	 */
+	virtual void ResetVolatileData() {}
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -65,12 +74,23 @@ public:
 
 	FORCEINLINE bool WasEverSaved() const { return (SaveCounter > 0); }
 	FORCEINLINE bool WasEverRestored() const { return (RestoreCounter > 0); }
+
+	// - FSaveGameHeaderDataBase
+	virtual void ResetVolatileData() override;
+	// --
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
 #define MODULAR_SAVEGAME_FILE_TYPE_TAG	0x53415648 // = UE_SAVEGAME_FILE_TYPE_TAG + 1
-#define MODULAR_SAVEGAME_FILE_VERSION	1 // Increase when file format/compression becomes incompatible to previous version
+#define MODULAR_SAVEGAME_FILE_VERSION		5 // Increase when file format/compression changes
+#define MODULAR_SAVEGAME_FILE_VERSION_MIN	1 // Increase when file format/compression becomes incompatible to previous version
+
+// File versions that introduced backward compatible additions to the file format:
+#define MODULAR_SAVEGAME_FILE_VERSION_REFERENCED_ASSETS	2 // Table of referenced assets, to preload them before deserializing.
+#define MODULAR_SAVEGAME_FILE_VERSION_MODULE_TABLE		3 // Modules stored as separately compressed blocks behind a module table.
+#define MODULAR_SAVEGAME_FILE_VERSION_MODULE_SCHEMAS	4 // Schema hashes and fields of positionally serialized modules in the module table.
+#define MODULAR_SAVEGAME_FILE_VERSION_OBJECT_IDENTITY	5 // Sub-objects written once into an identity table, with back-references for shared ones.
 
 /**
  * Implementation detail for header de-/serialization.
@@ -90,7 +110,7 @@ struct FModularSaveGameHeader
 	FPackageFileVersion PackageFileUEVersion;
 	FEngineVersion SavedEngineVersion;
 	int32 CustomVersionFormat;
-	FCustomVersionContainer CustomVersions;
+	FCustomVersionContainer CustomVersions; // (i) Only the custom versions that were used while serializing the SaveGame.
 	FString SaveGameClassName;
 	FInstancedStruct CustomHeaderData;
 };
@@ -0,0 +1,163 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class ESaveLoadOperation : uint8
+{
+	Save,
+	Load,
+	RestoreSnapshot,
+	MAX
+};
+
+enum class ESaveLoadPhase : uint8
+{
+	Deferral,		// Autosave request was deferred until a low-load moment (see @USaveLoadBehavior::IsLowLoadMomentForAutosave).
+	QueueWait,		// Request waited in the queue of the @USaveGameService.
+	Capture,		// Game thread pushed data into the SaveGame (OnBeforeSaved).
+	Contribute,		// Asynchronous save contributions were prepared and written into the SaveGame (see @USaveGameService::AddSaveContributor).
+	Serialize,		// SaveGame was encoded into bytes (excluding compression).
+	Compress,		// Encoded bytes were (de-)compressed, if the serializer compresses.
+	IO,				// Bytes were written to or read from the storage.
+	Throttle,		// Part of IO: writes were paused to limit their bandwidth while streaming (see @FSaveGameWriteThrottle).
+	AssetPreload,	// Unloaded assets referenced by the read bytes were batch-loaded (see @USaveGameSerializer::AsyncDeserializeSaveGame).
+	Deserialize,	// Bytes were decoded into a SaveGame (excluding decompression).
+	Total,			// Whole operation, including queue wait (but excluding deferral).
+	MAX
+};
+
+WEEKENDSAVEGAME_API const TCHAR* LexToString(ESaveLoadOperation Operation);
+WEEKENDSAVEGAME_API const TCHAR* LexToString(ESaveLoadPhase Phase);
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Timings and byte count measured for a single save or load operation.
+ */
+struct WEEKENDSAVEGAME_API FSaveLoadMetrics
+{
+	using FSlotName = FString;
+
+	FSaveLoadMetrics() = default;
+	FSaveLoadMetrics(ESaveLoadOperation InOperation, const FSlotName& InSlotName) : Operation(InOperation), SlotName(InSlotName) {}
+
+	ESaveLoadOperation Operation = ESaveLoadOperation::Save;
+	FSlotName SlotName = FSlotName();
+	bool bSuccess = false;
+	int64 NumBytes = 0;
+	double StartTime = 0.0; // (i) Platform time when the operation was requested, used to measure the total time.
+	bool bSkippedWrite = false; // (i) Whether writing was skipped, because the content did not change.
+	TMap<FName, double> SecondsByModule = {}; // (i) Time spent on each module, if the serializer (de-)serializes modules separately.
+	TMap<FName, double> SecondsByContributor = {}; // (i) Time from calling each asynchronous save contributor until its contribution was written.
+
+	FORCEINLINE void SetPhaseTime(ESaveLoadPhase Phase, double Seconds) { PhaseTimes[static_cast<uint8>(Phase)] = Seconds; MeasuredPhases |= (1u << static_cast<uint8>(Phase)); }
+	FORCEINLINE void AddPhaseTime(ESaveLoadPhase Phase, double Seconds) { PhaseTimes[static_cast<uint8>(Phase)] += Seconds; MeasuredPhases |= (1u << static_cast<uint8>(Phase)); }
+	FORCEINLINE double GetPhaseTime(ESaveLoadPhase Phase) const { return PhaseTimes[static_cast<uint8>(Phase)]; }
+	/** @returns whether the phase ran during the operation, e.g. not IO when writing was skipped, or not Deferral for immediate saves. */
+	FORCEINLINE bool WasPhaseMeasured(ESaveLoadPhase Phase) const { return (MeasuredPhases & (1u << static_cast<uint8>(Phase))) != 0; }
+
+	FString ToString() const;
+
+private:
+	double PhaseTimes[static_cast<uint8>(ESaveLoadPhase::MAX)] = {};
+	uint32 MeasuredPhases = 0;
+	static_assert(static_cast<uint8>(ESaveLoadPhase::MAX) <= 32, "Too many phases for MeasuredPhases bit mask");
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Byte sizes of the parts of a serialized SaveGame, to find out what the save size is made of.
+ * Filled by the @USaveGameSerializer during serialization (see @UModularSaveGameSerializer).
+ */
+struct WEEKENDSAVEGAME_API FSaveGameSizeReport
+{
+	int64 TotalBytes = 0;
+	int64 HeaderBytes = 0;
+	TMap<FName, int64> BytesByModule = {};
+	TMap<FName, int64> BytesByLevelObjectClass = {}; // (i) Payload of the objects saved by @ULevelObjectRestorer modules.
+
+	void Reset();
+
+	/** @returns multi-line breakdown, sorted by size. */
+	FString ToString() const;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Latency histogram with logarithmic buckets (from 10us up to roughly one minute) and fixed memory.
+ * Percentiles are approximated with the upper bound of the bucket they fall into.
+ */
+struct WEEKENDSAVEGAME_API FSaveLoadLatencyHistogram
+{
+	static constexpr int32 NumBuckets = 40;
+
+	void Add(double Seconds);
+	void Reset();
+
+	/** @returns approximate latency (in seconds) below which given fraction (0..1) of all samples are. */
+	double GetPercentile(double Fraction) const;
+	FORCEINLINE double GetMean() const { return (NumSamples > 0 ? SumSeconds / NumSamples : 0.0); }
+	FORCEINLINE double GetMax() const { return MaxSeconds; }
+	FORCEINLINE int32 Num() const { return NumSamples; }
+
+private:
+	int32 Buckets[NumBuckets] = {};
+	int32 NumSamples = 0;
+	double SumSeconds = 0.0;
+	double MaxSeconds = 0.0;
+
+	static double GetBucketUpperBound(int32 BucketIndex);
+	static int32 GetBucketIndex(double Seconds);
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Aggregated metrics of all operations of one type (see @ESaveLoadOperation).
+ */
+struct WEEKENDSAVEGAME_API FSaveLoadOperationStats
+{
+	int32 NumOperations = 0;
+	int32 NumFailures = 0;
+	int64 TotalBytes = 0;
+	int32 NumSkippedWrites = 0;
+	int64 NumSkippedWriteBytes = 0;
+	TOptional<FSaveLoadMetrics> LastMetrics = {};
+
+	FORCEINLINE const FSaveLoadLatencyHistogram& GetHistogram(ESaveLoadPhase Phase) const { return PhaseHistograms[static_cast<uint8>(Phase)]; }
+	FORCEINLINE FSaveLoadLatencyHistogram& GetHistogram(ESaveLoadPhase Phase) { return PhaseHistograms[static_cast<uint8>(Phase)]; }
+
+private:
+	FSaveLoadLatencyHistogram PhaseHistograms[static_cast<uint8>(ESaveLoadPhase::MAX)] = {};
+};
+
+/**
+ * Aggregates @FSaveLoadMetrics into per-phase histograms for each operation type, which can be
+ * queried at runtime. Recorded metrics are also forwarded to the stats system ("stat SaveGame")
+ * and the CSV profiler (category "SaveGame"). Mainly used by @USaveGameService.
+ * Latencies are only sampled for phases that ran during successful operations, failed operations are only counted.
+ */
+struct WEEKENDSAVEGAME_API FSaveLoadMetricsRecorder
+{
+	void Record(const FSaveLoadMetrics& Metrics);
+	void Reset();
+
+	FORCEINLINE const FSaveLoadOperationStats& GetStats(ESaveLoadOperation Operation) const { return StatsByOperation[static_cast<uint8>(Operation)]; }
+
+	/** @returns multi-line summary of p50/p90/p99 latencies of all phases per operation. */
+	FString ToString() const;
+
+private:
+	FSaveLoadOperationStats StatsByOperation[static_cast<uint8>(ESaveLoadOperation::MAX)] = {};
+};
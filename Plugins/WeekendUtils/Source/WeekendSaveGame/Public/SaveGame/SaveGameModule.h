@@ -10,9 +10,35 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "SaveGame/SaveGameSchema.h"
 
 #include "SaveGameModule.generated.h"
 
+/**
+ * Base struct for lightweight SaveGame modules of the @UModularSaveGame, which are stored as @FInstancedStruct instead of UObjects.
+ * Suited for small modules that just hold a few values, since they are copied and serialized as plain struct data,
+ * without object allocation and GC overhead. Struct modules are registered by their struct name, unless registered by custom name.
+ */
+USTRUCT()
+struct WEEKENDSAVEGAME_API FSaveGameStructModule
+{
+	GENERATED_BODY()
+
+	virtual ~FSaveGameStructModule() = default;
+
+	/** Module version for potential compatibility checks. */
+	UPROPERTY(SaveGame, EditDefaultsOnly, Category = "Weekend Utils|Save Game")
+	int32 ModuleVersion = 0;
+
+	/** Called on the game thread before the module is being saved, before all SaveGame specified properties have been serialized. */
+	virtual void PreSaveModule() {}
+
+	/** Called on the game thread after the module was restored, after all SaveGame specified properties have been deserialized. */
+	virtual void PostRestoreModule() {}
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+
 /**
  * Base class for polymorphic SaveGame modules of the @UModularSaveGame.
  * Subclasses should override the @ModuleName in their constructor.
@@ -39,11 +65,52 @@ public:
 	UPROPERTY(SaveGame, EditDefaultsOnly, Category = "Weekend Utils|Save Game")
 	int32 ModuleVersion = 0;
 
+	/**
+	 * Whether the saved state of this module counts as content when detecting unchanged SaveGames.
+	 * Should be disabled for modules that change with every save without representing game state.
+	 */
+	bool bAffectsContentHash = true;
+
+	/**
+	 * Whether this module may be encoded and decoded on a worker thread, in parallel to other modules (see @UModularSaveGameSerializer).
+	 * (i) The game thread waits meanwhile, so reading game objects is fine - but nothing may be created, destroyed or broadcast.
+	 * Opt-in, since custom Serialize() overrides and delegates bound to the module are often not thread-safe. Enable it in the
+	 * constructor of modules that only serialize plain SaveGame properties.
+	 */
+	bool bSupportsParallelSerialization = false;
+
+	/**
+	 * Whether SaveGame properties of this module are serialized positionally through a compiled @FSaveGameSchema, instead of
+	 * tagged serialization that writes names and types of every property. Recommended for stable, plain-data heavy modules.
+	 * (i) Only affects saving, modules saved either way can always be loaded. Custom Serialize() overrides still work.
+	 */
+	bool bUseCompiledSchema = false;
+
+	/** @returns byte offset and size this module occupied in the archive it was most recently saved into (size is 0 if never saved). */
+	FORCEINLINE int64 GetLastSavedOffset() const { return LastSavedOffset; }
+	FORCEINLINE int64 GetLastSavedSize() const { return LastSavedSize; }
+
+	/** Called on the game thread before the module is encoded on another thread. Fires @PreSaveModule() ahead of serialization. */
+	void PreSaveModuleOnGameThread();
+
+	/** Called on the game thread after the module was decoded on another thread. Fires the deferred @PostRestoreModule(). */
+	void PostRestoreModuleOnGameThread();
+
+	/** Makes the next Serialize() call use given schema for all SaveGame properties (see @bUseCompiledSchema). */
+	void SetSchemaForNextSerialize(const FSaveGameSchema* Schema, const TArray<FSaveGameSchemaField>* SavedSchemaFields = nullptr);
+
 	// - UObject
 	virtual void Serialize(FArchive& Ar) override;
 	// --
 
 protected:
+	int64 LastSavedOffset = 0;
+	int64 LastSavedSize = 0;
+	bool bPreSavedOnGameThread = false;
+	bool bPostRestorePending = false;
+	const FSaveGameSchema* NextSerializeSchema = nullptr;
+	const TArray<FSaveGameSchemaField>* NextSerializeSavedSchemaFields = nullptr;
+
 	/** Called before the module is being saved, before all SaveGame specified properties have been serialized. */
 	virtual void PreSaveModule() { OnBeforeModuleSaved.Broadcast(); }
 
@@ -53,17 +120,65 @@ protected:
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
+inline void USaveGameModule::PreSaveModuleOnGameThread()
+{
+	check(IsInGameThread());
+	PreSaveModule();
+	bPreSavedOnGameThread = true;
+}
+
+inline void USaveGameModule::PostRestoreModuleOnGameThread()
+{
+	check(IsInGameThread());
+	if (bPostRestorePending)
+	{
+		bPostRestorePending = false;
+		PostRestoreModule();
+	}
+}
+
+inline void USaveGameModule::SetSchemaForNextSerialize(const FSaveGameSchema* Schema, const TArray<FSaveGameSchemaField>* SavedSchemaFields)
+{
+	NextSerializeSchema = Schema;
+	NextSerializeSavedSchemaFields = SavedSchemaFields;
+}
+
 inline void USaveGameModule::Serialize(FArchive& Ar)
 {
 	if (Ar.ArIsSaveGame && Ar.IsSaving())
 	{
-		PreSaveModule();
+		if (!bPreSavedOnGameThread)
+		{
+			PreSaveModule();
+		}
+		bPreSavedOnGameThread = false;
 	}
 
-	Super::Serialize(Ar);
+	const int64 StartOffset = Ar.Tell();
+	if (NextSerializeSchema)
+	{
+		NextSerializeSchema->SerializeContainer(Ar, this, NextSerializeSavedSchemaFields);
+		NextSerializeSchema = nullptr;
+		NextSerializeSavedSchemaFields = nullptr;
+	}
+	else
+	{
+		Super::Serialize(Ar);
+	}
+
+	if (Ar.ArIsSaveGame && Ar.IsSaving())
+	{
+		LastSavedOffset = StartOffset;
+		LastSavedSize = (Ar.Tell() - StartOffset);
+	}
 
 	if (Ar.ArIsSaveGame && Ar.IsLoading())
 	{
-		PostRestoreModule();
+		// (i) Modules decoded on worker threads are notified later, on the game thread (see PostRestoreModuleOnGameThread).
+		bPostRestorePending = !IsInGameThread();
+		if (!bPostRestorePending)
+		{
+			PostRestoreModule();
+		}
 	}
 }
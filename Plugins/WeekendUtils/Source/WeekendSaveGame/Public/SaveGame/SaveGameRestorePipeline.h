@@ -0,0 +1,89 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SaveGame/CurrentSaveGame.h"
+
+enum class ESaveGameRestoreTier : uint8
+{
+	Critical,	// Restored in the same frame as the SaveGame, before the first playable frame.
+	Gameplay,	// Restored over the following frames, within the restore frame budget.
+	Deferred,	// Restored last, within the restore frame budget. Meant for cosmetic restoration that nothing else depends on.
+	MAX
+};
+
+WEEKENDSAVEGAME_API const TCHAR* LexToString(ESaveGameRestoreTier Tier);
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Staged restoration of a SaveGame after it was loaded. Listeners register with a @ESaveGameRestoreTier and a priority.
+ * The critical tier is restored right away, while all other tiers are processed in order across frames under a time budget.
+ * Mainly used by @USaveGameService, which begins the pipeline after every restore and processes it every tick.
+ */
+struct WEEKENDSAVEGAME_API FSaveGameRestorePipeline
+{
+	DECLARE_DELEGATE_OneParam(FRestoreStep, const FCurrentSaveGame&)
+
+	/** Event fired when all listeners of a tier have been restored. Fired for every tier, even if no listeners are registered for it. */
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FOnTierRestored, ESaveGameRestoreTier, const FCurrentSaveGame&)
+	FOnTierRestored OnTierRestored;
+
+	/** Registers a listener that is called for every restored SaveGame. Listeners with higher priority are restored first within their tier. */
+	FDelegateHandle Add(ESaveGameRestoreTier Tier, const FRestoreStep& Step, int32 Priority = 0);
+	void Remove(const FDelegateHandle& Handle);
+	void RemoveAll(const void* UserObject);
+
+	/** Starts restoring given SaveGame and restores the critical tier right away. A restore that is still running is cancelled. */
+	void Begin(const FCurrentSaveGame& SaveGame);
+
+	/** Continues restoring until the time budget is used up. At least one listener is restored per call, so the pipeline always progresses. */
+	void Process(double TimeBudget);
+
+	/** Restores all remaining tiers right away. */
+	void Flush();
+
+	/** Stops restoring without calling the remaining listeners. */
+	void Cancel();
+
+	FORCEINLINE bool IsRunning() const { return bIsRunning; }
+	FORCEINLINE ESaveGameRestoreTier GetCurrentTier() const { return CurrentTier; }
+
+	/** @returns seconds from the beginning of the most recent restore until given tier was restored - or a negative value, if not restored yet. */
+	FORCEINLINE double GetSecondsUntilTierRestored(ESaveGameRestoreTier Tier) const { return SecondsUntilTierRestored[static_cast<uint8>(Tier)]; }
+
+private:
+	struct FListener
+	{
+		FDelegateHandle Handle;
+		FRestoreStep Step;
+		ESaveGameRestoreTier Tier = ESaveGameRestoreTier::Critical;
+		int32 Priority = 0;
+	};
+
+	/** All registered listeners, sorted by tier and priority. */
+	TArray<FListener> Listeners = {};
+
+	/** Listeners of the running restore, in order. Listeners registered meanwhile only take part in the next restore. */
+	TArray<FListener> PendingListeners = {};
+	int32 NextListenerIndex = 0;
+
+	FCurrentSaveGame SaveGame;
+	ESaveGameRestoreTier CurrentTier = ESaveGameRestoreTier::Critical;
+	bool bIsRunning = false;
+	uint32 RestoreSerial = 0; // (i) Changes with every begin or cancel, so listeners can safely start another restore.
+	double BeginTime = 0.0;
+	double SecondsUntilTierRestored[static_cast<uint8>(ESaveGameRestoreTier::MAX)] = { -1.0, -1.0, -1.0 };
+
+	/** @returns whether there are any listeners left to restore. */
+	bool RestoreNextListener();
+	void FinishTiersUpTo(ESaveGameRestoreTier Tier);
+};
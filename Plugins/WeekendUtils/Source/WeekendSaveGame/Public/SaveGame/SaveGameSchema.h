@@ -0,0 +1,74 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Description of a single SaveGame property within a @FSaveGameSchema, which is stored along with positionally serialized data.
+ * Nested structs without native serialization are flattened into their members (e.g. "Stats.Health").
+ */
+struct WEEKENDSAVEGAME_API FSaveGameSchemaField
+{
+	FString Name;
+	FString Type;
+	int32 Size = 0;
+	bool bIsPlainData = false; // (i) Plain data is copied as raw bytes, everything else is serialized with a size prefix.
+
+	friend FArchive& operator<<(FArchive& Ar, FSaveGameSchemaField& Field);
+};
+
+/**
+ * Flat list of serialization operations, compiled from the SaveGame properties (see CPF_SaveGame) of a class or struct.
+ * Values are written and read positionally, without the property names and types that tagged serialization writes for
+ * every single property. Adjacent plain data properties are merged into single memory blocks.
+ * Data is only read positionally if the schema hash matches the one it was saved with. Otherwise, the saved fields are
+ * matched with the current ones by name and type, like tagged serialization does, and unknown fields are skipped.
+ * Schemas are compiled once per class or struct and cached (see @FindOrCompile), which is thread-safe.
+ */
+class WEEKENDSAVEGAME_API FSaveGameSchema
+{
+public:
+	/** @returns the cached schema of given class or struct, which is compiled on first use. */
+	static const FSaveGameSchema& FindOrCompile(const UStruct& Struct);
+
+	/** Compiles schemas ahead of time, so they are not compiled during the first save or load. */
+	static void Precompile(const TArray<const UStruct*>& Structs);
+
+	/** Discards all cached schemas, e.g. after classes have been recompiled. */
+	static void ResetCache();
+
+	/** @returns hash of the field layout, never 0. */
+	FORCEINLINE uint64 GetHash() const { return Hash; }
+	FORCEINLINE const TArray<FSaveGameSchemaField>& GetFields() const { return Fields; }
+
+	/**
+	 * Serializes the SaveGame properties of given container (object or struct memory) positionally.
+	 * @param SavedFields (loading only) the fields the data was saved with, if they differ from this schema.
+	 */
+	void SerializeContainer(FArchive& Ar, void* Container, const TArray<FSaveGameSchemaField>* SavedFields = nullptr) const;
+
+private:
+	struct FOperation
+	{
+		const FProperty* Property = nullptr; // (i) nullptr for plain memory blocks.
+		int32 Offset = 0; // (i) Offset of the memory block, or of the container that owns the property.
+		int32 Size = 0;
+	};
+
+	TArray<FSaveGameSchemaField> Fields;
+	TArray<FOperation> FieldOperations; // (i) One operation per field, to match saved fields individually.
+	TArray<FOperation> Operations; // (i) Plain data fields merged into blocks, for positional serialization.
+	uint64 Hash = 0;
+
+	void Compile(const UStruct& Struct);
+	void AddFields(const UStruct& Struct, int32 ContainerOffset, const FString& NamePrefix);
+	static void SerializeOperation(FArchive& Ar, uint8* Container, const FOperation& Operation);
+};
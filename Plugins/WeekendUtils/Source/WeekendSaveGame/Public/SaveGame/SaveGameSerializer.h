@@ -11,11 +11,30 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "SaveGame/SaveGameMetrics.h"
+#include "SaveGame/SaveGameBufferPool.h"
+#include "SaveGame/SaveGameChunkStore.h"
+#include "SaveGame/SaveGameSlotManifest.h"
+#include "SaveGame/SaveGameStorageBackend.h"
 #include "Serialization/ObjectAndNameAsStringProxyArchive.h"
 
 #include "SaveGameSerializer.generated.h"
 
 class USaveGame;
+struct FStreamableManager;
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Proxy archive that serializes UObjects and FNames as string data, like its base.
+ * While saving, it collects the paths of all referenced assets, so they can be preloaded before loading.
+ */
+struct WEEKENDSAVEGAME_API FWeekendUtilsAssetCollectingProxyArchive : FObjectAndNameAsStringProxyArchive
+{
+	FWeekendUtilsAssetCollectingProxyArchive(FArchive& InInnerArchive, bool bInLoadIfFindFails, TSet<FString>& InReferencedAssetPaths);
+	virtual FArchive& operator<<(UObject*& Obj) override;
+	TSet<FString>& ReferencedAssetPaths;
+};
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
@@ -23,16 +42,50 @@ class USaveGame;
  * Extends a proxy archive that serializes UObjects and FNames as string data.
  * Recursively serializes sub-objects nested inside serialized objects and restores
  * them by allocating them via NewObject<T>().
+ * Each sub-object is written only once into an identity table, further references to it are written as back-references,
+ * so sub-objects that are shared between multiple properties are restored as a single shared instance.
+ * While saving, it collects the paths of all referenced assets, so they can be preloaded before loading.
  */
 struct WEEKENDSAVEGAME_API FWeekendUtilsSubobjectProxyArchive : FObjectAndNameAsStringProxyArchive
 {
 	FWeekendUtilsSubobjectProxyArchive(FArchive& InInnerArchive, UObject& InSubobjectOwner, bool bInLoadIfFindFails = true);
 	virtual FArchive& operator<<(UObject*& Obj) override;
 	UObject& SubobjectOwner;
+	TSet<FString> ReferencedAssetPaths;
+
+	/** Whether sub-objects are written into the identity table. Disable to read data written without it, which inlines every reference. */
+	bool bUseObjectIdentityTable = true;
+
+private:
+	TArray<UObject*> SubobjectTable;
+	TMap<UObject*, int32> SubobjectIndices;
+
+	void SerializeWithIdentityTable(UObject*& Obj);
+	void SerializeInline(UObject*& Obj);
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * Cooperative cancellation flag of a single save or load operation, shared between the @USaveGameService
+ * and the async work of the @USaveGameSerializer. The work checks it at safe points and stops early once cancelled.
+ * (i) A file write that already started is never interrupted, since that could leave a corrupted save file behind.
+ */
+class FSaveLoadCancellationToken
+{
+public:
+	void Cancel() { bCancelled = true; }
+	bool IsCancelled() const { return bCancelled; }
+
+	static bool IsCancelled(const TSharedPtr<FSaveLoadCancellationToken, ESPMode::ThreadSafe>& Token) { return (Token.IsValid() && Token->IsCancelled()); }
+
+private:
+	std::atomic<bool> bCancelled = false;
+};
+using FSaveLoadCancellationTokenPtr = TSharedPtr<FSaveLoadCancellationToken, ESPMode::ThreadSafe>;
+
+///////////////////////////////////////////////////////////////////////////////////////
+
 /**
  * Polymorphic sub-object of @USaveGameService that extracts implementation details of
  * SaveGame serialization, deserialization, and save file management.
@@ -48,19 +101,127 @@ public:
 
 	DECLARE_DELEGATE_ThreeParams(FOnAsyncSaveCompleted, const FSlotName&, const int32, bool);
 	DECLARE_DELEGATE_ThreeParams(FOnAsyncLoadCompleted, const FSlotName&, const int32, USaveGame*);
+	DECLARE_DELEGATE_FourParams(FOnAsyncLoadDataCompleted, const FSlotName&, const int32, bool, const TArray<uint8>&);
+	DECLARE_DELEGATE_OneParam(FOnAsyncDeserializeCompleted, USaveGame*);
+	DECLARE_DELEGATE_ThreeParams(FOnAsyncReadSlotHeaderCompleted, const FSlotName&, bool, const FSaveGameSlotManifestEntry&);
 
 	virtual bool TrySerializeSaveGame(USaveGame& InSaveGameObject, TArray<uint8>& OutSaveData) const;
 	virtual bool TryDeserializeSaveGame(const TArray<uint8>& InSaveData, USaveGame*& OutSaveGameObject) const;
+	/**
+	 * Deserializes given save data, after all unloaded assets it references were loaded asynchronously in a single batch.
+	 * Completes synchronously, if there is nothing to preload. Cancelling skips the deserialization and reports failure.
+	 */
+	virtual void AsyncDeserializeSaveGame(const TArray<uint8>& InSaveData, FOnAsyncDeserializeCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken = nullptr);
+	/** Collects the assets referenced by given save data that are not loaded yet. Not supported for the default UE save game format. */
+	virtual void GetUnloadedReferencedAssets(const TArray<uint8>& InSaveData, TArray<FSoftObjectPath>& OutAssetPaths) const {}
+	/**
+	 * Serializes given SaveGame into a pooled buffer only to measure its size (see @TrySerializeSaveGame), e.g. for debugging.
+	 * Keeps the results of the last actual serialization, like @GetLastContentHash, which skipping unchanged writes relies on.
+	 */
+	FSaveGameSizeReport MeasureSaveGameSize(USaveGame& InSaveGameObject) const;
 
 	virtual bool DoesSaveGameExist(const FSlotName& SlotName, const int32 UserIndex) const;
 
 	virtual bool TrySaveDataToSlot(const TArray<uint8>& InSaveData, const FSlotName& SlotName, const int32 UserIndex);
 	virtual bool TrySaveGameToSlot(USaveGame& SaveGameObject, const FSlotName& SlotName, const int32 UserIndex);
-	virtual void AsyncSaveGameToSlot(USaveGame& SaveGameObject, const FSlotName& SlotName, const int32 UserIndex, FOnAsyncSaveCompleted Callback);
+	/** Serializes and asynchronously writes given SaveGame into given slot. Cancelling skips the work that didn't start yet and reports failure. */
+	virtual void AsyncSaveGameToSlot(USaveGame& SaveGameObject, const FSlotName& SlotName, const int32 UserIndex, FOnAsyncSaveCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken = nullptr, ESaveGameIOPriority Priority = ESaveGameIOPriority::Normal);
+	/** Asynchronously writes already serialized save data (see @TrySerializeSaveGame) into given slot. Cancelling skips the write, if it didn't start yet. */
+	virtual void AsyncSaveDataToSlot(const TSharedRef<TArray<uint8>>& InSaveData, const FSlotName& SlotName, const int32 UserIndex, FOnAsyncSaveCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken = nullptr, ESaveGameIOPriority Priority = ESaveGameIOPriority::Normal);
 
 	virtual bool TryLoadDataFromSlot(const FSlotName& SlotName, const int32 UserIndex, TArray<uint8>& OutSaveData);
 	virtual bool TryLoadGameFromSlot(const FSlotName& SlotName, const int32 UserIndex, USaveGame*& OutSaveGameObject);
-	virtual void AsyncLoadGameFromSlot(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncLoadCompleted Callback);
+	/** Asynchronously reads and deserializes the SaveGame in given slot. Cancelling skips the deserialization and reports failure. */
+	virtual void AsyncLoadGameFromSlot(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncLoadCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken = nullptr, ESaveGameIOPriority Priority = ESaveGameIOPriority::Normal);
+	/** Asynchronously reads serialized save data (see @TryDeserializeSaveGame) from given slot. Cancelling discards the data and reports failure. */
+	virtual void AsyncLoadDataFromSlot(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncLoadDataCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken = nullptr, ESaveGameIOPriority Priority = ESaveGameIOPriority::Normal);
 
 	virtual bool TryDeleteGameInSlot(const FSlotName& SlotName, const int32 UserIndex, TOptional<FString> OptionalBackupFolder = {});
+
+	/** @returns header information of the save file in given slot, preferably read from the slot manifest instead of the save file. */
+	virtual bool TryReadSlotHeader(const FSlotName& SlotName, const int32 UserIndex, FSaveGameSlotManifestEntry& OutEntry);
+	/** @returns header information of existing save files in given slots, using a single read of the slot manifest where possible. */
+	virtual TMap<FSlotName, FSaveGameSlotManifestEntry> ReadSlotHeaders(const TSet<FSlotName>& SlotNames, const int32 UserIndex);
+	/** Asynchronously reads the header of the save file in given slot, without reading the whole save file where possible. Always reads the save file, not the slot manifest. */
+	virtual void AsyncReadSlotHeader(const FSlotName& SlotName, const int32 UserIndex, FOnAsyncReadSlotHeaderCompleted Callback, ESaveGameIOPriority Priority = ESaveGameIOPriority::Normal);
+	/** Extracts header information from serialized save data. Not supported for the default UE save game format. */
+	virtual bool TryReadHeaderFromSaveData(const TArray<uint8>& InSaveData, FSaveGameSlotManifestEntry& OutEntry) const { return false; }
+
+	/**
+	 * Checks that all chunks referenced by save files (including backups) exist and are intact (see @FSaveGameChunkStore::VerifyIntegrity).
+	 * When repairing, reference counts are rebuilt from the save files and unreferenced chunks are deleted, which also cleans up
+	 * after slots that were overwritten or deleted while the chunk store was disabled.
+	 */
+	FSaveGameChunkStoreIntegrityReport VerifyChunkStoreIntegrity(bool bRepair = true);
+
+	/** Limits the bandwidth of asynchronous writes below high priority, e.g. while streaming (see @USaveGameService::UpdateWriteThrottle). */
+	FORCEINLINE FSaveGameWriteThrottle& GetWriteThrottle() const { return *WriteThrottle; }
+
+	/** Reuses the byte arrays of encoded SaveGames across save and load operations. Lazily created with the budget from @USaveGameServiceSettings. */
+	TSharedRef<FSaveGameBufferPool> GetBufferPool() const;
+
+	/** @returns time (in seconds) spent on (de-)compression during the last (de-)serialization, if this serializer compresses data. */
+	FORCEINLINE double GetLastCompressionTime() const { return LastCompressionTime; }
+	/** @returns time (in seconds) spent waiting for referenced assets to load during the last @AsyncDeserializeSaveGame. */
+	FORCEINLINE double GetLastAssetPreloadTime() const { return LastAssetPreloadTime; }
+	/** @returns time (in seconds) spent on each module during the last (de-)serialization, if this serializer handles modules separately. */
+	FORCEINLINE const TMap<FName, double>& GetLastModuleTimes() const { return LastModuleTimes; }
+	/**
+	 * @returns hash of the game state contained in the last serialized SaveGame (see @TrySerializeSaveGame).
+	 * Used to detect unchanged SaveGames, so serializers may exclude volatile data, like save counters or timestamps.
+	 */
+	FORCEINLINE TOptional<uint64> GetLastContentHash() const { return LastContentHash; }
+	/** @returns byte sizes of the parts of the last serialized SaveGame (see @TrySerializeSaveGame). */
+	FORCEINLINE const FSaveGameSizeReport& GetLastSizeReport() const { return LastSizeReport; }
+
+protected:
+	mutable double LastCompressionTime = 0.0;
+	mutable TMap<FName, double> LastModuleTimes;
+	double LastAssetPreloadTime = 0.0;
+	mutable TOptional<uint64> LastContentHash = {};
+	mutable FSaveGameSizeReport LastSizeReport;
+
+	/** Batch-loads referenced assets ahead of deserialization, see @AsyncDeserializeSaveGame(). Lazily created. */
+	TSharedPtr<FStreamableManager> StreamableManager = nullptr;
+
+	/** Mirrors the headers of all save files. Lazily loaded, see @GetSlotManifest(). */
+	TOptional<FSaveGameSlotManifest> SlotManifest = {};
+
+	/** Reads and writes save files. Lazily created, see @GetStorageBackend(). */
+	TSharedPtr<ISaveGameStorageBackend> StorageBackend = nullptr;
+	/** Shared with the worker threads of asynchronous writes, which may outlive this serializer. */
+	const TSharedRef<FSaveGameWriteThrottle> WriteThrottle = MakeShared<FSaveGameWriteThrottle>();
+
+	/** Lazily created, see @GetBufferPool(). Shared with worker threads and everybody holding its buffers, which may outlive this serializer. */
+	mutable TSharedPtr<FSaveGameBufferPool> BufferPool = nullptr;
+
+	/** Stores the chunks of all save files, when enabled. Lazily created, see @GetChunkStore(). Shared with worker threads that read and write chunks. */
+	TSharedPtr<FSaveGameChunkStore> ChunkStore = nullptr;
+	/** Chunks written by worker threads are unreferenced until the slot file is written, so garbage collection has to wait for them. */
+	int32 NumChunkWritesInFlight = 0;
+
+	virtual FString GetSlotFilePath(const FSlotName& SlotName) const;
+	virtual FString GetSlotManifestFilePath() const;
+	virtual FString GetChunkStoreDirectory() const;
+	virtual bool IsSlotManifestEnabled() const;
+	virtual bool IsChunkStoreEnabled() const;
+
+	/** Creates the backend that save files are read and written with. Accesses files directly where the generic @ISaveGameSystem is used (if enabled), otherwise through the @ISaveGameSystem. */
+	virtual TSharedRef<ISaveGameStorageBackend> CreateStorageBackend() const;
+	ISaveGameStorageBackend& GetStorageBackend();
+
+	/** Reads the header of the save file in given slot, without reading the whole save file where possible. */
+	virtual bool TryReadHeaderFromSlotFile(const FSlotName& SlotName, const int32 UserIndex, FSaveGameSlotManifestEntry& OutEntry);
+
+	FSaveGameSlotManifest& GetSlotManifest();
+	void UpdateSlotManifest(const FSlotName& SlotName, const TArray<uint8>& InSaveData);
+	void RemoveFromSlotManifest(const FSlotName& SlotName);
+
+	TSharedRef<FSaveGameChunkStore> GetChunkStore();
+	bool TrySaveDataToSlotAsChunks(const TArray<uint8>& InSaveData, const FSlotName& SlotName, const int32 UserIndex);
+	void AsyncSaveDataToSlotAsChunks(const TSharedRef<TArray<uint8>>& InSaveData, const FSlotName& SlotName, const int32 UserIndex, FOnAsyncSaveCompleted Callback, const FSaveLoadCancellationTokenPtr& CancellationToken, ESaveGameIOPriority Priority);
+	/** Releases the chunks of a replaced or failed slot file and deletes the ones that aren't referenced anymore. */
+	void ReleaseChunkReferences(const FSaveGameChunkList& ChunkList);
+	/** @returns chunk lists of all save files (including backups in sub-directories) by file path. */
+	TMap<FString, FSaveGameChunkList> ReadAllChunkLists() const;
 };
@@ -11,14 +11,21 @@
 
 #include "CoreMinimal.h"
 #include "CurrentSaveGame.h"
+#include "Engine/EngineBaseTypes.h"
 #include "GameFramework/SaveGame.h"
 #include "GameService/GameServiceBase.h"
+#include "SaveGame/SaveGameDebugHistory.h"
+#include "SaveGame/SaveGameMetrics.h"
+#include "SaveGame/SaveGameRestorePipeline.h"
+#include "SaveGame/SaveGameSerializer.h"
+#include "SaveGame/SaveGameSlotManifest.h"
+#include "SaveGame/SaveGameSnapshotRing.h"
+#include "UObject/Package.h"
 
 #include "SaveGameService.generated.h"
 
 class USaveGame;
 class USaveGameDataProcessor;
-class USaveGameSerializer;
 class USaveGameServiceSettings;
 class USaveLoadBehavior;
 
@@ -56,6 +63,7 @@ public:
 	};
 
 	DECLARE_DELEGATE_TwoParams(FOnSaveLoadCompleted, USaveGame*, bool /*bSuccess*/)
+	DECLARE_DELEGATE_TwoParams(FOnMultiSlotSaveCompleted, USaveGame*, const TMap<FSlotName, bool>& /*bSuccessBySlot*/)
 	DECLARE_DELEGATE_TwoParams(FOnPreloadCompleted, TArray<USaveGame*>, TArray<FSlotName>)
 
 	USaveGameService()
@@ -86,16 +94,34 @@ public:
 	/** Event fired right before the current SaveGame is saved. Last chance to push data into the SaveGame. */
 	FCurrentSaveGame::FOnBeforeSaved OnBeforeSaved;
 
+	/**
+	 * Registers an asynchronous contributor that is called on the game thread right after @OnBeforeSaved, for data that is expensive to prepare.
+	 * Contributors should copy the data they need and prepare it on worker threads, without touching the SaveGame. The save waits for all
+	 * returned futures without blocking the game thread (see @USaveGameServiceSettings::SaveContributionTimeout), then calls the resulting writers in registration order before encoding the SaveGame.
+	 */
+	FDelegateHandle AddSaveContributor(const FName& ContributorName, const FCurrentSaveGame::FOnContributeToSave& Contributor);
+	void RemoveSaveContributor(const FDelegateHandle& Handle);
+	void RemoveAllSaveContributors(const void* UserObject);
+
 	/** Event fired right after the current SaveGame was saved. */
 	FCurrentSaveGame::FOnAfterSaved OnAfterSaved;
 
-	/** Event fired right after the current SaveGame was restored. */
+	/** Event fired right after the current SaveGame was restored. All listeners are called within the same frame. */
 	FCurrentSaveGame::FOnAfterRestored OnAfterRestored;
 
+	/**
+	 * Staged restoration that begins right after @OnAfterRestored. Listeners that are not critical for the first playable frame
+	 * should register here with a later tier, so they are restored across the following frames (see @USaveGameServiceSettings::RestoreFrameBudget).
+	 */
+	FSaveGameRestorePipeline RestorePipeline;
+
 	///////////////////////////////////////////////////////////////////////////////////////
 	/// REQUESTS
 
-	/** Asynchronously save the current state of the game into the Autosave file slot. */
+	/**
+	 * Asynchronously save the current state of the game into the Autosave file slot.
+	 * Can be deferred until a low-load moment and merged with repeated requests (see @USaveGameServiceSettings::AutosaveMaxDeferral).
+	 */
 	FAsyncSaveGameHandle RequestAutosave(const FDebugContext& Context);
 	FAsyncSaveGameHandle RequestAutosave(const FDebugContext& Context, const FOnSaveLoadCompleted& Callback);
 
@@ -103,6 +129,15 @@ public:
 	FAsyncSaveGameHandle RequestSaveCurrentSaveGameToSlot(const FDebugContext& Context, const FSlotName& SlotName);
 	FAsyncSaveGameHandle RequestSaveCurrentSaveGameToSlot(const FDebugContext& Context, const FSlotName& SlotName, const FOnSaveLoadCompleted& Callback);
 
+	/**
+	 * Asynchronously save the current state of the game into several SaveGame file slots, e.g. a slot and its backup.
+	 * The SaveGame is captured and encoded only once, then the same data is written into every slot. Pending save requests
+	 * for any of these slots (including deferred autosaves) are completed by the same save, each with the result of its own slot.
+	 * The callback reports the success of every slot individually.
+	 */
+	FAsyncSaveGameHandle RequestSaveCurrentSaveGameToSlots(const FDebugContext& Context, const TArray<FSlotName>& SlotNames);
+	FAsyncSaveGameHandle RequestSaveCurrentSaveGameToSlots(const FDebugContext& Context, const TArray<FSlotName>& SlotNames, const FOnMultiSlotSaveCompleted& Callback);
+
 	/** Asynchronously load and restore a SaveGame file as current SaveGame from given slot. */
 	FAsyncLoadGameHandle RequestLoadCurrentSaveGameFromSlot(const FDebugContext& Context, const FSlotName& SlotName);
 	FAsyncLoadGameHandle RequestLoadCurrentSaveGameFromSlot(const FDebugContext& Context, const FSlotName& SlotName, const FOnSaveLoadCompleted& Callback);
@@ -114,14 +149,23 @@ public:
 	FAsyncLoadGameHandle RequestLoadAndTravelIntoCurrentSaveGameFromSlot(const FDebugContext& Context, const FSlotName& SlotName);
 	FAsyncLoadGameHandle RequestLoadAndTravelIntoCurrentSaveGameFromSlot(const FDebugContext& Context, const FSlotName& SlotName, const FOnSaveLoadCompleted& Callback);
 
+	/** @returns whether the level of a pending load-and-travel request is kept loaded ahead of the travel (see @USaveGameServiceSettings::bOverlapLoadWithTravel). */
+	FORCEINLINE bool IsPrefetchingTravelDestination() const { return TravelPrefetch.IsSet(); }
+
 	/** @returns whether a given save request handle is still active (pending or being processed). */
 	bool IsSaveRequestAlive(const FAsyncSaveGameHandle& Handle) const;
 	/** @returns whether a given load request handle is still active (pending or being processed). */
 	bool IsLoadRequestAlive(const FAsyncLoadGameHandle& Handle) const;
 
-	/** Cancel an active save request by handle. Nothing happens if the request does not exist (anymore). */
+	/**
+	 * Cancel an active save request by handle. Nothing happens if the request does not exist (anymore).
+	 * When no other request waits for the save in progress, its remaining work is skipped, unless the file write already started.
+	 */
 	void CancelSaveRequest(const FAsyncSaveGameHandle& Handle);
-	/** Cancel an active load request by handle. Nothing happens if the request does not exist (anymore). */
+	/**
+	 * Cancel an active load request by handle. Nothing happens if the request does not exist (anymore).
+	 * When no other request waits for the load in progress, it is aborted right away and its loaded data will not be deserialized.
+	 */
 	void CancelLoadRequest(const FAsyncLoadGameHandle& Handle);
 
 	/**
@@ -143,7 +187,10 @@ public:
 
 	/** Sets and restores an already loaded SaveGame as current SaveGame. */
 	virtual void RestoreAsCurrentSaveGame(USaveGame& SaveGame, TOptional<FSlotName> LoadedFromSlotName = {});
-	/** Sets and restores an already loaded SaveGame as current SaveGame. Afterwards, travel into the level stored in the SaveGame. */
+	/**
+	 * Sets and restores an already loaded SaveGame as current SaveGame. Afterwards, travel into the level stored in the SaveGame.
+	 * (i) With @USaveGameServiceSettings::bOverlapLoadWithTravel, the restore is applied (and @OnAfterRestored broadcast) once the new world has begun play.
+	 */
 	virtual void RestoreAsAndTravelIntoCurrentSaveGame(USaveGame& SaveGame, TOptional<FSlotName> LoadedFromSlotName = {});
 	/** Travel into the level that is stored in the current SaveGame. @returns whether this was successful. */
 	virtual bool TryTravelIntoCurrentSaveGame();
@@ -185,7 +232,15 @@ public:
 	FORCEINLINE const FCurrentSaveGame& GetCurrentSaveGame() const { return CurrentSaveGame; }
 	FORCEINLINE virtual uint32 GetCurrentUserIndex() const { return 0; }
 	FORCEINLINE EStatus GetCurrentStatus() const { return CurrentStatus; }
-	FORCEINLINE TArray<FString> GetDebugHistory() const { return DebugHistory; }
+	/** @returns structured history of recent operations. Use @FSaveLoadDebugHistory::FormatMostRecent to display it. */
+	FORCEINLINE const FSaveLoadDebugHistory& GetDebugHistory() const { return DebugHistory; }
+	/** @returns aggregated per-phase latencies and byte counts of all save and load operations so far. */
+	FORCEINLINE const FSaveLoadMetricsRecorder& GetSaveLoadMetrics() const { return SaveLoadMetrics; }
+	/**
+	 * Serializes the current SaveGame without writing it anywhere. @returns the byte sizes of its parts (header, modules, level objects).
+	 * (!) Like saving, this fires the pre-save callbacks of all modules (see @USaveGameModule::PreSaveModule), which may update the current SaveGame.
+	 */
+	virtual FSaveGameSizeReport MeasureCurrentSaveGameSize();
 
 	virtual bool IsAutosavingAllowed() const;
 	virtual bool IsSavingAllowed() const;
@@ -194,10 +249,17 @@ public:
 	virtual bool IsBusyLoading() const;
 	virtual bool IsBusySaving() const;
 	virtual bool IsBusySavingOrLoading() const;
+	/** @returns whether autosave requests are waiting for a low-load moment. */
+	FORCEINLINE bool HasDeferredAutosave() const { return !DeferredAutosave.Requests.IsEmpty(); }
 
 	virtual FSlotName GetAutosaveSlotName() const;
 	virtual TOptional<FSlotName> GetMostRecentlySavedSlotName() const;
 	virtual bool DoesSaveFileExist(const FSlotName& SlotName) const;
+	/**
+	 * @returns header information of existing save files in given slots, without loading the whole save games (see @FSaveGameSlotManifest).
+	 * (i) Slot lists (see @USaveGameListViewModel) still preload the whole save games, because their widgets bind to the SaveGame objects.
+	 */
+	virtual TMap<FSlotName, FSaveGameSlotManifestEntry> GetSaveGameSlotHeaders(const TSet<FSlotName>& SlotNames) const;
 	virtual TSet<FSlotName> GetSlotNamesAllowedForSaving() const;
 	virtual TSet<FSlotName> GetSlotNamesAllowedForLoading() const;
 
@@ -209,6 +271,33 @@ public:
 	bool IsCachedSaveGameSnapshot(const USaveGame& SaveGameObject) const;
 	bool HasAnyCachedSaveGameSnapshot() const;
 
+	///////////////////////////////////////////////////////////////////////////////////////
+	/// IN-MEMORY SNAPSHOTS
+
+	/** @returns handles of the encoded SaveGames that were recently saved and are kept in memory, most recent first. */
+	TArray<FSaveGameSnapshotHandle> GetInMemorySnapshotHandles() const;
+	const FSaveGameSnapshot* FindInMemorySnapshot(const FSaveGameSnapshotHandle& Handle) const;
+
+	/**
+	 * Restores an in-memory snapshot as current SaveGame, without any disk I/O. Processed like a load request of the snapshot's slot
+	 * (see @RequestLoadCurrentSaveGameFromSlot), which decodes the snapshot instead of reading the slot. @returns whether restoring was allowed and started.
+	 */
+	virtual bool TryRestoreInMemorySnapshot(const FSaveGameSnapshotHandle& Handle, const FDebugContext& Context, const FOnSaveLoadCompleted& Callback = FOnSaveLoadCompleted());
+	/** Restores the most recent in-memory snapshot as current SaveGame, without any disk I/O (see @TryRestoreInMemorySnapshot). */
+	virtual bool TryRestoreMostRecentInMemorySnapshot(const FDebugContext& Context, const FOnSaveLoadCompleted& Callback = FOnSaveLoadCompleted());
+
+	///////////////////////////////////////////////////////////////////////////////////////
+	/// SPECULATIVE DECODE
+
+	/**
+	 * Sets the slot the player currently focuses (e.g. in a load menu), so it is decoded ahead of time alongside
+	 * the most likely slot (see @USaveGameServiceSettings::bSpeculativeDecode). Pass nothing to clear the focus.
+	 */
+	virtual void SetSpeculativeDecodeFocus(const TOptional<FSlotName>& SlotName);
+	FORCEINLINE const TOptional<FSlotName>& GetSpeculativeDecodeFocus() const { return SpeculativeDecodeFocus; }
+	/** @returns whether given slot was decoded ahead of time, so a load request for it completes without I/O and deserialization. */
+	bool HasSpeculativeDecode(const FSlotName& SlotName) const;
+
 protected:
 	///////////////////////////////////////////////////////////////////////////////////////
 	/// STATE
@@ -235,6 +324,8 @@ protected:
 		void Remove(const FSlotName& SlotName);
 		void Clear();
 		void CopyToCache(USaveGameService& InService, const FSlotName& SlotName, const USaveGame& SaveGame);
+		/** Caches a single copy for all given slots, which is fine since cached snapshots are never modified. */
+		void CopyToCache(USaveGameService& InService, const TArray<FSlotName>& SlotNames, const USaveGame& SaveGame);
 		USaveGame* CopyFromCache(USaveGameService& InService, const FSlotName& SlotName) const;
 		const USaveGame* Find(const FSlotName& SlotName) const;
 		TMap<FSlotName, const USaveGame*> GetAllObjectsBySlot() const;
@@ -243,11 +334,82 @@ protected:
 		TMap<FSlotName, TStrongObjectPtr<const USaveGame>> SnapshotsBySlot = {};
 	} CachedSaveGames;
 
+	/** Encoded SaveGames of the most recent saves. Unlike the cache, these are not bound to a slot and survive overwrites. */
+	FSaveGameSnapshotRing InMemorySnapshots;
+	TSharedPtr<TArray<uint8>> SaveDataInProgress = nullptr;
+
+	/** SaveGames decoded ahead of time, because they are likely to be loaded next. Discarded when they are not wanted anymore. */
+	struct FSpeculativeDecode
+	{
+		TStrongObjectPtr<USaveGame> SaveGame = nullptr;
+		FSaveLoadCancellationTokenPtr CancellationToken = nullptr; // (i) Only valid while reading.
+		int64 NumBytes = 0;
+	};
+	TMap<FSlotName, FSpeculativeDecode> SpeculativeDecodes = {};
+	TOptional<FSlotName> SpeculativeDecodeFocus = {};
+	TOptional<FSlotName> MostLikelySlotToLoad = {};
+	bool bMostLikelySlotToLoadDirty = true;
+
+	/** Level of a load-and-travel request, loaded asynchronously while the SaveGame itself is still being read and decoded. */
+	struct FTravelPrefetch
+	{
+		FSoftObjectPath Level = {};
+		TStrongObjectPtr<UPackage> Package = nullptr; // (i) Keeps the loaded level in memory until the travel picks it up.
+		double StartTime = 0.0;
+	};
+	TOptional<FTravelPrefetch> TravelPrefetch = {};
+
+	/** Whether the current SaveGame was set right before traveling and waits for the new world to begin play to be restored. */
+	bool bIsRestorePendingAfterTravel = false;
+
+	/** Cooperative cancellation of the save/load in progress, cancelled once none of its requests are left (see @CancelSaveRequest). */
+	FSaveLoadCancellationTokenPtr SaveCancellationToken = nullptr;
+	FSaveLoadCancellationTokenPtr LoadCancellationToken = nullptr;
+
+	///////////////////////////////////////////////////////////////////////////////////////
+	/// SAVE CONTRIBUTORS
+
+	struct FSaveContributor
+	{
+		FName Name;
+		FDelegateHandle Handle;
+		FCurrentSaveGame::FOnContributeToSave Delegate;
+	};
+	TArray<FSaveContributor> SaveContributors = {};
+
+	struct FSaveContribution
+	{
+		FCurrentSaveGame::FSaveContributionWriter Writer;
+		double ReadyTime = 0.0;
+	};
+
+	struct FPendingSaveContribution
+	{
+		FName ContributorName;
+		double StartTime = 0.0;
+		TFuture<FSaveContribution> Contribution;
+	};
+	TArray<FPendingSaveContribution> PendingSaveContributions = {};
+	TOptional<FSlotName> SlotAwaitingSaveContributions = {};
+	double SaveContributionsStartTime = 0.0;
+
 	///////////////////////////////////////////////////////////////////////////////////////
 	/// HISTORY
 
-	uint8 DebugHistoryEntriesToKeep = 0;
-	TArray<FString> DebugHistory = {};
+	FSaveLoadDebugHistory DebugHistory;
+
+	///////////////////////////////////////////////////////////////////////////////////////
+	/// METRICS
+
+	FSaveLoadMetricsRecorder SaveLoadMetrics;
+	FSaveLoadMetrics SaveMetricsInProgress;
+	FSaveLoadMetrics LoadMetricsInProgress;
+	/** Total time writes were throttled when the I/O of the save in progress started, see @FSaveGameWriteThrottle::GetTotalThrottledSeconds. */
+	double ThrottledSecondsAtSaveIOStart = 0.0;
+
+	/** Content hashes of the data last written into each slot during this session, to skip writing unchanged data. */
+	TMap<FSlotName, uint64> ContentHashesBySlot = {};
+	TOptional<uint64> ContentHashInProgress = {};
 
 	///////////////////////////////////////////////////////////////////////////////////////
 	/// REQUESTS
@@ -263,11 +425,17 @@ protected:
 		FGuid Handle = FGuid::NewGuid();
 		TOptional<FOnSaveLoadCompleted> RequestCallback = {};
 		TOptional<FSlotName> SlotName = {};
+		TArray<FSlotName> AdditionalSlotNames = {}; // (i) Further slots that a save request writes into (see @RequestSaveCurrentSaveGameToSlots).
+		TOptional<FSaveGameSnapshotHandle> SnapshotHandle = {}; // (i) In-memory snapshot that a load request decodes instead of reading its slot (see @TryRestoreInMemorySnapshot).
 		FDebugContext Context = FDebugContext();
+		double EnqueueTime = FPlatformTime::Seconds();
+		double DeferralTime = 0.0;
 		double StartTime = 0.0;
 		double Runtime = 0.0;
 
 	protected:
+		void AddFinishDebugEntry(const FName& Operation, bool bSuccess) const;
+
 		virtual ~ISaveLoadRequest() = default;
 		explicit ISaveLoadRequest(USaveGameService& InService, const FDebugContext& InContext, TOptional<FSlotName> InSlotName = {}) :
 			Service(InService), SlotName(InSlotName), Context(InContext) { }
@@ -293,6 +461,7 @@ protected:
 		explicit FLoadAndTravelIntoToCurrentSaveGameRequest(USaveGameService& InService, const FDebugContext& InContext, const FOnSaveLoadCompleted& Callback, TOptional<FSlotName> InSlotName = {}) :
 			ISaveLoadRequest(InService, InContext, Callback, InSlotName) {}
 		virtual void Finish(USaveGame* RequestedSaveGame, bool bSuccess) override;
+		virtual void Cancel() override;
 	};
 
 	class FSaveCurrentSaveGameRequest : public ISaveLoadRequest
@@ -304,12 +473,39 @@ protected:
 		virtual void Finish(USaveGame* RequestedSaveGame, bool bSuccess) override;
 	};
 
+	class FSaveCurrentSaveGameToSlotsRequest : public ISaveLoadRequest
+	{
+	public:
+		explicit FSaveCurrentSaveGameToSlotsRequest(USaveGameService& InService, const FDebugContext& InContext, const TArray<FSlotName>& InSlotNames);
+		explicit FSaveCurrentSaveGameToSlotsRequest(USaveGameService& InService, const FDebugContext& InContext, const TArray<FSlotName>& InSlotNames, const FOnMultiSlotSaveCompleted& Callback);
+		virtual void Finish(USaveGame* RequestedSaveGame, bool bSuccess) override;
+
+		TOptional<FOnMultiSlotSaveCompleted> MultiSlotCallback = {};
+	};
+
 	TMap<FSlotName, TArray<TSharedRef<ISaveLoadRequest>>> PendingSaveRequestsBySlot = {};
 	TArray<TSharedRef<ISaveLoadRequest>> SaveRequestsInProgress = {};
 
+	/** Slots that the save in progress writes into, usually just one (see @RequestSaveCurrentSaveGameToSlots), and the result of each written slot. */
+	TArray<FSlotName> SaveSlotsInProgress = {};
+	TMap<FSlotName, bool> SaveResultsBySlot = {};
+
 	TMap<FSlotName, TArray<TSharedRef<ISaveLoadRequest>>> PendingLoadRequestsBySlot = {};
 	TArray<TSharedRef<ISaveLoadRequest>> LoadRequestsInProgress = {};
 
+	///////////////////////////////////////////////////////////////////////////////////////
+	/// AUTOSAVE SCHEDULING
+
+	/** Autosave requests that wait for a low-load moment (see @USaveLoadBehavior::IsLowLoadMomentForAutosave). */
+	struct FDeferredAutosave
+	{
+		TArray<TSharedRef<ISaveLoadRequest>> Requests = {};
+		double FirstRequestTime = 0.0;
+		double LastRequestTime = 0.0;
+	} DeferredAutosave;
+
+	float SmoothedFrameTime = 0.0f;
+
 	///////////////////////////////////////////////////////////////////////////////////////
 	/// LOCKS
 
@@ -332,6 +528,8 @@ protected:
 	// - UGameServiceBase
 	virtual void StartService() override;
 	virtual void ShutdownService() override;
+	virtual bool IsTickable() const override;
+	virtual void TickService(float DeltaTime) override;
 	// --
 
 	///////////////////////////////////////////////////////////////////////////////////////
@@ -343,22 +541,68 @@ protected:
 	FAsyncLoadGameHandle EnqueueLoadRequest(const FSlotName& SlotName, const TSharedRef<ISaveLoadRequest>& Request, bool bCancelIfLoadingIsNotAllowed = true);
 	void ConsumeLoadRequestsInProgress(USaveGame* LoadedSaveGame, bool bSuccess);
 
+	FAsyncSaveGameHandle ScheduleAutosave(const FDebugContext& Context, const TSharedRef<ISaveLoadRequest>& Request);
+	virtual void UpdateDeferredAutosave();
+	virtual void ExecuteDeferredAutosave(const FString& Reason);
+
+	///////////////////////////////////////////////////////////////////////////////////////
+	/// SPECULATIVE DECODE
+
+	virtual void UpdateSpeculativeDecodes();
+	virtual void StartSpeculativeDecode(const FSlotName& SlotName);
+	void DiscardSpeculativeDecode(const FSlotName& SlotName);
+	USaveGame* TakeSpeculativeDecode(const FSlotName& SlotName);
+	int64 GetSpeculativeDecodesNumBytes() const;
+
+	///////////////////////////////////////////////////////////////////////////////////////
+	/// TRAVEL
+
+	/** Starts loading the level of the SaveGame in given slot (known from its header), while the load request with given handle reads and decodes the SaveGame. */
+	virtual void PrefetchTravelDestination(const FSlotName& SlotName, const FAsyncLoadGameHandle& LoadHandle);
+	virtual void PrefetchTravelDestinationLevel(const FSlotName& SlotName, const FSaveGameSlotManifestEntry& HeaderEntry);
+	void ReleaseTravelPrefetch();
+	virtual void HandleTravelDestinationInitialized(UWorld& NewWorld);
+	virtual void HandleTravelFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString);
+	virtual void FinishRestoreAfterTravel();
+
 	///////////////////////////////////////////////////////////////////////////////////////
 	/// SAVE & LOAD
 
 	/** Sets current save game and fires pre and post events. */
 	void SetCurrentSaveGame(const FCurrentSaveGame& NewCurrentSaveGame);
 
+	/** Fires @OnAfterRestored for the current save game and begins the staged @RestorePipeline. */
+	void BroadcastAfterRestored();
+
 	virtual USaveLoadBehavior& CreateSaveLoadBehavior(const USaveGameServiceSettings& Settings);
 	virtual USaveGameSerializer& CreateSaveGameSerializer();
 
 	virtual void PerformAsyncSave(const FSlotName& SlotName);
+	virtual void ContinueAsyncSave(const FSlotName& SlotName);
+	/** Writes the encoded data of the save in progress into the remaining slots, one after another. */
+	virtual void WriteSaveDataToSlots(const FSlotName& SlotName, TArray<FSlotName> RemainingSlotNames, double IOStartTime);
+	/** Limits the write bandwidth while the game is streaming (see @USaveGameServiceSettings::WriteBandwidthWhileStreamingKiB). */
+	virtual void UpdateWriteThrottle();
+	/** @returns whether any contributions are pending, which the save has to wait for (see @AddSaveContributor). */
+	bool StartSaveContributions();
+	void UpdatePendingSaveContributions();
+	void ApplySaveContributions();
+	virtual bool ShouldSkipUnchangedWrite(const FSlotName& SlotName, const TOptional<uint64>& ContentHash) const;
+	virtual void CheckSaveSizeBudgets(const FSlotName& SlotName, const FSaveGameSizeReport& SizeReport) const;
+	virtual void AbortCancelledSave(const FSlotName& SlotName);
 	virtual void PerformAsyncLoad(const FSlotName& SlotName);
+	void DeserializeLoadedData(const FSlotName& SlotName, const int32 UserIndex, const TArray<uint8>& SaveData);
+	/** @returns the in-memory snapshot that the load in progress restores, if any (see @TryRestoreInMemorySnapshot). */
+	TOptional<FSaveGameSnapshotHandle> GetSnapshotHandleOfLoadInProgress() const;
+	virtual void AbortCancelledLoad(const FSlotName& SlotName);
 	virtual USaveGame* PerformSyncLoad(const FSlotName& SlotName);
 
 	virtual void HandleAsyncSaveCompleted(const FString& SlotName, const int32 UserIndex, bool bSuccess);
 	virtual void HandleAsyncLoadCompleted(const FString& SlotName, const int32 UserIndex, USaveGame* LoadedSaveGame);
 
+	void BeginSaveLoadMetrics(FSaveLoadMetrics& OutMetrics, ESaveLoadOperation Operation, const FSlotName& SlotName, const TArray<TSharedRef<ISaveLoadRequest>>& Requests) const;
+	void FinishSaveLoadMetrics(FSaveLoadMetrics& Metrics, bool bSuccess);
+
 	///////////////////////////////////////////////////////////////////////////////////////
 	/// MISC
 
@@ -367,9 +611,9 @@ protected:
 	virtual void CreateWorldTransitionSaveLoadLocks();
 
 	virtual void SetStatus(const EStatus& NewStatus);
-	virtual void AddDebugEntry(const FString& Entry);
-	virtual void AddDebugEntry(const FString& Operation, const FDebugContext& Context);
-	virtual void AddDebugEntry(const FString& Operation, const FDebugContext& Context, bool bSuccess, double ExecTime);
+	virtual void AddDebugEntry(FSaveLoadDebugEntry&& Entry);
+	void AddDebugEntry(const FName& Operation, const FDebugContext& Context = FDebugContext());
+	void AddDebugEntry(const FName& Operation, const FDebugContext& Context, bool bSuccess, double ExecTime);
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,74 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "StructUtils/InstancedStruct.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Mirror of the header of a single save file (see @FModularSaveGameHeader), including
+ * the custom header data (usually @FSimpleSaveGameHeaderData) and information about the
+ * file on disk, which is used to validate whether the mirrored data is still up-to-date.
+ */
+struct WEEKENDSAVEGAME_API FSaveGameSlotManifestEntry
+{
+	int32 SaveGameFileVersion = 0;
+	FEngineVersion SavedEngineVersion = FEngineVersion();
+	FString SaveGameClassName = FString();
+	FInstancedStruct CustomHeaderData = FInstancedStruct();
+
+	FDateTime FileTimeStamp = FDateTime::MinValue();
+	int64 FileSize = INDEX_NONE;
+
+	template <typename T>
+	const T* GetCustomHeaderData() const { return CustomHeaderData.GetPtr<T>(); }
+
+	void Serialize(FArchive& Ar);
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+#define MODULAR_SAVEGAME_MANIFEST_FILE_TYPE_TAG	0x53414D46 // = "SAMF"
+#define MODULAR_SAVEGAME_MANIFEST_FILE_VERSION	1 // Increase when the manifest file format becomes incompatible to previous version
+
+/**
+ * Compact collection of the headers of all save files, which is written into a single small file
+ * alongside the save files. Allows listing all available save games with one file read, instead of
+ * opening every single save file. Entries are validated against the timestamp and size of the
+ * respective save file and must be rebuilt from the save file when they turned stale.
+ * Mainly used by @USaveGameSerializer.
+ */
+struct WEEKENDSAVEGAME_API FSaveGameSlotManifest
+{
+	using FSlotName = FString;
+
+	/** Replaces all entries with the ones stored in given manifest file. @returns false if the file is missing or incompatible. */
+	bool TryLoadFromFile(const FString& FilePath);
+
+	/** Atomically writes all entries into given manifest file (via temporary file that replaces the old file when complete). */
+	bool TrySaveToFile(const FString& FilePath) const;
+
+	/** @returns whether an entry for given slot exists and matches the timestamp and size of the actual save file. */
+	bool IsUpToDate(const FSlotName& SlotName, const FDateTime& FileTimeStamp, int64 FileSize) const;
+
+	const FSaveGameSlotManifestEntry* Find(const FSlotName& SlotName) const { return EntriesBySlot.Find(SlotName); }
+	const TMap<FSlotName, FSaveGameSlotManifestEntry>& GetEntries() const { return EntriesBySlot; }
+
+	void Update(const FSlotName& SlotName, const FSaveGameSlotManifestEntry& Entry) { EntriesBySlot.Add(SlotName, Entry); }
+	bool Remove(const FSlotName& SlotName) { return (EntriesBySlot.Remove(SlotName) > 0); }
+	void Clear() { EntriesBySlot.Empty(); }
+
+private:
+	TMap<FSlotName, FSaveGameSlotManifestEntry> EntriesBySlot = {};
+};
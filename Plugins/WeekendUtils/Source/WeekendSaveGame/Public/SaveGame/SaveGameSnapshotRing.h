@@ -0,0 +1,71 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+using FSaveGameSnapshotHandle = FGuid;
+
+/**
+ * Encoded (serialized) state of a save game that is kept in memory, so it can be restored
+ * without going through the disk. Encoded data is immutable and may be shared.
+ */
+struct WEEKENDSAVEGAME_API FSaveGameSnapshot
+{
+	using FSlotName = FString;
+
+	FSaveGameSnapshotHandle Handle = FSaveGameSnapshotHandle();
+	FSlotName SlotName = FSlotName();
+	FString Context = FString();
+	FDateTime UtcTimeOfCapture = FDateTime::MinValue();
+	TSharedPtr<const TArray<uint8>> EncodedData = nullptr;
+
+	FORCEINLINE int64 GetNumBytes() const { return (EncodedData.IsValid() ? EncodedData->Num() : 0); }
+};
+
+/**
+ * Fixed-capacity ring of the most recent @FSaveGameSnapshot entries. When full or when the
+ * memory budget is exceeded, the oldest snapshots are evicted first. Handles stay valid for as
+ * long as their snapshot is kept, so evicted snapshots are simply not found anymore.
+ * Mainly used by @USaveGameService.
+ */
+struct WEEKENDSAVEGAME_API FSaveGameSnapshotRing
+{
+	/** (Re-)configures capacity and memory budget. Existing snapshots are kept as long as they fit. */
+	void Configure(int32 InCapacity, int64 InMaxNumBytes);
+
+	/** Adds a new snapshot as most recent entry. @returns invalid handle if the snapshot alone exceeds the memory budget. */
+	FSaveGameSnapshotHandle Add(const FSaveGameSnapshot::FSlotName& SlotName, const FString& Context, const TSharedRef<const TArray<uint8>>& EncodedData);
+
+	const FSaveGameSnapshot* Find(const FSaveGameSnapshotHandle& Handle) const;
+	const FSaveGameSnapshot* FindMostRecent() const;
+	const FSaveGameSnapshot* FindMostRecentOfSlot(const FSaveGameSnapshot::FSlotName& SlotName) const;
+	/** @returns handles of all kept snapshots, most recent first. */
+	TArray<FSaveGameSnapshotHandle> GetHandles() const;
+
+	bool Remove(const FSaveGameSnapshotHandle& Handle);
+	void Clear();
+
+	FORCEINLINE bool IsEnabled() const { return (Entries.Num() > 0); }
+	FORCEINLINE int32 Num() const { return NumEntries; }
+	FORCEINLINE int64 GetNumBytes() const { return NumBytes; }
+	FORCEINLINE int64 GetMaxNumBytes() const { return MaxNumBytes; }
+
+private:
+	TArray<FSaveGameSnapshot> Entries = {};
+	int32 NextIndex = 0;
+	int32 NumEntries = 0;
+	int64 NumBytes = 0;
+	int64 MaxNumBytes = 0;
+
+	int32 GetRingIndex(int32 Age) const;
+	bool TryPush(FSaveGameSnapshot&& Snapshot);
+	void RemoveOldest();
+};
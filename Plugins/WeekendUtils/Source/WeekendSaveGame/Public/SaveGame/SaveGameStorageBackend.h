@@ -0,0 +1,158 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/TaskGraphInterfaces.h"
+
+class FSaveGameBufferPool;
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/** Priority of save file operations, relative to other I/O of the game (e.g. texture and level streaming). */
+enum class ESaveGameIOPriority : uint8
+{
+	Low,		// Background work nobody waits for, e.g. speculative decodes or autosaves.
+	Normal,
+	High,		// Somebody waits for it, e.g. a load requested by the player. Never throttled.
+	MAX
+};
+
+WEEKENDSAVEGAME_API const TCHAR* LexToString(ESaveGameIOPriority Priority);
+
+/** @returns the task thread that asynchronous save file operations with given priority are executed on. */
+WEEKENDSAVEGAME_API ENamedThreads::Type GetSaveGameIOTaskThread(ESaveGameIOPriority Priority);
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Limits the bandwidth of save file writes, e.g. while level streaming needs the disk (see @USaveGameServiceSettings::WriteBandwidthWhileStreamingKiB).
+ * Writers split large writes into blocks and report every written block, which blocks the writing worker thread as long as needed
+ * to stay within the limit. The limit can be changed (or lifted) at any time from the game thread and affects writes in progress.
+ */
+class WEEKENDSAVEGAME_API FSaveGameWriteThrottle
+{
+public:
+	/** Limits the bandwidth of all throttled writes. Zero lifts the limit. */
+	void SetBandwidthLimit(int64 InBytesPerSecond) { BytesPerSecond.store(FMath::Max<int64>(InBytesPerSecond, 0)); }
+	FORCEINLINE int64 GetBandwidthLimit() const { return BytesPerSecond.load(); }
+	FORCEINLINE bool IsThrottling() const { return (GetBandwidthLimit() > 0); }
+
+	/** Called by writers after writing a block that took given time. Blocks the calling thread until the block fits into the limit. @returns seconds waited. */
+	double ThrottleBlock(int64 NumBytes, double WriteSeconds);
+
+	/** @returns total time that all writes were paused by this throttle. */
+	FORCEINLINE double GetTotalThrottledSeconds() const { return TotalThrottledMicroseconds.load() / 1000000.0; }
+
+private:
+	std::atomic<int64> BytesPerSecond = 0;
+	std::atomic<int64> TotalThrottledMicroseconds = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Reads and writes save files for the @USaveGameSerializer (see @USaveGameSerializer::CreateStorageBackend).
+ * Besides reading complete save files, backends can read ranges of a save file, so e.g. reading
+ * the header of a save file doesn't require a copy of the whole file.
+ */
+class WEEKENDSAVEGAME_API ISaveGameStorageBackend
+{
+public:
+	using FSlotName = FString;
+	/** Called on the game thread when an asynchronous read completed. */
+	using FOnReadCompleted = TFunction<void(bool bSuccess, const TArray<uint8>& Data)>;
+	/** Called on the game thread when an asynchronous write completed. */
+	using FOnWriteCompleted = TFunction<void(bool bSuccess)>;
+
+	virtual ~ISaveGameStorageBackend() = default;
+
+	virtual const TCHAR* GetName() const = 0;
+
+	/** Reads the complete save file of given slot. */
+	virtual bool TryReadSlot(const FSlotName& SlotName, const int32 UserIndex, TArray<uint8>& OutData) const = 0;
+
+	/** Reads up to NumBytes of the save file of given slot, starting at Offset. Reads less at the end of the file. */
+	virtual bool TryReadSlotRange(const FSlotName& SlotName, const int32 UserIndex, int64 Offset, int64 NumBytes, TArray<uint8>& OutData) const = 0;
+
+	/** Reads the complete save file of given slot without blocking the game thread. */
+	virtual void AsyncReadSlot(const FSlotName& SlotName, const int32 UserIndex, ESaveGameIOPriority Priority, FOnReadCompleted Callback) const = 0;
+
+	/** Writes the save file of given slot. Blocks the calling thread and is never throttled. */
+	virtual bool TryWriteSlot(const FSlotName& SlotName, const int32 UserIndex, const TArray<uint8>& Data) const = 0;
+
+	/** Writes the save file of given slot without blocking the game thread. Writes below high priority obey given throttle, if the backend supports it. */
+	virtual void AsyncWriteSlot(const FSlotName& SlotName, const int32 UserIndex, const TSharedRef<TArray<uint8>>& Data, ESaveGameIOPriority Priority,
+		const TSharedPtr<FSaveGameWriteThrottle>& Throttle, FOnWriteCompleted Callback) const = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Fallback backend that reads and writes through the @ISaveGameSystem of the platform, like @UGameplayStatics does.
+ * The platform always provides the complete file, so range reads only save the copy, but not the file read.
+ * The platform also decides about the priority of its I/O, so writes can't be throttled.
+ */
+class WEEKENDSAVEGAME_API FSaveGameSystemStorageBackend : public ISaveGameStorageBackend
+{
+public:
+	// - ISaveGameStorageBackend
+	virtual const TCHAR* GetName() const override { return TEXT("SaveGameSystem"); }
+	virtual bool TryReadSlot(const FSlotName& SlotName, const int32 UserIndex, TArray<uint8>& OutData) const override;
+	virtual bool TryReadSlotRange(const FSlotName& SlotName, const int32 UserIndex, int64 Offset, int64 NumBytes, TArray<uint8>& OutData) const override;
+	virtual void AsyncReadSlot(const FSlotName& SlotName, const int32 UserIndex, ESaveGameIOPriority Priority, FOnReadCompleted Callback) const override;
+	virtual bool TryWriteSlot(const FSlotName& SlotName, const int32 UserIndex, const TArray<uint8>& Data) const override;
+	virtual void AsyncWriteSlot(const FSlotName& SlotName, const int32 UserIndex, const TSharedRef<TArray<uint8>>& Data, ESaveGameIOPriority Priority,
+		const TSharedPtr<FSaveGameWriteThrottle>& Throttle, FOnWriteCompleted Callback) const override;
+	// --
+};
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Backend that reads and writes save files directly on disk, for platforms where the @ISaveGameSystem stores plain files
+ * (usually desktop platforms). Files are read in blocks through @IAsyncReadFileHandle, which are all requested at once
+ * (with the priority of the read) and written straight into the destination buffer, so nothing is copied after reading.
+ * Files are written in blocks into a temporary file, which replaces the save file when complete, so writes can be throttled.
+ * Asynchronous reads go into buffers of the optional @FSaveGameBufferPool. All reads and writes are thread-safe.
+ */
+class WEEKENDSAVEGAME_API FSaveGameFileStorageBackend : public ISaveGameStorageBackend
+{
+public:
+	/** Size of the blocks that files are read in. */
+	static constexpr int64 ReadBlockSize = 1024 * 1024;
+	/** Size of the blocks that files are written in. Throttled writes pause between blocks. */
+	static constexpr int64 WriteBlockSize = 256 * 1024;
+
+	explicit FSaveGameFileStorageBackend(const FString& InSaveGamesDirectory, const TSharedPtr<FSaveGameBufferPool>& InBufferPool = nullptr);
+
+	// - ISaveGameStorageBackend
+	virtual const TCHAR* GetName() const override { return TEXT("File (Block Async)"); }
+	virtual bool TryReadSlot(const FSlotName& SlotName, const int32 UserIndex, TArray<uint8>& OutData) const override;
+	virtual bool TryReadSlotRange(const FSlotName& SlotName, const int32 UserIndex, int64 Offset, int64 NumBytes, TArray<uint8>& OutData) const override;
+	virtual void AsyncReadSlot(const FSlotName& SlotName, const int32 UserIndex, ESaveGameIOPriority Priority, FOnReadCompleted Callback) const override;
+	virtual bool TryWriteSlot(const FSlotName& SlotName, const int32 UserIndex, const TArray<uint8>& Data) const override;
+	virtual void AsyncWriteSlot(const FSlotName& SlotName, const int32 UserIndex, const TSharedRef<TArray<uint8>>& Data, ESaveGameIOPriority Priority,
+		const TSharedPtr<FSaveGameWriteThrottle>& Throttle, FOnWriteCompleted Callback) const override;
+	// --
+
+	FString GetSlotFilePath(const FSlotName& SlotName) const;
+
+	/** Writes given data into the save file of given slot in blocks, which obey given throttle (if any). Blocks the calling thread. */
+	bool TryWriteSlotThrottled(const FSlotName& SlotName, const TArray<uint8>& Data, FSaveGameWriteThrottle* Throttle) const;
+
+private:
+	FString SaveGamesDirectory;
+	TSharedPtr<FSaveGameBufferPool> BufferPool = nullptr;
+
+	bool TryReadSlotWithPriority(const FSlotName& SlotName, ESaveGameIOPriority Priority, TArray<uint8>& OutData) const;
+	bool TryReadFileRange(const FString& FilePath, int64 Offset, int64 NumBytes, ESaveGameIOPriority Priority, TArray<uint8>& OutData) const;
+	bool TryReadFileRangeInBlocks(const FString& FilePath, int64 Offset, int64 NumBytes, ESaveGameIOPriority Priority, TArray<uint8>& OutData) const;
+};
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "SaveGame/SaveGameStorageBackend.h"
 #include "UObject/Object.h"
 
 #include "SaveLoadBehavior.generated.h"
@@ -78,7 +79,39 @@ public:
 	/** Attempts to travel into the level (hopefully) saved in given SaveGame. @returns whether this was successful. */
 	virtual bool TryTravelToSavedLevel(const FCurrentSaveGame& SaveGame);
 
+	/**
+	 * Called by @USaveGameService while autosaves are deferred (see @USaveGameServiceSettings::AutosaveMaxDeferral).
+	 * Default: a loading screen or paused game, or a smoothed frame time below the threshold while nothing is streaming.
+	 * @returns whether now is a good moment for a deferred autosave and why, which is reported along with the autosave.
+	 */
+	virtual bool IsLowLoadMomentForAutosave(const USaveGameService& SaveGameService, float SmoothedFrameTime, OUT FString& OutReason) const;
+
+	/**
+	 * @returns the slot that the player will most likely load next (e.g. via a "Continue" button), which the @USaveGameService
+	 * decodes ahead of time (see @USaveGameServiceSettings::bSpeculativeDecode). Default: the most recently saved slot.
+	 */
+	virtual TOptional<FSlotName> FindMostLikelySlotToLoad(const USaveGameService& SaveGameService) const;
+
+	/**
+	 * @returns whether the @USaveGameService should decode slots ahead of time right now (see @USaveGameServiceSettings::bSpeculativeDecode).
+	 * Decoding costs disk I/O and memory that are wasted during gameplay, so this should only be true where loading is likely, e.g. in a menu.
+	 * Default: while a load menu focuses a slot (see @USaveGameService::SetSpeculativeDecodeFocus).
+	 */
+	virtual bool ShouldSpeculativelyDecode(const USaveGameService& SaveGameService) const;
+
+	/**
+	 * @returns whether the game is streaming (e.g. levels or assets), which competes with saving for disk I/O.
+	 * Save file writes are throttled while streaming (see @USaveGameServiceSettings::WriteBandwidthWhileStreamingKiB).
+	 */
+	virtual bool IsStreamingActive(const USaveGameService& SaveGameService) const;
+
+	/** @returns the I/O priority that given slot is written with. Default: autosaves are written with low priority, every other slot with normal priority. */
+	virtual ESaveGameIOPriority GetWriteIOPriority(const USaveGameService& SaveGameService, const FSlotName& SlotName) const;
+
 protected:
+	/** Possibility for derived behaviors to report that a loading screen is shown, which is a good moment for deferred autosaves. */
+	virtual bool IsShowingLoadingScreen(const USaveGameService& SaveGameService) const { return false; }
+
 	/** Possibility for derived behaviors to make an options-string that is passed in TryTravelToSavedLevel(). */
 	virtual FString MakeTravelOptions(const FCurrentSaveGame& SaveGame) const { return FString(); }
 };
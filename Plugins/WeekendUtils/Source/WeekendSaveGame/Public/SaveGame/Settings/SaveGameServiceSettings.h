@@ -55,9 +55,136 @@ public:
 	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Behavior", meta = (EditCondition = "!bAlwaysAllowSaving", MetaClass = "/Script/Engine.GameModeBase"))
 	TSet<FSoftClassPath> GameModesWhereSavingIsAllowed = {};
 
-	/** How many save/load events to keep in the debug history of the SaveGameService. History may be saved into the save game. */
+	/** How many save/load events to keep in the debug history of the SaveGameService. Entries are only formatted when displayed or saved. */
 	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Behavior", AdvancedDisplay)
-	uint8 DebugHistoryEntriesToKeep = 16;
+	uint8 DebugHistoryEntriesToKeep = 64;
+
+	/** How many of the most recent debug history entries are written into the save game (see @USaveGameModule_SaveLoadDebugHistory). */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Behavior", AdvancedDisplay)
+	uint8 DebugHistoryEntriesToSave = 16;
+
+	/** Whether to mirror the headers of all save files into a single manifest file, so listing save games doesn't need to open every save file. Only used where the platform uses the generic save game system. */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance")
+	bool bUseSlotManifest = true;
+
+	/**
+	 * Whether to skip writing a save file when its content (excluding header and volatile modules) did not change since it was last written.
+	 * The save request still succeeds, but the header on disk (e.g. save counter and time of last save) will not be updated.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance")
+	bool bSkipUnchangedWrites = true;
+
+	/**
+	 * Whether save data is split into content-defined chunks, which are stored once in a chunk store shared by all slots and backups (see @FSaveGameChunkStore).
+	 * Save files then only reference their chunks, so writing a mostly unchanged SaveGame only writes a few new chunks. Existing save files stay loadable either way.
+	 * Only used where the platform uses the generic save game system, which stores save files as plain files.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance")
+	bool bUseChunkStore = false;
+
+	/**
+	 * Whether save files are read directly from disk where the platform uses the generic save game system (in asynchronous blocks, see @FSaveGameFileStorageBackend),
+	 * instead of through the platform's save game system, which always reads and copies whole files. Allows reading save file headers without reading the whole file.
+	 * Save files are then also written directly (synchronous and asynchronous saves alike), in blocks, so writes can be throttled (see @WriteBandwidthWhileStreamingKiB).
+	 * (!) Bypasses any ISaveGameSystem the project overrides (e.g. for cloud saves), so only enable it when save files are plain files on disk.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance")
+	bool bReadSaveFilesDirectly = false;
+
+	/**
+	 * Maximum bandwidth (in KiB per second) of save file writes while the game is streaming (see @USaveLoadBehavior::IsStreamingActive),
+	 * so saving doesn't starve level and asset streaming of disk I/O. High priority writes are never throttled. Zero disables throttling.
+	 * Only applies where save files are written directly (see @bReadSaveFilesDirectly).
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance", meta = (ClampMin = 0))
+	int32 WriteBandwidthWhileStreamingKiB = 8 * 1024;
+
+	/**
+	 * Memory budget (in KiB) for unused byte arrays of encoded SaveGames, which are kept to be reused by the next save or load (see @FSaveGameBufferPool),
+	 * instead of growing new arrays through many reallocations every time. Zero frees every array after use (arrays are still pre-sized for saves).
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance", meta = (ClampMin = 0))
+	int32 BufferPoolBudgetKiB = 32 * 1024;
+
+	/** How many of the most recently saved SaveGames to keep encoded in memory, so they can be restored without disk I/O (e.g. for quickload or checkpoint retries). 0 disables in-memory snapshots. */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance")
+	uint8 InMemorySnapshotsToKeep = 3;
+
+	/** Memory budget (in KiB) for all in-memory snapshots. Oldest snapshots are evicted first when exceeding this budget. */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance", meta = (EditCondition = "InMemorySnapshotsToKeep > 0", ClampMin = 0))
+	int32 InMemorySnapshotsBudgetKiB = 32 * 1024;
+
+	/**
+	 * Maximum time in seconds that autosave requests may be deferred to wait for a low-load moment, such as a loading screen,
+	 * a pause menu or enough frame time headroom without streaming (see @USaveLoadBehavior::IsLowLoadMomentForAutosave).
+	 * Zero means that autosaves are executed immediately.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance", meta = (ClampMin = 0, Units = "s"))
+	float AutosaveMaxDeferral = 0.0f;
+
+	/** Repeated autosave requests are merged into one deferred autosave, which waits until no new request came in for this long. */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance", meta = (EditCondition = "AutosaveMaxDeferral > 0", ClampMin = 0, Units = "s"))
+	float AutosaveDebounceTime = 1.0f;
+
+	/** Smoothed frame time, below which the game is considered to have enough headroom for a deferred autosave. */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance", meta = (EditCondition = "AutosaveMaxDeferral > 0", ClampMin = 0, Units = "ms"))
+	float AutosaveFrameTimeThreshold = 12.0f;
+
+	/**
+	 * Whether to load and decode the slot that is most likely loaded next (see @USaveLoadBehavior::FindMostLikelySlotToLoad)
+	 * and the slot focused in a load menu ahead of time, while the service is idle. Load requests for these slots complete instantly.
+	 * Only happens while the save/load behavior asks for it (see @USaveLoadBehavior::ShouldSpeculativelyDecode), e.g. in a menu.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance")
+	bool bSpeculativeDecode = false;
+
+	/** Memory budget (in KiB of save data) for all speculatively decoded SaveGames. Slots exceeding the budget are not decoded ahead of time. */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance", meta = (EditCondition = "bSpeculativeDecode", ClampMin = 0))
+	int32 SpeculativeDecodeBudgetKiB = 16 * 1024;
+
+	/**
+	 * Whether load-and-travel requests start loading the saved level (known from the save file header) right away, while the SaveGame
+	 * is still being read and decoded. The SaveGame is then restored once the new world has begun play, instead of into the world being left.
+	 * (!) Changes the timing of @USaveGameService::OnAfterRestored, which is then broadcast after travel, and the service stays busy loading until then.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance")
+	bool bOverlapLoadWithTravel = false;
+
+	/**
+	 * Whether assets referenced by a SaveGame, which are not loaded yet, are loaded asynchronously in a single batch before
+	 * deserializing it, instead of one blocking load after another while resolving the references (see @UModularSaveGameSerializer).
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance")
+	bool bPreloadReferencedAssets = true;
+
+	/**
+	 * Whether the modules of a SaveGame are (de-)compressed and (de-)serialized on worker threads in parallel (see @UModularSaveGameSerializer).
+	 * Only modules that opt in (see @USaveGameModule::bSupportsParallelSerialization) are affected, all others are handled on the game thread.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance")
+	bool bParallelModuleSerialization = true;
+
+	/** Compression format that every SaveGame module is compressed with individually. None stores modules uncompressed. */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance")
+	FName ModuleCompressionFormat = NAME_Oodle;
+
+	/**
+	 * Time per frame for restoring listeners of the non-critical tiers of the restore pipeline (see @FSaveGameRestorePipeline).
+	 * At least one listener is restored per frame. Zero restores all tiers within the same frame as the SaveGame.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance", meta = (ClampMin = 0, Units = "ms"))
+	float RestoreFrameBudget = 4.0f;
+
+	/**
+	 * Maximum time that a save waits for asynchronous contributions (see @USaveGameService::AddSaveContributor). Contributions that
+	 * aren't ready by then are dropped with a warning, and the SaveGame is saved without them. Zero waits for contributions forever.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance", meta = (ClampMin = 0, Units = "s"))
+	float SaveContributionTimeout = 10.0f;
+
+	/** Size budgets (in KiB) of SaveGame modules by module name. Saving logs a warning for every module that exceeds its budget. */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Weekend Utils|Save Game|Performance", meta = (ClampMin = 0))
+	TMap<FName, int32> ModuleSizeBudgetsKiB = {};
 
 	/** Name of the SaveGame slot to save to while playing in editor (see @UDefaultPlayInEditorSaveLoadBehavior). */
 	UPROPERTY(Config, EditAnywhere, Category = "Weekend Utils|PIE")
@@ -47,6 +47,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Weekend Utils|Save Game")
 	virtual void EndUsage();
 
+	/** Tells the list which slot the player currently focuses (e.g. hovered or selected), so lists for loading can decode it ahead of time. */
+	UFUNCTION(BlueprintCallable, Category = "Weekend Utils|Save Game")
+	virtual void SetFocusedSlot(const FString& SlotName);
+
+	UFUNCTION(BlueprintCallable, Category = "Weekend Utils|Save Game")
+	virtual void ClearFocusedSlot();
+
 protected:
 	UPROPERTY()
 	TSubclassOf<USaveGameSlotViewModel> SlotViewModelClass = nullptr;
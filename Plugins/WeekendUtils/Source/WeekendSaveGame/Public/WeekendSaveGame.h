@@ -12,9 +12,16 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+DECLARE_STATS_GROUP(TEXT("Save Game"), STATGROUP_SaveGame, STATCAT_Advanced);
+
 class FWeekendSaveGameModule : public IModuleInterface
 {
 public:
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+#if WITH_EDITOR
+	FDelegateHandle ObjectsReinstancedHandle;
+#endif
 };
\ No newline at end of file
@@ -0,0 +1,32 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#include "SaveGame/Mocks/SaveGameSerializationMocks.h"
+
+#include "SaveGame/SaveGameStorageBackend.h"
+#include "Serialization/CustomVersion.h"
+
+const FGuid FMockSaveGameCustomVersion::GUID(0x5B0D3E71, 0x94A24C6F, 0xB1E8270D, 0x3C6FA59E);
+static FCustomVersionRegistration GRegisterMockSaveGameCustomVersion(FMockSaveGameCustomVersion::GUID, FMockSaveGameCustomVersion::LatestVersion, TEXT("MockSaveGameVersion"));
+
+void UMockSaveGameModule_CustomVersion::Serialize(FArchive& Ar)
+{
+	Ar.UsingCustomVersion(FMockSaveGameCustomVersion::GUID);
+	Super::Serialize(Ar);
+
+	if (Ar.IsLoading())
+	{
+		LoadedCustomVersion = Ar.CustomVer(FMockSaveGameCustomVersion::GUID);
+	}
+}
+
+TSharedRef<ISaveGameStorageBackend> UMockFileSaveGameSerializer::CreateStorageBackend() const
+{
+	return MakeShared<FSaveGameFileStorageBackend>(Directory, GetBufferPool());
+}
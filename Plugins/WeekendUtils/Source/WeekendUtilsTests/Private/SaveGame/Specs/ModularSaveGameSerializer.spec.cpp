@@ -0,0 +1,553 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#if WITH_AUTOMATION_WORKER
+
+#include "AutomationTest/AutomationSpecMacros.h"
+#include "SaveGame/ModularSaveGame.h"
+#include "SaveGame/SaveGameHeader.h"
+#include "SaveGame/SaveGameSerializer.h"
+#include "SaveGame/Mocks/SaveGameSerializationMocks.h"
+#include "SaveGame/Modules/SaveGameModule_Cheats.h"
+#include "SaveGame/Modules/SaveGameModule_PlayerStart.h"
+#include "SaveGame/Modules/SaveGameModule_SaveLoadDebugHistory.h"
+#include "SaveGame/Settings/SaveGameServiceSettings.h"
+#include "Serialization/CustomVersion.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "UObject/ObjectVersion.h"
+#include "UObject/StrongObjectPtr.h"
+
+#define SPEC_TEST_CATEGORY "WeekendUtils.SaveGame"
+
+using namespace WeekendUtils;
+
+WE_BEGIN_DEFINE_SPEC(ModularSaveGameSerializer)
+	TStrongObjectPtr<UModularSaveGameSerializer> Serializer;
+	TStrongObjectPtr<UMockModularSaveGame> SaveGame;
+	bool bParallelModuleSerializationBefore = true;
+
+	TArray<uint8> SerializeSaveGame(bool bParallelModuleSerialization) const
+	{
+		GetMutableDefault<USaveGameServiceSettings>()->bParallelModuleSerialization = bParallelModuleSerialization;
+		TArray<uint8> SaveData;
+		Serializer->TrySerializeSaveGame(*SaveGame, OUT SaveData);
+		return SaveData;
+	}
+
+	UModularSaveGame* DeserializeSaveGame(const TArray<uint8>& SaveData) const
+	{
+		USaveGame* DeserializedSaveGame = nullptr;
+		Serializer->TryDeserializeSaveGame(SaveData, OUT DeserializedSaveGame);
+		return Cast<UModularSaveGame>(DeserializedSaveGame);
+	}
+
+	/** Writes the SaveGame in the layout of the very first file version: header, followed by all properties and modules inline. */
+	TArray<uint8> SerializeSaveGameAsFileVersion1() const
+	{
+		TArray<uint8> SaveData;
+		FMemoryWriter MemoryWriter(SaveData, true);
+		MemoryWriter.ArIsSaveGame = true;
+
+		int32 FileTypeTag = MODULAR_SAVEGAME_FILE_TYPE_TAG;
+		int32 SaveGameFileVersion = 1;
+		FPackageFileVersion PackageFileUEVersion = GPackageFileUEVersion;
+		FEngineVersion SavedEngineVersion = FEngineVersion::Current();
+		int32 CustomVersionFormat = static_cast<int32>(ECustomVersionSerializationFormat::Latest);
+		FCustomVersionContainer CustomVersions = FCurrentCustomVersions::GetAll();
+		FString SaveGameClassName = SaveGame->GetClass()->GetPathName();
+		FInstancedStruct CustomHeaderData = FInstancedStruct::Make<FSimpleSaveGameHeaderData>();
+		MemoryWriter << FileTypeTag;
+		MemoryWriter << SaveGameFileVersion;
+		MemoryWriter << PackageFileUEVersion;
+		MemoryWriter << SavedEngineVersion;
+		MemoryWriter << CustomVersionFormat;
+		CustomVersions.Serialize(MemoryWriter, ECustomVersionSerializationFormat::Latest);
+		MemoryWriter << SaveGameClassName;
+		FObjectAndNameAsStringProxyArchive HeaderArchive(MemoryWriter, true);
+		CustomHeaderData.Serialize(HeaderArchive);
+
+		FWeekendUtilsSubobjectProxyArchive Archive(MemoryWriter, *SaveGame);
+		Archive.bUseObjectIdentityTable = false;
+		SaveGame->Serialize(Archive);
+		return SaveData;
+	}
+
+	/** @returns the custom versions in the header of given save data, which are written right behind the engine versions. */
+	static FCustomVersionContainer ReadCustomVersions(const TArray<uint8>& SaveData, int64& OutBeginOffset, int64& OutEndOffset)
+	{
+		FMemoryReader MemoryReader(SaveData, true);
+		int32 FileTypeTag = 0;
+		int32 SaveGameFileVersion = 0;
+		FPackageFileVersion PackageFileUEVersion;
+		FEngineVersion SavedEngineVersion;
+		int32 CustomVersionFormat = 0;
+		MemoryReader << FileTypeTag;
+		MemoryReader << SaveGameFileVersion;
+		MemoryReader << PackageFileUEVersion;
+		MemoryReader << SavedEngineVersion;
+		MemoryReader << CustomVersionFormat;
+
+		FCustomVersionContainer CustomVersions;
+		OutBeginOffset = MemoryReader.Tell();
+		CustomVersions.Serialize(MemoryReader, static_cast<ECustomVersionSerializationFormat>(CustomVersionFormat));
+		OutEndOffset = MemoryReader.Tell();
+		return CustomVersions;
+	}
+
+	/** @returns copy of given save data (which must be the last one serialized) with given custom versions in its header, e.g. to simulate saves of other builds. */
+	TArray<uint8> ReplaceCustomVersionsInSaveData(const TArray<uint8>& SaveData, FCustomVersionContainer CustomVersions) const
+	{
+		int64 BeginOffset = 0, EndOffset = 0;
+		ReadCustomVersions(SaveData, OUT BeginOffset, OUT EndOffset);
+
+		TArray<uint8> CustomVersionData;
+		FMemoryWriter CustomVersionWriter(CustomVersionData, true);
+		CustomVersions.Serialize(CustomVersionWriter, ECustomVersionSerializationFormat::Latest);
+
+		TArray<uint8> NewSaveData(SaveData.GetData(), BeginOffset);
+		NewSaveData.Append(CustomVersionData);
+		NewSaveData.Append(SaveData.GetData() + EndOffset, SaveData.Num() - EndOffset);
+
+		// (i) The content begins with the absolute offset of the referenced assets table, which moves along with the header size:
+		const int64 SizeDelta = (CustomVersionData.Num() - (EndOffset - BeginOffset));
+		const int64 ContentOffset = (Serializer->GetLastSizeReport().HeaderBytes + SizeDelta);
+		int64 ReferencedAssetsOffset = 0;
+		FMemoryReader OffsetReader(NewSaveData, true);
+		OffsetReader.Seek(ContentOffset);
+		OffsetReader << ReferencedAssetsOffset;
+		ReferencedAssetsOffset += SizeDelta;
+		FMemoryWriter OffsetWriter(NewSaveData, true);
+		OffsetWriter.Seek(ContentOffset);
+		OffsetWriter << ReferencedAssetsOffset;
+		return NewSaveData;
+	}
+
+	/** @returns copy of given save data (which must be the last one serialized) with given asset paths as its referenced assets table. */
+	TArray<uint8> ReplaceReferencedAssetsInSaveData(const TArray<uint8>& SaveData, TArray<FString> AssetPaths) const
+	{
+		// (i) The table is at the very end, its absolute offset is stored at the beginning of the content:
+		int64 ReferencedAssetsOffset = 0;
+		FMemoryReader OffsetReader(SaveData, true);
+		OffsetReader.Seek(Serializer->GetLastSizeReport().HeaderBytes);
+		OffsetReader << ReferencedAssetsOffset;
+
+		TArray<uint8> NewSaveData(SaveData.GetData(), ReferencedAssetsOffset);
+		FMemoryWriter TableWriter(NewSaveData, true);
+		TableWriter.Seek(ReferencedAssetsOffset);
+		TableWriter << AssetPaths;
+		return NewSaveData;
+	}
+
+	/** Overwrites all (ANSI) occurrences of given string in the save data, e.g. to simulate renamed or removed classes. */
+	static int32 ReplaceStringInSaveData(TArray<uint8>& SaveData, const FString& From, const FString& To)
+	{
+		check(From.Len() == To.Len());
+		int32 NumReplaced = 0;
+		for (int32 Offset = 0; Offset + From.Len() <= SaveData.Num(); ++Offset)
+		{
+			bool bMatches = true;
+			for (int32 Index = 0; Index < From.Len() && bMatches; ++Index)
+			{
+				bMatches = (SaveData[Offset + Index] == static_cast<uint8>(From[Index]));
+			}
+			if (!bMatches)
+				continue;
+
+			for (int32 Index = 0; Index < From.Len(); ++Index)
+			{
+				SaveData[Offset + Index] = static_cast<uint8>(To[Index]);
+			}
+			++NumReplaced;
+		}
+		return NumReplaced;
+	}
+
+	void TestModulesAreRestored(const UModularSaveGame& RestoredSaveGame)
+	{
+		const USaveGameModule_PlayerStart* PlayerStartModule = RestoredSaveGame.FindModule<USaveGameModule_PlayerStart>();
+		const USaveGameModule_Cheats* CheatsModule = RestoredSaveGame.FindModule<USaveGameModule_Cheats>();
+		const USaveGameModule_SaveLoadDebugHistory* DebugHistoryModule = RestoredSaveGame.FindModule<USaveGameModule_SaveLoadDebugHistory>();
+		if (!TestNotNull("PlayerStartModule", PlayerStartModule) || !TestNotNull("CheatsModule", CheatsModule) || !TestNotNull("DebugHistoryModule", DebugHistoryModule))
+			return;
+
+		TestEqual("PlayerStartTag", PlayerStartModule->PlayerStartTag, FString("TestPlayerStart"));
+		TestEqual("WorldCoordinates", PlayerStartModule->WorldCoordinates.GetLocation(), FVector(1.0, 2.0, 3.0));
+		TestEqual("Number of CheatsToExecuteAfterTravel", CheatsModule->CheatsToExecuteAfterTravel.Num(), 2);
+		TestTrue("CheatsToExecuteAfterTravel contains cheat", CheatsModule->CheatsToExecuteAfterTravel.Contains("TestCheat 2"));
+		TestTrue("DebugHistory is restored", DebugHistoryModule->DebugHistory.Contains("TestEntry"));
+	}
+WE_END_DEFINE_SPEC(ModularSaveGameSerializer)
+{
+	BeforeEach([this]
+	{
+		bParallelModuleSerializationBefore = GetDefault<USaveGameServiceSettings>()->bParallelModuleSerialization;
+		Serializer.Reset(NewObject<UModularSaveGameSerializer>(GetTransientPackage()));
+		SaveGame.Reset(NewObject<UMockModularSaveGame>(GetTransientPackage()));
+
+		USaveGameModule_PlayerStart& PlayerStartModule = SaveGame->FindOrAddModule<USaveGameModule_PlayerStart>();
+		PlayerStartModule.PlayerStartTag = "TestPlayerStart";
+		PlayerStartModule.WorldCoordinates = FTransform(FVector(1.0, 2.0, 3.0));
+		SaveGame->FindOrAddModule<USaveGameModule_Cheats>().CheatsToExecuteAfterTravel = { "TestCheat 1", "TestCheat 2" };
+		SaveGame->FindOrAddModule<USaveGameModule_SaveLoadDebugHistory>().DebugHistory = { "TestEntry" };
+
+		UMockSaveGameModule_SchemaA& SchemaModule = SaveGame->FindOrAddModule<UMockSaveGameModule_SchemaA>();
+		SchemaModule.Score = 42;
+		SchemaModule.RemovedName = "TestName";
+		SchemaModule.Level = 7;
+
+		UMockSaveGameSubobject_A* SubobjectA = NewObject<UMockSaveGameSubobject_A>(SaveGame.Get());
+		UMockSaveGameSubobject_B* SubobjectB = NewObject<UMockSaveGameSubobject_B>(SaveGame.Get());
+		SubobjectA->Value = 1;
+		SubobjectB->Value = 2;
+		SaveGame->Subobjects = { SubobjectA, SubobjectB, SubobjectA };
+		SaveGame->Number = 3;
+	});
+
+	AfterEach([this]
+	{
+		GetMutableDefault<USaveGameServiceSettings>()->bParallelModuleSerialization = bParallelModuleSerializationBefore;
+		SaveGame.Reset();
+		Serializer.Reset();
+	});
+
+	Describe("TrySerializeSaveGame", [this]
+	{
+		It("should encode multiple modules into the same bytes, with or without parallel module serialization.", [this]
+		{
+			const TArray<uint8> ParallelSaveData = SerializeSaveGame(true);
+			const TArray<uint8> SingleThreadedSaveData = SerializeSaveGame(false);
+
+			TestFalse("SaveData is empty", ParallelSaveData.IsEmpty());
+			TestEqual("SaveData size", ParallelSaveData.Num(), SingleThreadedSaveData.Num());
+			TestTrue("SaveData is equal", ParallelSaveData == SingleThreadedSaveData);
+		});
+
+		It("should restore all modules, with or without parallel module serialization.", [this]
+		{
+			for (const bool bParallelModuleSerialization : { true, false })
+			{
+				const TArray<uint8> SaveData = SerializeSaveGame(bParallelModuleSerialization);
+				const UModularSaveGame* RestoredSaveGame = DeserializeSaveGame(SaveData);
+				if (!TestNotNull("RestoredSaveGame", RestoredSaveGame))
+					return;
+
+				TestModulesAreRestored(*RestoredSaveGame);
+			}
+		});
+
+		It("should write only the custom versions that were used into the header.", [this]
+		{
+			SaveGame->FindOrAddModule<UMockSaveGameModule_CustomVersion>().Value = 9;
+			const TArray<uint8> SaveData = SerializeSaveGame(true);
+
+			int64 BeginOffset = 0, EndOffset = 0;
+			const FCustomVersionContainer CustomVersions = ReadCustomVersions(SaveData, OUT BeginOffset, OUT EndOffset);
+			const FCustomVersion* MockCustomVersion = CustomVersions.GetVersion(FMockSaveGameCustomVersion::GUID);
+			if (!TestNotNull("Used custom version", MockCustomVersion))
+				return;
+
+			TestEqual("Used custom version", MockCustomVersion->Version, FMockSaveGameCustomVersion::LatestVersion);
+			TestTrue("Less custom versions than registered", CustomVersions.GetAllVersions().Num() < FCurrentCustomVersions::GetAll().GetAllVersions().Num());
+		});
+
+		It("should write the current file version.", [this]
+		{
+			const TArray<uint8> SaveData = SerializeSaveGame(true);
+			FMemoryReader MemoryReader(SaveData, true);
+			int32 FileTypeTag = 0, SaveGameFileVersion = 0;
+			MemoryReader << FileTypeTag;
+			MemoryReader << SaveGameFileVersion;
+
+			TestEqual("FileTypeTag", FileTypeTag, MODULAR_SAVEGAME_FILE_TYPE_TAG);
+			TestEqual("SaveGameFileVersion", SaveGameFileVersion, MODULAR_SAVEGAME_FILE_VERSION);
+		});
+	});
+
+	Describe("GetLastContentHash", [this]
+	{
+		It("should not change when only header counters, timestamps or modules that don't affect the content hash changed.", [this]
+		{
+			SerializeSaveGame(true);
+			const TOptional<uint64> ContentHash = Serializer->GetLastContentHash();
+
+			FSimpleSaveGameHeaderData& HeaderData = SaveGame->GetMutableHeaderData<FSimpleSaveGameHeaderData>();
+			HeaderData.SaveCounter += 1;
+			HeaderData.RestoreCounter += 1;
+			HeaderData.UtcTimeOfLastSave = FDateTime::UtcNow();
+			HeaderData.UtcTimeOfLastRestore = FDateTime::UtcNow();
+			SaveGame->FindOrAddModule<USaveGameModule_SaveLoadDebugHistory>().DebugHistory.Add("AnotherTestEntry");
+			SerializeSaveGame(true);
+
+			TestTrue("ContentHash is set", ContentHash.IsSet());
+			TestTrue("ContentHash is unchanged", Serializer->GetLastContentHash() == ContentHash);
+		});
+
+		It("should change when the content of a module changed.", [this]
+		{
+			SerializeSaveGame(true);
+			const TOptional<uint64> ContentHash = Serializer->GetLastContentHash();
+
+			SaveGame->FindOrAddModule<USaveGameModule_PlayerStart>().PlayerStartTag = "AnotherPlayerStart";
+			SerializeSaveGame(true);
+
+			TestTrue("ContentHash is set", Serializer->GetLastContentHash().IsSet());
+			TestTrue("ContentHash is changed", Serializer->GetLastContentHash() != ContentHash);
+		});
+
+		It("should change when the loaded level in the header changed.", [this]
+		{
+			SerializeSaveGame(true);
+			const TOptional<uint64> ContentHash = Serializer->GetLastContentHash();
+
+			SaveGame->GetMutableHeaderData<FSimpleSaveGameHeaderData>().LoadedLevel = FSoftObjectPath("/Game/Maps/AnotherTestLevel.AnotherTestLevel");
+			SerializeSaveGame(true);
+
+			TestTrue("ContentHash is set", Serializer->GetLastContentHash().IsSet());
+			TestTrue("ContentHash is changed", Serializer->GetLastContentHash() != ContentHash);
+		});
+	});
+
+	Describe("MeasureSaveGameSize", [this]
+	{
+		It("should report the size of the SaveGame without changing the results of the last serialization.", [this]
+		{
+			const TArray<uint8> SaveData = SerializeSaveGame(true);
+			const TOptional<uint64> ContentHash = Serializer->GetLastContentHash();
+
+			SaveGame->FindOrAddModule<USaveGameModule_PlayerStart>().PlayerStartTag = "AnotherPlayerStart";
+			const FSaveGameSizeReport SizeReport = Serializer->MeasureSaveGameSize(*SaveGame);
+
+			TestTrue("Measured TotalBytes", SizeReport.TotalBytes > 0);
+			TestEqual("Number of measured modules", SizeReport.BytesByModule.Num(), SaveGame->GetModules().Num());
+			TestTrue("ContentHash is unchanged", Serializer->GetLastContentHash() == ContentHash);
+			TestEqual("Last TotalBytes", Serializer->GetLastSizeReport().TotalBytes, static_cast<int64>(SaveData.Num()));
+		});
+	});
+
+	Describe("TryDeserializeSaveGame", [this]
+	{
+		It("should restore a SaveGame of the current file version, including schema-compiled modules.", [this]
+		{
+			const UModularSaveGame* RestoredSaveGame = DeserializeSaveGame(SerializeSaveGame(true));
+			if (!TestNotNull("RestoredSaveGame", RestoredSaveGame))
+				return;
+
+			TestModulesAreRestored(*RestoredSaveGame);
+			const UMockSaveGameModule_SchemaA* SchemaModule = RestoredSaveGame->FindModule<UMockSaveGameModule_SchemaA>();
+			if (!TestNotNull("SchemaModule", SchemaModule))
+				return;
+
+			TestEqual("Score", SchemaModule->Score, 42);
+			TestEqual("RemovedName", SchemaModule->RemovedName, FString("TestName"));
+			TestEqual("Level", SchemaModule->Level, 7);
+		});
+
+		It("should restore struct modules and call their hooks before saving and after restoring.", [this]
+		{
+			SaveGame->FindOrAddStructModule<FMockSaveGameStructModule>().Value = 5;
+			const UModularSaveGame* RestoredSaveGame = DeserializeSaveGame(SerializeSaveGame(true));
+			if (!TestNotNull("RestoredSaveGame", RestoredSaveGame))
+				return;
+
+			const FMockSaveGameStructModule* StructModule = RestoredSaveGame->FindStructModule<FMockSaveGameStructModule>();
+			if (!TestNotNull("StructModule", StructModule))
+				return;
+
+			TestEqual("Value", StructModule->Value, 5);
+			TestEqual("ValueWhenSaved", StructModule->ValueWhenSaved, 5);
+			TestTrue("bWasRestored", StructModule->bWasRestored);
+			TestFalse("bWasRestored of saved module", SaveGame->FindStructModule<FMockSaveGameStructModule>()->bWasRestored);
+		});
+
+		It("should restore modules with the custom versions they were saved with.", [this]
+		{
+			SaveGame->FindOrAddModule<UMockSaveGameModule_CustomVersion>().Value = 9;
+			const UModularSaveGame* RestoredSaveGame = DeserializeSaveGame(SerializeSaveGame(true));
+			const UMockSaveGameModule_CustomVersion* CustomVersionModule = (RestoredSaveGame ? RestoredSaveGame->FindModule<UMockSaveGameModule_CustomVersion>() : nullptr);
+			if (!TestNotNull("CustomVersionModule", CustomVersionModule))
+				return;
+
+			TestEqual("Value", CustomVersionModule->Value, 9);
+			TestEqual("LoadedCustomVersion", CustomVersionModule->LoadedCustomVersion, FMockSaveGameCustomVersion::LatestVersion);
+		});
+
+		It("should still restore SaveGames whose header lacks used custom versions or contains unknown ones.", [this]
+		{
+			SaveGame->FindOrAddModule<UMockSaveGameModule_CustomVersion>().Value = 9;
+			const TArray<uint8> SaveData = SerializeSaveGame(true);
+
+			int64 BeginOffset = 0, EndOffset = 0;
+			FCustomVersionContainer CustomVersions;
+			for (const FCustomVersion& CustomVersion : ReadCustomVersions(SaveData, OUT BeginOffset, OUT EndOffset).GetAllVersions())
+			{
+				if (CustomVersion.Key != FMockSaveGameCustomVersion::GUID)
+				{
+					CustomVersions.SetVersion(CustomVersion.Key, CustomVersion.Version, CustomVersion.GetFriendlyName());
+				}
+			}
+			CustomVersions.SetVersion(FGuid(0x1D2C3B4A, 0x5E6F7081, 0x92A3B4C5, 0xD6E7F809), 1, TEXT("UnknownVersion"));
+
+			const UModularSaveGame* RestoredSaveGame = DeserializeSaveGame(ReplaceCustomVersionsInSaveData(SaveData, CustomVersions));
+			if (!TestNotNull("RestoredSaveGame", RestoredSaveGame))
+				return;
+
+			TestModulesAreRestored(*RestoredSaveGame);
+			const UMockSaveGameModule_CustomVersion* CustomVersionModule = RestoredSaveGame->FindModule<UMockSaveGameModule_CustomVersion>();
+			if (!TestNotNull("CustomVersionModule", CustomVersionModule))
+				return;
+
+			TestEqual("Value", CustomVersionModule->Value, 9);
+			TestEqual("LoadedCustomVersion", CustomVersionModule->LoadedCustomVersion, static_cast<int32>(INDEX_NONE));
+		});
+
+		It("should restore sub-objects and keep those shared that were shared when saved.", [this]
+		{
+			const UMockModularSaveGame* RestoredSaveGame = Cast<UMockModularSaveGame>(DeserializeSaveGame(SerializeSaveGame(true)));
+			if (!TestNotNull("RestoredSaveGame", RestoredSaveGame) || !TestEqual("Number of Subobjects", RestoredSaveGame->Subobjects.Num(), 3))
+				return;
+
+			const UMockSaveGameSubobject_A* SubobjectA = Cast<UMockSaveGameSubobject_A>(RestoredSaveGame->Subobjects[0]);
+			const UMockSaveGameSubobject_B* SubobjectB = Cast<UMockSaveGameSubobject_B>(RestoredSaveGame->Subobjects[1]);
+			if (!TestNotNull("SubobjectA", SubobjectA) || !TestNotNull("SubobjectB", SubobjectB))
+				return;
+
+			TestEqual("SubobjectA Value", SubobjectA->Value, 1);
+			TestEqual("SubobjectB Value", SubobjectB->Value, 2);
+			TestTrue("SubobjectA is shared", RestoredSaveGame->Subobjects[2].Get() == SubobjectA);
+			TestEqual("Number", RestoredSaveGame->Number, 3);
+		});
+
+		It("should still restore SaveGames of file version 1.", [this]
+		{
+			const UMockModularSaveGame* RestoredSaveGame = Cast<UMockModularSaveGame>(DeserializeSaveGame(SerializeSaveGameAsFileVersion1()));
+			if (!TestNotNull("RestoredSaveGame", RestoredSaveGame))
+				return;
+
+			TestModulesAreRestored(*RestoredSaveGame);
+			const UMockSaveGameModule_SchemaA* SchemaModule = RestoredSaveGame->FindModule<UMockSaveGameModule_SchemaA>();
+			if (TestNotNull("SchemaModule", SchemaModule))
+			{
+				TestEqual("Score", SchemaModule->Score, 42);
+				TestEqual("Level", SchemaModule->Level, 7);
+			}
+			if (TestEqual("Number of Subobjects", RestoredSaveGame->Subobjects.Num(), 3))
+			{
+				const UMockSaveGameSubobject_B* SubobjectB = Cast<UMockSaveGameSubobject_B>(RestoredSaveGame->Subobjects[1]);
+				TestTrue("SubobjectB is restored", SubobjectB && SubobjectB->Value == 2);
+			}
+			TestEqual("Number", RestoredSaveGame->Number, 3);
+		});
+
+		It("should match fields by name when the schema of a module changed, skipping fields that don't exist anymore.", [this]
+		{
+			// (i) Loading the module saved as SchemaA into SchemaB, whose RemovedName field was renamed to RenamedName:
+			TArray<uint8> SaveData = SerializeSaveGame(true);
+			if (!TestTrue("Module class was replaced", ReplaceStringInSaveData(SaveData, "MockSaveGameModule_SchemaA", "MockSaveGameModule_SchemaB") > 0))
+				return;
+
+			const UModularSaveGame* RestoredSaveGame = DeserializeSaveGame(SaveData);
+			if (!TestNotNull("RestoredSaveGame", RestoredSaveGame))
+				return;
+
+			TestModulesAreRestored(*RestoredSaveGame);
+			const UMockSaveGameModule_SchemaB* SchemaModule = RestoredSaveGame->FindModule<UMockSaveGameModule_SchemaB>();
+			if (!TestNotNull("SchemaModule", SchemaModule))
+				return;
+
+			TestEqual("Score", SchemaModule->Score, 42);
+			TestTrue("RenamedName is not restored", SchemaModule->RenamedName.IsEmpty());
+			TestEqual("Level", SchemaModule->Level, 7);
+		});
+
+		It("should skip modules whose class does not exist anymore.", [this]
+		{
+			TArray<uint8> SaveData = SerializeSaveGame(true);
+			if (!TestTrue("Module class was replaced", ReplaceStringInSaveData(SaveData, "MockSaveGameModule_SchemaA", "MockSaveGameModule_SchemaX") > 0))
+				return;
+
+			const UModularSaveGame* RestoredSaveGame = DeserializeSaveGame(SaveData);
+			if (!TestNotNull("RestoredSaveGame", RestoredSaveGame))
+				return;
+
+			TestModulesAreRestored(*RestoredSaveGame);
+			TestFalse("Has skipped module", RestoredSaveGame->HasModule(FName("MockSchemaModule")));
+		});
+
+		It("should skip sub-objects whose class does not exist anymore.", [this]
+		{
+			TArray<uint8> SaveData = SerializeSaveGame(true);
+			if (!TestTrue("Sub-object class was replaced", ReplaceStringInSaveData(SaveData, "MockSaveGameSubobject_B", "MockSaveGameSubobject_X") > 0))
+				return;
+
+			const UMockModularSaveGame* RestoredSaveGame = Cast<UMockModularSaveGame>(DeserializeSaveGame(SaveData));
+			if (!TestNotNull("RestoredSaveGame", RestoredSaveGame) || !TestEqual("Number of Subobjects", RestoredSaveGame->Subobjects.Num(), 3))
+				return;
+
+			const UMockSaveGameSubobject_A* SubobjectA = Cast<UMockSaveGameSubobject_A>(RestoredSaveGame->Subobjects[0]);
+			TestTrue("SubobjectA is restored", SubobjectA && SubobjectA->Value == 1);
+			TestNull("Skipped sub-object", RestoredSaveGame->Subobjects[1].Get());
+			TestTrue("SubobjectA is still shared", RestoredSaveGame->Subobjects[2].Get() == SubobjectA);
+			TestEqual("Number", RestoredSaveGame->Number, 3);
+			TestModulesAreRestored(*RestoredSaveGame);
+		});
+	});
+
+	Describe("GetUnloadedReferencedAssets", [this]
+	{
+		It("should list referenced assets that are not loaded yet.", [this]
+		{
+			static const FString UnloadedAssetPath = "/Engine/WeekendUtilsTests/UnloadedAsset.UnloadedAsset";
+			static const FString LoadedAssetPath = "/Engine/EngineResources/DefaultTexture.DefaultTexture";
+			if (!TestNotNull("Loaded asset", LoadObject<UObject>(nullptr, *LoadedAssetPath)))
+				return;
+
+			const TArray<uint8> SaveData = ReplaceReferencedAssetsInSaveData(SerializeSaveGame(true), { UnloadedAssetPath, LoadedAssetPath });
+			TArray<FSoftObjectPath> UnloadedAssets;
+			Serializer->GetUnloadedReferencedAssets(SaveData, OUT UnloadedAssets);
+			if (TestEqual("Number of unloaded assets", UnloadedAssets.Num(), 1))
+			{
+				TestEqual("Unloaded asset", UnloadedAssets[0].ToString(), UnloadedAssetPath);
+			}
+		});
+
+		It("should not list assets that are already loaded, which are then restored right away.", [this]
+		{
+			SaveGame->ReferencedAsset = LoadObject<UObject>(nullptr, TEXT("/Engine/EngineResources/DefaultTexture.DefaultTexture"));
+			if (!TestNotNull("ReferencedAsset", SaveGame->ReferencedAsset.Get()))
+				return;
+
+			const TArray<uint8> SaveData = SerializeSaveGame(true);
+			TArray<FSoftObjectPath> UnloadedAssets;
+			Serializer->GetUnloadedReferencedAssets(SaveData, OUT UnloadedAssets);
+			TestEqual("Number of unloaded assets", UnloadedAssets.Num(), 0);
+
+			const UMockModularSaveGame* RestoredSaveGame = nullptr;
+			Serializer->AsyncDeserializeSaveGame(SaveData, USaveGameSerializer::FOnAsyncDeserializeCompleted::CreateLambda([&](USaveGame* DeserializedSaveGame)
+			{
+				RestoredSaveGame = Cast<UMockModularSaveGame>(DeserializedSaveGame);
+			}));
+			if (TestNotNull("SaveGame restored synchronously", RestoredSaveGame))
+			{
+				TestTrue("ReferencedAsset", RestoredSaveGame->ReferencedAsset == SaveGame->ReferencedAsset);
+			}
+		});
+
+		It("should not list any assets for SaveGames of file version 1.", [this]
+		{
+			TArray<FSoftObjectPath> UnloadedAssets;
+			Serializer->GetUnloadedReferencedAssets(SerializeSaveGameAsFileVersion1(), OUT UnloadedAssets);
+			TestEqual("Number of unloaded assets", UnloadedAssets.Num(), 0);
+		});
+	});
+}
+
+#undef SPEC_TEST_CATEGORY
+#endif WITH_AUTOMATION_WORKER
@@ -0,0 +1,144 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#if WITH_AUTOMATION_WORKER
+
+#include "AutomationTest/AutomationSpecMacros.h"
+#include "SaveGame/SaveGameBufferPool.h"
+
+#define SPEC_TEST_CATEGORY "WeekendUtils.SaveGame"
+
+WE_BEGIN_DEFINE_SPEC(SaveGameBufferPool)
+	static constexpr int64 Budget = 64 * 1024;
+	TSharedPtr<FSaveGameBufferPool, ESPMode::ThreadSafe> BufferPool;
+
+	/** @returns capacity an empty array actually gets when reserving given size, which the allocator may round up. */
+	static int64 GetReservedCapacity(int32 NumBytes)
+	{
+		TArray<uint8> Array;
+		Array.Reserve(NumBytes);
+		return Array.Max();
+	}
+WE_END_DEFINE_SPEC(SaveGameBufferPool)
+{
+	BeforeEach([this]
+	{
+		BufferPool = MakeShared<FSaveGameBufferPool, ESPMode::ThreadSafe>(Budget);
+	});
+
+	AfterEach([this]
+	{
+		BufferPool.Reset();
+	});
+
+	Describe("Acquire", [this]
+	{
+		It("should hand out empty buffers with at least the requested capacity.", [this]
+		{
+			const TSharedRef<TArray<uint8>> Buffer = BufferPool->Acquire(1024);
+			TestTrue("Buffer is empty", Buffer->IsEmpty());
+			TestTrue("Buffer capacity", Buffer->Max() >= 1024);
+			TestEqual("InUseBytes", BufferPool->GetStats().InUseBytes, static_cast<int64>(Buffer->Max()));
+		});
+
+		It("should reuse the smallest released buffer that fits.", [this]
+		{
+			TSharedPtr<TArray<uint8>> SmallBuffer = BufferPool->Acquire(4 * 1024);
+			TSharedPtr<TArray<uint8>> LargeBuffer = BufferPool->Acquire(16 * 1024);
+			const uint8* SmallBufferData = SmallBuffer->GetData();
+			SmallBuffer.Reset();
+			LargeBuffer.Reset();
+
+			const TSharedRef<TArray<uint8>> ReusedBuffer = BufferPool->Acquire(2 * 1024);
+			const FSaveGameBufferPoolStats Stats = BufferPool->GetStats();
+			TestTrue("Small buffer is reused", ReusedBuffer->GetData() == SmallBufferData);
+			TestEqual("NumAcquires", Stats.NumAcquires, 3);
+			TestEqual("NumHits", Stats.NumHits, 1);
+		});
+	});
+
+	Describe("Release", [this]
+	{
+		It("should pool released buffers until they are trimmed.", [this]
+		{
+			BufferPool->Acquire(16 * 1024);
+			TestTrue("PooledBytes after release", BufferPool->GetStats().PooledBytes >= 16 * 1024);
+			TestEqual("InUseBytes after release", BufferPool->GetStats().InUseBytes, 0LL);
+
+			BufferPool->Trim();
+			TestEqual("PooledBytes after trim", BufferPool->GetStats().PooledBytes, 0LL);
+		});
+
+		It("should count buffers that grew beyond their capacity and pool them with their grown capacity.", [this]
+		{
+			TSharedPtr<TArray<uint8>> Buffer = BufferPool->Acquire(1024);
+			Buffer->SetNumUninitialized(16 * 1024);
+			const int64 GrownCapacity = Buffer->Max();
+			Buffer.Reset();
+
+			FSaveGameBufferPoolStats Stats = BufferPool->GetStats();
+			TestEqual("NumGrownBuffers", Stats.NumGrownBuffers, 1);
+			TestEqual("PooledBytes", Stats.PooledBytes, GrownCapacity);
+			TestEqual("InUseBytes", Stats.InUseBytes, 0LL);
+
+			BufferPool->Acquire(GrownCapacity);
+			Stats = BufferPool->GetStats();
+			TestEqual("NumHits", Stats.NumHits, 1);
+			TestEqual("NumGrownBuffers after reuse", Stats.NumGrownBuffers, 1);
+		});
+
+		It("should free grown buffers that exceed the budget on their own.", [this]
+		{
+			TSharedPtr<TArray<uint8>> Buffer = BufferPool->Acquire(1024);
+			Buffer->SetNumUninitialized(2 * Budget);
+			Buffer.Reset();
+
+			const FSaveGameBufferPoolStats Stats = BufferPool->GetStats();
+			TestEqual("NumGrownBuffers", Stats.NumGrownBuffers, 1);
+			TestEqual("PooledBytes", Stats.PooledBytes, 0LL);
+			TestEqual("InUseBytes", Stats.InUseBytes, 0LL);
+		});
+
+		It("should evict the smallest pooled buffers to make room for a grown buffer within the budget.", [this]
+		{
+			// (i) Budget fits the large and the grown buffer, but not the small one next to them:
+			const int64 LargePooledCapacity = GetReservedCapacity(16 * 1024);
+			const int64 GrownCapacity = GetReservedCapacity(24 * 1024);
+			BufferPool = MakeShared<FSaveGameBufferPool, ESPMode::ThreadSafe>(LargePooledCapacity + GrownCapacity);
+
+			// (i) All buffers are acquired up front, otherwise the growing one would be served with a pooled buffer:
+			TSharedPtr<TArray<uint8>> SmallPooledBuffer = BufferPool->Acquire(4 * 1024);
+			TSharedPtr<TArray<uint8>> LargePooledBuffer = BufferPool->Acquire(16 * 1024);
+			TSharedPtr<TArray<uint8>> GrowingBuffer = BufferPool->Acquire(1024);
+			SmallPooledBuffer.Reset();
+			LargePooledBuffer.Reset();
+
+			GrowingBuffer->Reserve(24 * 1024);
+			if (!TestEqual("Grown capacity", static_cast<int64>(GrowingBuffer->Max()), GrownCapacity))
+				return;
+
+			GrowingBuffer.Reset();
+			const FSaveGameBufferPoolStats Stats = BufferPool->GetStats();
+			TestEqual("NumGrownBuffers", Stats.NumGrownBuffers, 1);
+			TestEqual("PooledBytes", Stats.PooledBytes, LargePooledCapacity + GrownCapacity);
+			TestTrue("PeakBytes", Stats.PeakBytes >= Stats.PooledBytes);
+		});
+
+		It("should free buffers that are released after the pool is gone.", [this]
+		{
+			const TSharedRef<TArray<uint8>> Buffer = BufferPool->Acquire(1024);
+			BufferPool.Reset();
+			Buffer->Add(1);
+			TestEqual("Buffer is still usable", Buffer->Num(), 1);
+		});
+	});
+}
+
+#undef SPEC_TEST_CATEGORY
+#endif WITH_AUTOMATION_WORKER
@@ -0,0 +1,252 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#if WITH_AUTOMATION_WORKER
+
+#include "AutomationTest/AutomationSpecMacros.h"
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/Paths.h"
+#include "SaveGame/SaveGameChunkStore.h"
+
+#define SPEC_TEST_CATEGORY "WeekendUtils.SaveGame"
+
+WE_BEGIN_DEFINE_SPEC(SaveGameChunkStore)
+	FString Directory;
+	TUniquePtr<FSaveGameChunkStore> ChunkStore;
+	TArray<uint8> OldData;
+	TArray<uint8> NewData; // (i) OldData with bytes inserted at the front and a different tail, so most chunks are shared.
+	FSaveGameChunkList OldChunkList;
+	FSaveGameChunkList NewChunkList;
+
+	static TArray<uint8> MakeRandomData(int32 NumBytes, int32 Seed)
+	{
+		FRandomStream RandomStream(Seed);
+		TArray<uint8> Data;
+		Data.SetNumUninitialized(NumBytes);
+		for (uint8& Byte : Data)
+		{
+			Byte = static_cast<uint8>(RandomStream.RandHelper(256));
+		}
+		return Data;
+	}
+
+	static int32 CountChunksNotIn(const FSaveGameChunkList& ChunkList, const FSaveGameChunkList& OtherChunkList)
+	{
+		int32 NumChunks = 0;
+		for (const FSaveGameChunkId& ChunkId : ChunkList.Chunks)
+		{
+			NumChunks += (OtherChunkList.Chunks.Contains(ChunkId) ? 0 : 1);
+		}
+		return NumChunks;
+	}
+
+	bool TryWriteAndReference(const TArray<uint8>& Data, const FSaveGameChunkList& ChunkList)
+	{
+		int64 WrittenBytes = 0;
+		if (!ChunkStore->TryWriteChunks(Data, ChunkList, OUT WrittenBytes))
+			return false;
+
+		ChunkStore->AddReferences(ChunkList);
+		return true;
+	}
+
+	bool CanAssemble(const FSaveGameChunkList& ChunkList, const TArray<uint8>& ExpectedData) const
+	{
+		TArray<uint8> AssembledData;
+		return (ChunkStore->TryAssembleData(ChunkList, OUT AssembledData) && AssembledData == ExpectedData);
+	}
+WE_END_DEFINE_SPEC(SaveGameChunkStore)
+{
+	BeforeEach([this]
+	{
+		Directory = FPaths::AutomationTransientDir() / TEXT("SaveGameChunkStore");
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+		ChunkStore = MakeUnique<FSaveGameChunkStore>(Directory);
+
+		OldData = MakeRandomData(256 * 1024, 1);
+		NewData = MakeRandomData(100, 2);
+		NewData.Append(OldData.GetData(), 192 * 1024);
+		NewData.Append(MakeRandomData(64 * 1024, 3));
+		OldChunkList = FSaveGameChunkStore::SplitIntoChunks(OldData);
+		NewChunkList = FSaveGameChunkStore::SplitIntoChunks(NewData);
+	});
+
+	AfterEach([this]
+	{
+		ChunkStore.Reset();
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	});
+
+	Describe("SplitIntoChunks", [this]
+	{
+		It("should split data into chunks within the size limits, which add up to the data.", [this]
+		{
+			int64 TotalSize = 0;
+			for (int32 i = 0; i < OldChunkList.Chunks.Num(); ++i)
+			{
+				const int32 ChunkSize = OldChunkList.Chunks[i].Size;
+				TestTrue("Chunk is not larger than MaxChunkSize", ChunkSize <= FSaveGameChunkStore::MaxChunkSize);
+				TestTrue("Chunk (except for the last) is not smaller than MinChunkSize", ChunkSize >= FSaveGameChunkStore::MinChunkSize || i == OldChunkList.Chunks.Num() - 1);
+				TotalSize += ChunkSize;
+			}
+			TestTrue("Data is split into multiple chunks", OldChunkList.Chunks.Num() > 1);
+			TestEqual("TotalSize", OldChunkList.TotalSize, static_cast<int64>(OldData.Num()));
+			TestEqual("Sum of chunk sizes", TotalSize, OldChunkList.TotalSize);
+		});
+
+		It("should produce the same chunks for unchanged data behind an insertion.", [this]
+		{
+			const int32 NumSharedChunks = (NewChunkList.Chunks.Num() - CountChunksNotIn(NewChunkList, OldChunkList));
+			TestTrue("Most chunks of the unchanged data are shared", NumSharedChunks >= CountChunksNotIn(OldChunkList, NewChunkList));
+			TestTrue("Some chunks are shared", NumSharedChunks > 0);
+		});
+	});
+
+	Describe("TryWriteChunks", [this]
+	{
+		It("should only write chunks that aren't stored yet.", [this]
+		{
+			int64 WrittenBytes = 0;
+			TestTrue("Old chunks are written", ChunkStore->TryWriteChunks(OldData, OldChunkList, OUT WrittenBytes));
+			TestEqual("Written bytes of old chunks", WrittenBytes, OldChunkList.TotalSize);
+
+			TestTrue("Old chunks are written again", ChunkStore->TryWriteChunks(OldData, OldChunkList, OUT WrittenBytes));
+			TestEqual("Written bytes of old chunks again", WrittenBytes, 0LL);
+
+			TestTrue("New chunks are written", ChunkStore->TryWriteChunks(NewData, NewChunkList, OUT WrittenBytes));
+			TestTrue("Only new chunks are written", WrittenBytes > 0 && WrittenBytes < NewChunkList.TotalSize);
+
+			TestTrue("Old data can be assembled", CanAssemble(OldChunkList, OldData));
+			TestTrue("New data can be assembled", CanAssemble(NewChunkList, NewData));
+		});
+	});
+
+	Describe("CollectGarbage", [this]
+	{
+		It("should only delete chunks that no chunk list references anymore.", [this]
+		{
+			if (!TestTrue("Old chunks are written", TryWriteAndReference(OldData, OldChunkList)))
+				return;
+
+			TestEqual("Deleted chunks while referenced", ChunkStore->CollectGarbage(), 0);
+			TestTrue("Old data can be assembled", CanAssemble(OldChunkList, OldData));
+
+			ChunkStore->ReleaseReferences(OldChunkList);
+			TestEqual("Deleted chunks after release", ChunkStore->CollectGarbage(), OldChunkList.Chunks.Num());
+			TestEqual("NumChunks", ChunkStore->GetNumChunks(), 0);
+
+			const FSaveGameChunkStoreIntegrityReport Report = ChunkStore->VerifyIntegrity({}, false);
+			TestEqual("NumUnreferencedChunks", Report.NumUnreferencedChunks, 0);
+			TestEqual("StoredBytes", Report.StoredBytes, 0LL);
+		});
+
+		It("should keep the chunks of a backup, after its slot was saved again.", [this]
+		{
+			// (i) Moving the save file into the backup folder keeps its references, so the next save of the slot has no previous chunk list to release.
+			if (!TestTrue("Old chunks are written", TryWriteAndReference(OldData, OldChunkList)) || !TestTrue("New chunks are written", TryWriteAndReference(NewData, NewChunkList)))
+				return;
+
+			TestEqual("Deleted chunks", ChunkStore->CollectGarbage(), 0);
+			TestTrue("Backup can be assembled", CanAssemble(OldChunkList, OldData));
+			TestTrue("Slot can be assembled", CanAssemble(NewChunkList, NewData));
+
+			const FSaveGameChunkStoreIntegrityReport Report = ChunkStore->VerifyIntegrity({ { "Backup/Slot.sav", OldChunkList }, { "Slot.sav", NewChunkList } }, false);
+			TestTrue("Chunk store is healthy", Report.IsHealthy());
+			TestEqual("NumUnreferencedChunks", Report.NumUnreferencedChunks, 0);
+			TestEqual("NumWrongReferenceCounts", Report.NumWrongReferenceCounts, 0);
+		});
+
+		It("should delete the chunks of a deleted backup, except for those its slot still references.", [this]
+		{
+			if (!TestTrue("Old chunks are written", TryWriteAndReference(OldData, OldChunkList)) || !TestTrue("New chunks are written", TryWriteAndReference(NewData, NewChunkList)))
+				return;
+
+			ChunkStore->ReleaseReferences(OldChunkList);
+			TestEqual("Deleted chunks", ChunkStore->CollectGarbage(), CountChunksNotIn(OldChunkList, NewChunkList));
+			TestTrue("Slot can be assembled", CanAssemble(NewChunkList, NewData));
+
+			const FSaveGameChunkStoreIntegrityReport Report = ChunkStore->VerifyIntegrity({ { "Slot.sav", NewChunkList } }, false);
+			TestTrue("Chunk store is healthy", Report.IsHealthy());
+			TestEqual("NumUnreferencedChunks", Report.NumUnreferencedChunks, 0);
+			TestEqual("NumWrongReferenceCounts", Report.NumWrongReferenceCounts, 0);
+		});
+
+	});
+
+	Describe("TryLoadIndex", [this]
+	{
+		It("should restore the reference counts of the last saved index.", [this]
+		{
+			if (!TestTrue("Old chunks are written", TryWriteAndReference(OldData, OldChunkList)) || !TestTrue("New chunks are written", TryWriteAndReference(NewData, NewChunkList)))
+				return;
+
+			TestTrue("Index is saved", ChunkStore->TrySaveIndex());
+			const int32 NumChunks = ChunkStore->GetNumChunks();
+			ChunkStore = MakeUnique<FSaveGameChunkStore>(Directory);
+			if (!TestTrue("Index is loaded", ChunkStore->TryLoadIndex()))
+				return;
+
+			TestEqual("NumChunks", ChunkStore->GetNumChunks(), NumChunks);
+			TestEqual("NumWrongReferenceCounts", ChunkStore->VerifyIntegrity({ { "Backup/Slot.sav", OldChunkList }, { "Slot.sav", NewChunkList } }, false).NumWrongReferenceCounts, 0);
+			TestEqual("Deleted chunks", ChunkStore->CollectGarbage(), 0);
+		});
+
+		It("should fail without index file, so references can be rebuilt from the chunk lists.", [this]
+		{
+			if (!TestTrue("Old chunks are written", TryWriteAndReference(OldData, OldChunkList)))
+				return;
+
+			ChunkStore = MakeUnique<FSaveGameChunkStore>(Directory);
+			TestFalse("Index is loaded", ChunkStore->TryLoadIndex());
+
+			ChunkStore->RebuildReferences({ { "Slot.sav", OldChunkList } });
+			TestEqual("NumWrongReferenceCounts", ChunkStore->VerifyIntegrity({ { "Slot.sav", OldChunkList } }, false).NumWrongReferenceCounts, 0);
+			TestEqual("Deleted chunks", ChunkStore->CollectGarbage(), 0);
+		});
+	});
+
+	Describe("VerifyIntegrity", [this]
+	{
+		It("should find unreferenced chunks and delete them when repairing.", [this]
+		{
+			// (i) Chunks that were written but never referenced, like after an interrupted save:
+			int64 WrittenBytes = 0;
+			if (!TestTrue("Old chunks are written", ChunkStore->TryWriteChunks(OldData, OldChunkList, OUT WrittenBytes)))
+				return;
+
+			FSaveGameChunkStoreIntegrityReport Report = ChunkStore->VerifyIntegrity({}, true);
+			TestEqual("NumUnreferencedChunks before repair", Report.NumUnreferencedChunks, OldChunkList.Chunks.Num());
+
+			Report = ChunkStore->VerifyIntegrity({}, false);
+			TestEqual("NumUnreferencedChunks after repair", Report.NumUnreferencedChunks, 0);
+			TestEqual("StoredBytes after repair", Report.StoredBytes, 0LL);
+		});
+
+		It("should report chunk lists that reference missing chunks.", [this]
+		{
+			if (!TestTrue("Old chunks are written", TryWriteAndReference(OldData, OldChunkList)))
+				return;
+
+			TArray<FString> ChunkFiles;
+			IFileManager::Get().FindFilesRecursive(OUT ChunkFiles, *Directory, TEXT("*.chunk"), true, false);
+			if (!TestTrue("Chunk files exist", ChunkFiles.Num() > 0))
+				return;
+
+			IFileManager::Get().Delete(*ChunkFiles[0]);
+			const FSaveGameChunkStoreIntegrityReport Report = ChunkStore->VerifyIntegrity({ { "Slot.sav", OldChunkList } }, false);
+			TestFalse("Chunk store is healthy", Report.IsHealthy());
+			TestEqual("NumMissingChunks", Report.NumMissingChunks, 1);
+			TestTrue("Slot is reported as broken", Report.BrokenChunkLists.Contains("Slot.sav"));
+		});
+	});
+}
+
+#undef SPEC_TEST_CATEGORY
+#endif WITH_AUTOMATION_WORKER
@@ -0,0 +1,105 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#if WITH_AUTOMATION_WORKER
+
+#include "AutomationTest/AutomationSpecMacros.h"
+#include "SaveGame/SaveGameDebugHistory.h"
+
+#define SPEC_TEST_CATEGORY "WeekendUtils.SaveGame"
+
+WE_BEGIN_DEFINE_SPEC(SaveGameDebugHistory)
+	FSaveLoadDebugHistory DebugHistory;
+	int32 NumAddedEntries = 0;
+
+	/** Adds entries with consecutive operation names: Op0, Op1, ... */
+	void AddEntries(int32 NumEntries)
+	{
+		for (int32 Index = 0; Index < NumEntries; ++Index)
+		{
+			DebugHistory.Add(FSaveLoadDebugEntry(*FString::Printf(TEXT("Op%d"), NumAddedEntries++)));
+		}
+	}
+
+	/** @returns operations of all kept entries, oldest first. */
+	FString GetOperations() const
+	{
+		TArray<FString> Operations;
+		for (int32 Index = 0; Index < DebugHistory.Num(); ++Index)
+		{
+			Operations.Add(DebugHistory[Index].Operation.ToString());
+		}
+		return FString::Join(Operations, TEXT(","));
+	}
+WE_END_DEFINE_SPEC(SaveGameDebugHistory)
+{
+	BeforeEach([this]
+	{
+		DebugHistory = FSaveLoadDebugHistory();
+		NumAddedEntries = 0;
+		DebugHistory.SetCapacity(3);
+	});
+
+	Describe("Add", [this]
+	{
+		It("should overwrite the oldest entries once the capacity is reached.", [this]
+		{
+			AddEntries(5);
+			TestEqual("Num", DebugHistory.Num(), 3);
+			TestEqual("Kept operations", GetOperations(), FString("Op2,Op3,Op4"));
+		});
+
+		It("should keep nothing with a capacity of 0.", [this]
+		{
+			DebugHistory.SetCapacity(0);
+			AddEntries(2);
+			TestEqual("Num", DebugHistory.Num(), 0);
+		});
+	});
+
+	Describe("SetCapacity", [this]
+	{
+		It("should drop the oldest entries when shrinking.", [this]
+		{
+			AddEntries(3);
+			DebugHistory.SetCapacity(2);
+			TestEqual("Capacity", DebugHistory.GetCapacity(), 2);
+			TestEqual("Kept operations", GetOperations(), FString("Op1,Op2"));
+		});
+	});
+
+	Describe("FormatMostRecent", [this]
+	{
+		It("should only format the most recent entries, oldest first.", [this]
+		{
+			AddEntries(3);
+			const TArray<FString> Formatted = DebugHistory.FormatMostRecent(2);
+			if (!TestEqual("Num formatted", Formatted.Num(), 2))
+				return;
+
+			TestTrue("First formatted entry", Formatted[0].Contains("[Op1]"));
+			TestTrue("Second formatted entry", Formatted[1].Contains("[Op2]"));
+			TestEqual("Num formatted beyond kept entries", DebugHistory.FormatMostRecent(10).Num(), 3);
+		});
+
+		It("should include slot and result of an entry.", [this]
+		{
+			FSaveLoadDebugEntry Entry("Save", "Test", "Slot1");
+			Entry.SetResult(false, 0.5);
+			DebugHistory.Add(MoveTemp(Entry));
+			const FString Formatted = DebugHistory.FormatAll()[0];
+			TestTrue("Contains result", Formatted.Contains("failed"));
+			TestTrue("Contains slot", Formatted.Contains("Slot: Slot1"));
+			TestTrue("Contains context", Formatted.Contains("Context: Test"));
+		});
+	});
+}
+
+#undef SPEC_TEST_CATEGORY
+#endif WITH_AUTOMATION_WORKER
@@ -0,0 +1,77 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#if WITH_AUTOMATION_WORKER
+
+#include "AutomationTest/AutomationSpecMacros.h"
+#include "SaveGame/SaveGameMetrics.h"
+
+#define SPEC_TEST_CATEGORY "WeekendUtils.SaveGame"
+
+WE_BEGIN_DEFINE_SPEC(SaveGameMetrics)
+	FSaveLoadMetricsRecorder Recorder;
+
+	static FSaveLoadMetrics MakeSaveMetrics(bool bSuccess)
+	{
+		FSaveLoadMetrics Metrics(ESaveLoadOperation::Save, "Test");
+		Metrics.bSuccess = bSuccess;
+		Metrics.NumBytes = 1024;
+		Metrics.SetPhaseTime(ESaveLoadPhase::QueueWait, 0.001);
+		Metrics.SetPhaseTime(ESaveLoadPhase::Serialize, 0.002);
+		Metrics.SetPhaseTime(ESaveLoadPhase::Total, 0.003);
+		return Metrics;
+	}
+WE_END_DEFINE_SPEC(SaveGameMetrics)
+{
+	BeforeEach([this]
+	{
+		Recorder.Reset();
+	});
+
+	Describe("FSaveLoadMetricsRecorder::Record", [this]
+	{
+		It("should only add latency samples for phases that ran.", [this]
+		{
+			Recorder.Record(MakeSaveMetrics(true));
+
+			const FSaveLoadOperationStats& SaveStats = Recorder.GetStats(ESaveLoadOperation::Save);
+			TestEqual("NumOperations", SaveStats.NumOperations, 1);
+			TestEqual("Serialize samples", SaveStats.GetHistogram(ESaveLoadPhase::Serialize).Num(), 1);
+			TestEqual("Total samples", SaveStats.GetHistogram(ESaveLoadPhase::Total).Num(), 1);
+			TestEqual("Deferral samples", SaveStats.GetHistogram(ESaveLoadPhase::Deferral).Num(), 0);
+			TestEqual("IO samples", SaveStats.GetHistogram(ESaveLoadPhase::IO).Num(), 0);
+		});
+
+		It("should count failed operations without adding them to the latency histograms.", [this]
+		{
+			Recorder.Record(MakeSaveMetrics(true));
+			Recorder.Record(MakeSaveMetrics(false));
+
+			const FSaveLoadOperationStats& SaveStats = Recorder.GetStats(ESaveLoadOperation::Save);
+			TestEqual("NumOperations", SaveStats.NumOperations, 2);
+			TestEqual("NumFailures", SaveStats.NumFailures, 1);
+			TestEqual("Total samples", SaveStats.GetHistogram(ESaveLoadPhase::Total).Num(), 1);
+			TestTrue("LastMetrics is the failed operation", SaveStats.LastMetrics.IsSet() && !SaveStats.LastMetrics->bSuccess);
+		});
+
+		It("should keep the stats of restored snapshots apart from loads.", [this]
+		{
+			FSaveLoadMetrics Metrics(ESaveLoadOperation::RestoreSnapshot, "Test");
+			Metrics.bSuccess = true;
+			Metrics.SetPhaseTime(ESaveLoadPhase::Total, 0.001);
+			Recorder.Record(Metrics);
+
+			TestEqual("RestoreSnapshot operations", Recorder.GetStats(ESaveLoadOperation::RestoreSnapshot).NumOperations, 1);
+			TestEqual("Load operations", Recorder.GetStats(ESaveLoadOperation::Load).NumOperations, 0);
+		});
+	});
+}
+
+#undef SPEC_TEST_CATEGORY
+#endif WITH_AUTOMATION_WORKER
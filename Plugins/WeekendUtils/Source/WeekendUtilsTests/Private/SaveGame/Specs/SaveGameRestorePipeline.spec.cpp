@@ -0,0 +1,120 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#if WITH_AUTOMATION_WORKER
+
+#include "AutomationTest/AutomationSpecMacros.h"
+#include "SaveGame/SaveGameRestorePipeline.h"
+
+#define SPEC_TEST_CATEGORY "WeekendUtils.SaveGame"
+
+WE_BEGIN_DEFINE_SPEC(SaveGameRestorePipeline)
+	TSharedPtr<FSaveGameRestorePipeline> RestorePipeline;
+	TArray<FString> RestoredListeners;
+
+	void AddListener(ESaveGameRestoreTier Tier, const FString& Name, int32 Priority = 0, float SleepSeconds = 0.0f)
+	{
+		RestorePipeline->Add(Tier, FSaveGameRestorePipeline::FRestoreStep::CreateLambda([this, Name, SleepSeconds](const FCurrentSaveGame&)
+		{
+			if (SleepSeconds > 0.0f)
+				FPlatformProcess::Sleep(SleepSeconds);
+
+			RestoredListeners.Add(Name);
+		}), Priority);
+	}
+
+	FString GetRestoredListeners() const { return FString::Join(RestoredListeners, TEXT(", ")); }
+WE_END_DEFINE_SPEC(SaveGameRestorePipeline)
+{
+	BeforeEach([this]
+	{
+		RestorePipeline = MakeShared<FSaveGameRestorePipeline>();
+		RestoredListeners.Reset();
+	});
+
+	AfterEach([this]
+	{
+		RestorePipeline.Reset();
+	});
+
+	Describe("Begin", [this]
+	{
+		It("should restore the critical tier right away and leave the other tiers for later.", [this]
+		{
+			AddListener(ESaveGameRestoreTier::Gameplay, "Gameplay");
+			AddListener(ESaveGameRestoreTier::Critical, "Critical");
+			AddListener(ESaveGameRestoreTier::Deferred, "Deferred");
+
+			RestorePipeline->Begin(FCurrentSaveGame());
+			TestEqual("Restored listeners", GetRestoredListeners(), FString("Critical"));
+			TestTrue("IsRunning", RestorePipeline->IsRunning());
+			TestTrue("Critical tier restored", RestorePipeline->GetSecondsUntilTierRestored(ESaveGameRestoreTier::Critical) >= 0.0);
+			TestFalse("Deferred tier restored", RestorePipeline->GetSecondsUntilTierRestored(ESaveGameRestoreTier::Deferred) >= 0.0);
+		});
+	});
+
+	Describe("Add", [this]
+	{
+		It("should restore listeners by tier first and by priority within their tier.", [this]
+		{
+			AddListener(ESaveGameRestoreTier::Deferred, "Deferred", 10);
+			AddListener(ESaveGameRestoreTier::Gameplay, "Gameplay (0)", 0);
+			AddListener(ESaveGameRestoreTier::Gameplay, "Gameplay (5)", 5);
+			AddListener(ESaveGameRestoreTier::Critical, "Critical", -1);
+
+			RestorePipeline->Begin(FCurrentSaveGame());
+			RestorePipeline->Flush();
+			TestEqual("Restored listeners", GetRestoredListeners(), FString("Critical, Gameplay (5), Gameplay (0), Deferred"));
+			TestFalse("IsRunning", RestorePipeline->IsRunning());
+		});
+	});
+
+	Describe("OnTierRestored", [this]
+	{
+		It("should fire for every tier in order, even if no listeners are registered for it.", [this]
+		{
+			TArray<FString> RestoredTiers;
+			RestorePipeline->OnTierRestored.AddLambda([&RestoredTiers](ESaveGameRestoreTier Tier, const FCurrentSaveGame&)
+			{
+				RestoredTiers.Add(LexToString(Tier));
+			});
+			AddListener(ESaveGameRestoreTier::Deferred, "Deferred");
+
+			RestorePipeline->Begin(FCurrentSaveGame());
+			RestorePipeline->Flush();
+			TestEqual("Restored tiers", FString::Join(RestoredTiers, TEXT(", ")), FString("Critical, Gameplay, Deferred"));
+		});
+	});
+
+	Describe("Process", [this]
+	{
+		It("should split the restore across calls when the listeners exceed the time budget.", [this]
+		{
+			AddListener(ESaveGameRestoreTier::Gameplay, "A", 0, 0.005f);
+			AddListener(ESaveGameRestoreTier::Gameplay, "B", 0, 0.005f);
+			AddListener(ESaveGameRestoreTier::Deferred, "C", 0, 0.005f);
+
+			RestorePipeline->Begin(FCurrentSaveGame());
+			RestorePipeline->Process(0.001);
+			TestEqual("Restored listeners after first call", GetRestoredListeners(), FString("A"));
+			TestEqual("Current tier after first call", FString(LexToString(RestorePipeline->GetCurrentTier())), FString("Gameplay"));
+
+			RestorePipeline->Process(0.001);
+			TestEqual("Restored listeners after second call", GetRestoredListeners(), FString("A, B"));
+			TestTrue("IsRunning after second call", RestorePipeline->IsRunning());
+
+			RestorePipeline->Process(1.0);
+			TestEqual("Restored listeners after last call", GetRestoredListeners(), FString("A, B, C"));
+			TestFalse("IsRunning after last call", RestorePipeline->IsRunning());
+		});
+	});
+}
+
+#undef SPEC_TEST_CATEGORY
+#endif WITH_AUTOMATION_WORKER
@@ -11,9 +11,13 @@
 
 #include "AutomationTest/AutomationSpecMacros.h"
 #include "AutomationTest/AutomationTestWorld.h"
+#include "Engine/Engine.h"
 #include "GameService/GameServiceManager.h"
 #include "SaveGame/Mocks/MockSaveGameSerializer.h"
+#include "SaveGame/Mocks/MockableSaveLoadBehavior.h"
+#include "SaveGame/Mocks/SaveGameSerializationMocks.h"
 #include "SaveGame/SaveGameService.h"
+#include "SaveGame/Settings/SaveGameServiceSettings.h"
 
 #define SPEC_TEST_CATEGORY "WeekendUtils.SaveGame"
 
@@ -23,12 +27,55 @@ WE_BEGIN_DEFINE_SPEC(SaveGameService)
 	TSharedPtr<FScopedAutomationTestWorld> TestWorld;
 	TObjectPtr<USaveGameService> SaveGameService;
 	TObjectPtr<UMockSaveGameSerializer> SaveGameSerializer;
+	float AutosaveMaxDeferralBefore = 0.0f;
+	float AutosaveDebounceTimeBefore = 0.0f;
+	float SaveContributionTimeoutBefore = 0.0f;
+	float RestoreFrameBudgetBefore = 0.0f;
+	bool bSpeculativeDecodeBefore = false;
+	bool bOverlapLoadWithTravelBefore = false;
 	static inline FString TestSlotName = "Test";
+	static inline FString BackupSlotName = "Backup";
 	static inline int32 UserIndex = 0;
+
+	void TickSaveGameService() const
+	{
+		// (i) Ticked directly, like the world game service runner does, instead of ticking the whole test world:
+		static_cast<UGameServiceBase*>(SaveGameService.Get())->TickService(0.f);
+	}
+
+	void DeferAutosaves(float MaxDeferral, float DebounceTime) const
+	{
+		GetMutableDefault<USaveGameServiceSettings>()->AutosaveMaxDeferral = MaxDeferral;
+		GetMutableDefault<USaveGameServiceSettings>()->AutosaveDebounceTime = DebounceTime;
+	}
+
+	/** Writes the current SaveGame into given slot behind the service's back, so the slot is not cached and can be decoded speculatively. */
+	void WriteSlotWithoutCaching(const FString& SlotName) const
+	{
+		TArray<uint8> SaveData;
+		SaveGameSerializer->TrySerializeSaveGame(*SaveGameService->GetCurrentSaveGame().GetMutablePtr(), OUT SaveData);
+		SaveGameSerializer->TrySaveDataToSlot(SaveData, SlotName, UserIndex);
+	}
+
+	bool TryDecodeSpeculatively(const FString& SlotName)
+	{
+		GetMutableDefault<USaveGameServiceSettings>()->bSpeculativeDecode = true;
+		WriteSlotWithoutCaching(SlotName);
+		SaveGameService->SetSpeculativeDecodeFocus(SlotName);
+		TickSaveGameService();
+		return TestTrue("HasSpeculativeDecode of focused slot", SaveGameService->HasSpeculativeDecode(SlotName));
+	}
 WE_END_DEFINE_SPEC(SaveGameService)
 {
 	BeforeEach([this]
 	{
+		AutosaveMaxDeferralBefore = GetDefault<USaveGameServiceSettings>()->AutosaveMaxDeferral;
+		AutosaveDebounceTimeBefore = GetDefault<USaveGameServiceSettings>()->AutosaveDebounceTime;
+		SaveContributionTimeoutBefore = GetDefault<USaveGameServiceSettings>()->SaveContributionTimeout;
+		RestoreFrameBudgetBefore = GetDefault<USaveGameServiceSettings>()->RestoreFrameBudget;
+		bSpeculativeDecodeBefore = GetDefault<USaveGameServiceSettings>()->bSpeculativeDecode;
+		bOverlapLoadWithTravelBefore = GetDefault<USaveGameServiceSettings>()->bOverlapLoadWithTravel;
+
 		TestWorld = MakeShared<FScopedAutomationTestWorld>(SpecTestWorldName);
 		TestWorld->InitializeGame();
 
@@ -41,6 +88,13 @@ WE_END_DEFINE_SPEC(SaveGameService)
 		UGameServiceManager::Get().ShutdownAllServices();
 		SaveGameService = nullptr;
 		TestWorld.Reset();
+
+		GetMutableDefault<USaveGameServiceSettings>()->AutosaveMaxDeferral = AutosaveMaxDeferralBefore;
+		GetMutableDefault<USaveGameServiceSettings>()->AutosaveDebounceTime = AutosaveDebounceTimeBefore;
+		GetMutableDefault<USaveGameServiceSettings>()->SaveContributionTimeout = SaveContributionTimeoutBefore;
+		GetMutableDefault<USaveGameServiceSettings>()->RestoreFrameBudget = RestoreFrameBudgetBefore;
+		GetMutableDefault<USaveGameServiceSettings>()->bSpeculativeDecode = bSpeculativeDecodeBefore;
+		GetMutableDefault<USaveGameServiceSettings>()->bOverlapLoadWithTravel = bOverlapLoadWithTravelBefore;
 	});
 
 	Describe("RequestAutosave", [this]
@@ -75,6 +129,97 @@ WE_END_DEFINE_SPEC(SaveGameService)
 		});
 	});
 
+	Describe("RequestAutosave with AutosaveMaxDeferral", [this]
+	{
+		It("should defer the autosave until the save/load behavior reports a low-load moment.", [this]
+		{
+			UMockableSaveLoadBehavior* SaveLoadBehavior = SaveGameService->GetSaveLoadBehavior<UMockableSaveLoadBehavior>();
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()) || !TestNotNull("MockableSaveLoadBehavior", SaveLoadBehavior))
+				return;
+
+			DeferAutosaves(60.0f, 0.0f);
+			const FString AutosaveSlotName = SaveGameService->GetAutosaveSlotName();
+			SaveGameService->RequestAutosave("Test");
+			TickSaveGameService();
+			TestTrue("Autosave is deferred", SaveGameService->HasDeferredAutosave());
+			TestFalse("Autosave file exists while deferred", SaveGameSerializer->DoesSaveGameExist(AutosaveSlotName, UserIndex));
+
+			SaveLoadBehavior->bIsLowLoadMomentForAutosave = true;
+			TickSaveGameService();
+			TestFalse("Autosave is deferred after low-load moment", SaveGameService->HasDeferredAutosave());
+			TestTrue("Autosave file exists after low-load moment", SaveGameSerializer->DoesSaveGameExist(AutosaveSlotName, UserIndex));
+		});
+
+		It("should wait until no new request came in for the debounce time.", [this]
+		{
+			UMockableSaveLoadBehavior* SaveLoadBehavior = SaveGameService->GetSaveLoadBehavior<UMockableSaveLoadBehavior>();
+			if (!TestNotNull("MockableSaveLoadBehavior", SaveLoadBehavior))
+				return;
+
+			DeferAutosaves(60.0f, 60.0f);
+			SaveLoadBehavior->bIsLowLoadMomentForAutosave = true;
+			SaveGameService->RequestAutosave("Test");
+			TickSaveGameService();
+			TestTrue("Autosave is deferred during debounce time", SaveGameService->HasDeferredAutosave());
+		});
+
+		It("should merge repeated requests into a single save that finishes all of them.", [this]
+		{
+			UMockableSaveLoadBehavior* SaveLoadBehavior = SaveGameService->GetSaveLoadBehavior<UMockableSaveLoadBehavior>();
+			if (!TestNotNull("MockableSaveLoadBehavior", SaveLoadBehavior))
+				return;
+
+			DeferAutosaves(60.0f, 0.0f);
+			int32 NumSuccessfulCallbacks = 0;
+			const USaveGameService::FOnSaveLoadCompleted Callback = USaveGameService::FOnSaveLoadCompleted::CreateLambda([&](USaveGame* SavedGame, bool bSuccess)
+			{
+				NumSuccessfulCallbacks += (bSuccess ? 1 : 0);
+			});
+			SaveGameService->RequestAutosave("Test 1", Callback);
+			SaveGameService->RequestAutosave("Test 2", Callback);
+			TestEqual("Number of callbacks while deferred", NumSuccessfulCallbacks, 0);
+
+			SaveLoadBehavior->bIsLowLoadMomentForAutosave = true;
+			TickSaveGameService();
+			TestEqual("Number of successful callbacks", NumSuccessfulCallbacks, 2);
+			TestEqual("Number of save operations", SaveGameService->GetSaveLoadMetrics().GetStats(ESaveLoadOperation::Save).NumOperations, 1);
+		});
+
+		It("should save once the max deferral is reached, even without a low-load moment.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			DeferAutosaves(0.001f, 0.0f);
+			SaveGameService->RequestAutosave("Test");
+			FPlatformProcess::Sleep(0.01f);
+			TickSaveGameService();
+			TestFalse("Autosave is deferred after max deferral", SaveGameService->HasDeferredAutosave());
+			TestTrue("Autosave file exists after max deferral", SaveGameSerializer->DoesSaveGameExist(SaveGameService->GetAutosaveSlotName(), UserIndex));
+		});
+
+		It("should fail deferred requests if autosaving was locked in the meantime.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			DeferAutosaves(0.001f, 0.0f);
+			TOptional<bool> bCallbackSuccess;
+			SaveGameService->RequestAutosave("Test", USaveGameService::FOnSaveLoadCompleted::CreateLambda([&](USaveGame* SavedGame, bool bSuccess)
+			{
+				bCallbackSuccess = bSuccess;
+			}));
+			const FSaveLoadLockHandle AutosaveLock = SaveGameService->LockAutosaving(*SaveGameSerializer, "Test");
+			FPlatformProcess::Sleep(0.01f);
+			TickSaveGameService();
+			SaveGameService->UnlockAutosaving(AutosaveLock, "Test");
+
+			TestFalse("Autosave is deferred after max deferral", SaveGameService->HasDeferredAutosave());
+			TestTrue("Callback was called without success", bCallbackSuccess.IsSet() && !*bCallbackSuccess);
+			TestFalse("Autosave file exists", SaveGameSerializer->DoesSaveGameExist(SaveGameService->GetAutosaveSlotName(), UserIndex));
+		});
+	});
+
 	Describe("RequestSaveCurrentSaveGameToSlot", [this]
 	{
 		It("should create a SaveGame file for the current game in the desired slot.", [this]
@@ -115,6 +260,336 @@ WE_END_DEFINE_SPEC(SaveGameService)
 			const USaveGame* CachedSaveGame = SaveGameService->GetCachedSaveGameSnapshotAtSlot(TestSlotName);
 			TestNotNull("CachedSaveGame", CachedSaveGame);
 		});
+
+		It("should record metrics of the save operation", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName);
+
+			const FSaveLoadOperationStats& SaveStats = SaveGameService->GetSaveLoadMetrics().GetStats(ESaveLoadOperation::Save);
+			TestEqual("NumOperations", SaveStats.NumOperations, 1);
+			TestEqual("NumFailures", SaveStats.NumFailures, 0);
+			TestEqual("Total histogram samples", SaveStats.GetHistogram(ESaveLoadPhase::Total).Num(), 1);
+		});
+	});
+
+	Describe("RequestSaveCurrentSaveGameToSlots", [this]
+	{
+		It("should finish merged requests with the result of their own slot.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			// (i) Deferred autosaves are merged into saves that write into the Autosave slot anyway:
+			GetMutableDefault<USaveGameServiceSettings>()->AutosaveMaxDeferral = 60.0f;
+			TOptional<bool> bAutosaveSuccess = {};
+			SaveGameService->RequestAutosave("Test", USaveGameService::FOnSaveLoadCompleted::CreateLambda([&](USaveGame* SavedGame, bool bSuccess)
+			{
+				bAutosaveSuccess = bSuccess;
+			}));
+			TestTrue("HasDeferredAutosave before saving", SaveGameService->HasDeferredAutosave());
+
+			const FString AutosaveSlotName = SaveGameService->GetAutosaveSlotName();
+			SaveGameSerializer->SlotsFailingToSave.Add(BackupSlotName);
+			TMap<FString, bool> SuccessBySlot = {};
+			SaveGameService->RequestSaveCurrentSaveGameToSlots("Test", { AutosaveSlotName, BackupSlotName },
+				USaveGameService::FOnMultiSlotSaveCompleted::CreateLambda([&](USaveGame* SavedGame, const TMap<FString, bool>& InSuccessBySlot)
+				{
+					SuccessBySlot = InSuccessBySlot;
+				}));
+
+			TestFalse("HasDeferredAutosave after saving", SaveGameService->HasDeferredAutosave());
+			TestTrue("Autosave callback was called", bAutosaveSuccess.IsSet());
+			TestTrue("Autosave succeeded", bAutosaveSuccess.Get(false));
+			TestEqual("Number of reported slots", SuccessBySlot.Num(), 2);
+			TestTrue("Autosave slot succeeded", SuccessBySlot.FindRef(AutosaveSlotName));
+			TestFalse("Backup slot succeeded", SuccessBySlot.FindRef(BackupSlotName));
+			TestFalse("Backup file exists", SaveGameSerializer->DoesSaveGameExist(BackupSlotName, UserIndex));
+		});
+	});
+
+	Describe("AddSaveContributor", [this]
+	{
+		It("should save without contributions that aren't ready within the SaveContributionTimeout.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			GetMutableDefault<USaveGameServiceSettings>()->SaveContributionTimeout = 0.001f;
+			TSharedRef<TPromise<FCurrentSaveGame::FSaveContributionWriter>> Promise = MakeShared<TPromise<FCurrentSaveGame::FSaveContributionWriter>>();
+			TSharedRef<bool> bWasWriterCalled = MakeShared<bool>(false);
+			SaveGameService->AddSaveContributor("Test", FCurrentSaveGame::FOnContributeToSave::CreateLambda([Promise](const FCurrentSaveGame&)
+			{
+				return Promise->GetFuture();
+			}));
+
+			TOptional<bool> bSaveSuccess = {};
+			SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName, USaveGameService::FOnSaveLoadCompleted::CreateLambda([&](USaveGame* SavedGame, bool bSuccess)
+			{
+				bSaveSuccess = bSuccess;
+			}));
+			TestTrue("IsBusySaving while waiting for contributions", SaveGameService->IsBusySaving());
+
+			AddExpectedError("Dropped save contribution of Test");
+			FPlatformProcess::Sleep(0.01f);
+			TickSaveGameService();
+			TestFalse("IsBusySaving after the timeout", SaveGameService->IsBusySaving());
+			TestTrue("Callback was called with success", bSaveSuccess.Get(false));
+			TestTrue("Save file exists", SaveGameSerializer->DoesSaveGameExist(TestSlotName, UserIndex));
+
+			Promise->SetValue([bWasWriterCalled](const FCurrentSaveGame&) { *bWasWriterCalled = true; });
+			TestFalse("Dropped contribution was applied", *bWasWriterCalled);
+		});
+	});
+
+	Describe("CancelSaveRequest", [this]
+	{
+		It("should abort a save that waits for contributions right away and ignore them when they complete later.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			TSharedRef<TPromise<FCurrentSaveGame::FSaveContributionWriter>> Promise = MakeShared<TPromise<FCurrentSaveGame::FSaveContributionWriter>>();
+			TSharedRef<bool> bWasWriterCalled = MakeShared<bool>(false);
+			const FDelegateHandle ContributorHandle = SaveGameService->AddSaveContributor("Test", FCurrentSaveGame::FOnContributeToSave::CreateLambda([Promise](const FCurrentSaveGame&)
+			{
+				return Promise->GetFuture();
+			}));
+
+			TOptional<bool> bSaveSuccess = {};
+			const FAsyncSaveGameHandle Handle = SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName, USaveGameService::FOnSaveLoadCompleted::CreateLambda([&](USaveGame* SavedGame, bool bSuccess)
+			{
+				bSaveSuccess = bSuccess;
+			}));
+			TestTrue("IsBusySaving while waiting for contributions", SaveGameService->IsBusySaving());
+
+			SaveGameService->CancelSaveRequest(Handle);
+			TestFalse("IsBusySaving after cancelling", SaveGameService->IsBusySaving());
+			TestFalse("Callback of cancelled request was called", bSaveSuccess.IsSet());
+			TestFalse("Save file exists after cancelling", SaveGameSerializer->DoesSaveGameExist(TestSlotName, UserIndex));
+
+			// Late contribution must neither be applied nor block the next save:
+			SaveGameService->RemoveSaveContributor(ContributorHandle);
+			Promise->SetValue([bWasWriterCalled](const FCurrentSaveGame&) { *bWasWriterCalled = true; });
+			SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName);
+			TestFalse("Late contribution was applied", *bWasWriterCalled);
+			TestTrue("Save file exists after saving again", SaveGameSerializer->DoesSaveGameExist(TestSlotName, UserIndex));
+		});
+	});
+
+	Describe("ShutdownService", [this]
+	{
+		It("should fail saves in progress, so their requesters don't wait forever.", [this]
+		{
+			TSharedRef<TPromise<FCurrentSaveGame::FSaveContributionWriter>> Promise = MakeShared<TPromise<FCurrentSaveGame::FSaveContributionWriter>>();
+			SaveGameService->AddSaveContributor("Test", FCurrentSaveGame::FOnContributeToSave::CreateLambda([Promise](const FCurrentSaveGame&)
+			{
+				return Promise->GetFuture();
+			}));
+
+			TOptional<bool> bSaveSuccess = {};
+			SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName, USaveGameService::FOnSaveLoadCompleted::CreateLambda([&](USaveGame* SavedGame, bool bSuccess)
+			{
+				bSaveSuccess = bSuccess;
+			}));
+			TestTrue("IsBusySaving while waiting for contributions", SaveGameService->IsBusySaving());
+
+			UGameServiceManager::Get().ShutdownAllServices();
+			TestTrue("Callback was called", bSaveSuccess.IsSet());
+			TestFalse("Save succeeded", bSaveSuccess.Get(true));
+			TestFalse("IsBusySaving after shutdown", SaveGameService->IsBusySaving());
+		});
+	});
+
+	Describe("TryRestoreMostRecentInMemorySnapshot", [this]
+	{
+		It("should restore the most recently saved SaveGame without loading it from disk.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			TestFalse("Restored before saving", SaveGameService->TryRestoreMostRecentInMemorySnapshot("Test"));
+
+			SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName);
+			TestEqual("Number of in-memory snapshots", SaveGameService->GetInMemorySnapshotHandles().Num(), 1);
+
+			const USaveGame* SaveGameBeforeRestore = SaveGameService->GetCurrentSaveGame().GetPtr();
+			SaveGameSerializer->PretendedSaveGamesOnDisk.Empty();
+			TestTrue("Restored after saving", SaveGameService->TryRestoreMostRecentInMemorySnapshot("Test"));
+			TestNotEqual("Current SaveGame", SaveGameService->GetCurrentSaveGame().GetPtr(), SaveGameBeforeRestore);
+		});
+
+		It("should be processed like a load request of the snapshot's slot.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName);
+			SaveGameSerializer->PretendedSaveGamesOnDisk.Empty();
+
+			TOptional<bool> bRestoreSuccess = {};
+			SaveGameService->TryRestoreMostRecentInMemorySnapshot("Test", USaveGameService::FOnSaveLoadCompleted::CreateLambda([&](USaveGame* LoadedGame, bool bSuccess)
+			{
+				bRestoreSuccess = bSuccess;
+			}));
+			TestTrue("Callback was called with success", bRestoreSuccess.Get(false));
+			TestFalse("IsBusyLoading after restoring", SaveGameService->IsBusyLoading());
+			TestEqual("Current slot", SaveGameService->GetCurrentSaveGame().GetSlotLastRestoredFrom().Get(""), TestSlotName);
+
+			const FSaveLoadOperationStats& RestoreStats = SaveGameService->GetSaveLoadMetrics().GetStats(ESaveLoadOperation::RestoreSnapshot);
+			TestEqual("NumOperations", RestoreStats.NumOperations, 1);
+			TestEqual("NumFailures", RestoreStats.NumFailures, 0);
+		});
+	});
+
+	Describe("RestorePipeline", [this]
+	{
+		It("should restore the remaining tiers before the current SaveGame is saved.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()))
+				return;
+
+			GetMutableDefault<USaveGameServiceSettings>()->RestoreFrameBudget = 4.0f;
+			TOptional<bool> bSaveFileExistedWhenRestored = {};
+			SaveGameService->RestorePipeline.Add(ESaveGameRestoreTier::Deferred, FSaveGameRestorePipeline::FRestoreStep::CreateLambda([&](const FCurrentSaveGame&)
+			{
+				bSaveFileExistedWhenRestored = SaveGameSerializer->DoesSaveGameExist(TestSlotName, UserIndex);
+			}));
+
+			SaveGameService->CreateAndRestoreNewSaveGameAsCurrent();
+			TestTrue("RestorePipeline is running after restore", SaveGameService->RestorePipeline.IsRunning());
+			TestFalse("Deferred listener was restored before saving", bSaveFileExistedWhenRestored.IsSet());
+
+			SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName);
+			TestFalse("RestorePipeline is running after saving", SaveGameService->RestorePipeline.IsRunning());
+			TestTrue("Deferred listener was restored", bSaveFileExistedWhenRestored.IsSet());
+			TestFalse("Save file existed when deferred listener was restored", bSaveFileExistedWhenRestored.Get(true));
+		});
+	});
+
+	Describe("SetSpeculativeDecodeFocus", [this]
+	{
+		It("should discard the speculative decode of a slot when the slot is saved again.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()) || !TryDecodeSpeculatively(TestSlotName))
+				return;
+
+			SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName);
+			TestFalse("HasSpeculativeDecode after saving the slot", SaveGameService->HasSpeculativeDecode(TestSlotName));
+		});
+
+		It("should discard the speculative decode of a slot when the slot is deleted.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()) || !TryDecodeSpeculatively(TestSlotName))
+				return;
+
+			SaveGameService->DeleteSaveGameAtSlot(TestSlotName, false);
+			TestFalse("HasSpeculativeDecode after deleting the slot", SaveGameService->HasSpeculativeDecode(TestSlotName));
+		});
+
+		It("should discard the speculative decode of a slot when the focus moves to another slot.", [this]
+		{
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()) || !TryDecodeSpeculatively(TestSlotName))
+				return;
+
+			SaveGameService->SetSpeculativeDecodeFocus(BackupSlotName);
+			TickSaveGameService();
+			TestFalse("HasSpeculativeDecode of previously focused slot", SaveGameService->HasSpeculativeDecode(TestSlotName));
+		});
+	});
+
+	Describe("TSaveGameModuleHandle", [this]
+	{
+		It("should look up the module again after the current SaveGame was swapped.", [this]
+		{
+			const TSaveGameModuleHandle<UMockSaveGameModule_SchemaA> ModuleHandle;
+			UMockSaveGameModule_SchemaA* ModuleBeforeSwap = ModuleHandle.GetOrAdd();
+			if (!TestNotNull("Module before swap", ModuleBeforeSwap))
+				return;
+
+			TestEqual("Cached module", ModuleHandle.Get(), ModuleBeforeSwap);
+
+			SaveGameService->CreateNewSaveGameAsCurrent();
+			TestNull("Module after swap", ModuleHandle.Get());
+
+			UMockSaveGameModule_SchemaA* ModuleAfterSwap = ModuleHandle.GetOrAdd();
+			TestNotNull("Added module after swap", ModuleAfterSwap);
+			TestNotEqual("Added module after swap", ModuleAfterSwap, ModuleBeforeSwap);
+		});
+
+		It("should return nullptr after the module was deleted.", [this]
+		{
+			const TSaveGameModuleHandle<UMockSaveGameModule_SchemaA> ModuleHandle;
+			UModularSaveGame* SaveGame = SaveGameService->GetCurrentSaveGame().GetMutablePtr<UModularSaveGame>();
+			if (!TestNotNull("Current ModularSaveGame", SaveGame) || !TestNotNull("Module", ModuleHandle.GetOrAdd()))
+				return;
+
+			SaveGame->DeleteModule(ModuleHandle.GetModuleName());
+			TestNull("Module after deletion", ModuleHandle.Get());
+		});
+
+		It("should resolve to the restored module after a SaveGame was loaded.", [this]
+		{
+			const TSaveGameModuleHandle<UMockSaveGameModule_SchemaA> ModuleHandle;
+			UMockSaveGameModule_SchemaA* ModuleBeforeLoad = ModuleHandle.GetOrAdd();
+			if (!TestNotNull("Module before load", ModuleBeforeLoad))
+				return;
+
+			ModuleBeforeLoad->Score = 42;
+			SaveGameService->RequestSaveCurrentSaveGameToSlot("Test", TestSlotName);
+			ModuleBeforeLoad->Score = 0;
+			if (!TestTrue("Restored SaveGame", SaveGameService->TryRestoreMostRecentInMemorySnapshot("Test")))
+				return;
+
+			UMockSaveGameModule_SchemaA* ModuleAfterLoad = ModuleHandle.Get();
+			if (!TestNotNull("Module after load", ModuleAfterLoad))
+				return;
+
+			TestNotEqual("Module after load", ModuleAfterLoad, ModuleBeforeLoad);
+			TestEqual("Restored Score", ModuleAfterLoad->Score, 42);
+		});
+
+		It("should return nullptr after the service was shut down.", [this]
+		{
+			const TSaveGameModuleHandle<UMockSaveGameModule_SchemaA> ModuleHandle;
+			if (!TestNotNull("Module before shutdown", ModuleHandle.GetOrAdd()))
+				return;
+
+			UGameServiceManager::Get().ShutdownAllServices();
+			TestNull("Module after shutdown", ModuleHandle.Get());
+			TestFalse("Handle is valid after shutdown", static_cast<bool>(ModuleHandle));
+		});
+	});
+
+	Describe("RequestLoadAndTravelIntoCurrentSaveGameFromSlot", [this]
+	{
+		It("should release the prefetched level when the travel fails.", [this]
+		{
+			UModularSaveGame* SaveGame = SaveGameService->GetCurrentSaveGame().GetMutablePtr<UModularSaveGame>();
+			if (!TestNotNull("MockSaveGameSerializer", SaveGameSerializer.Get()) || !TestNotNull("Current ModularSaveGame", SaveGame))
+				return;
+
+			// (i) Written behind the service's back and never finished loading, so the prefetch is not released by the load itself:
+			GetMutableDefault<USaveGameServiceSettings>()->bOverlapLoadWithTravel = true;
+			SaveGame->GetMutableHeaderData<FSimpleSaveGameHeaderData>().LoadedLevel = FSoftObjectPath("/Engine/Maps/Entry.Entry");
+			WriteSlotWithoutCaching(TestSlotName);
+			SaveGameSerializer->bAsyncLoadsNeverComplete = true;
+
+			const FAsyncLoadGameHandle Handle = SaveGameService->RequestLoadAndTravelIntoCurrentSaveGameFromSlot("Test", TestSlotName);
+			TestTrue("IsBusyLoading", SaveGameService->IsBusyLoading());
+			TestTrue("IsPrefetchingTravelDestination while loading", SaveGameService->IsPrefetchingTravelDestination());
+
+			GEngine->OnTravelFailure().Broadcast(&TestWorld->AsRef(), ETravelFailure::TravelFailure, "Test");
+			TestFalse("IsPrefetchingTravelDestination after travel failure", SaveGameService->IsPrefetchingTravelDestination());
+
+			// Level finishing to load afterwards must not be kept in memory anymore:
+			FlushAsyncLoading();
+			TestFalse("IsPrefetchingTravelDestination after async loading", SaveGameService->IsPrefetchingTravelDestination());
+
+			SaveGameService->CancelLoadRequest(Handle);
+		});
 	});
 }
 
@@ -0,0 +1,137 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#if WITH_AUTOMATION_WORKER
+
+#include "AutomationTest/AutomationSpecMacros.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "SaveGame/ModularSaveGame.h"
+#include "SaveGame/SaveGameHeader.h"
+#include "SaveGame/SaveGameSlotManifest.h"
+#include "SaveGame/Mocks/SaveGameSerializationMocks.h"
+#include "UObject/StrongObjectPtr.h"
+
+#define SPEC_TEST_CATEGORY "WeekendUtils.SaveGame"
+
+WE_BEGIN_DEFINE_SPEC(SaveGameSlotManifest)
+	FString Directory;
+	TStrongObjectPtr<UMockFileSaveGameSerializer> Serializer;
+	static inline FString TestSlotName = "Test";
+	static inline int32 UserIndex = 0;
+
+	/** @returns new serializer, which loads the slot manifest from disk again on first access. */
+	UMockFileSaveGameSerializer* CreateSerializer() const
+	{
+		UMockFileSaveGameSerializer* NewSerializer = NewObject<UMockFileSaveGameSerializer>(GetTransientPackage());
+		NewSerializer->Directory = Directory;
+		return NewSerializer;
+	}
+
+	TArray<uint8> SerializeSaveGame(int32 SaveCounter) const
+	{
+		UModularSaveGame* SaveGame = NewObject<UModularSaveGame>(GetTransientPackage());
+		FSimpleSaveGameHeaderData HeaderData;
+		HeaderData.SaveCounter = SaveCounter;
+		SaveGame->CreateHeaderData(HeaderData);
+
+		TArray<uint8> SaveData;
+		Serializer->TrySerializeSaveGame(*SaveGame, OUT SaveData);
+		return SaveData;
+	}
+
+	static int32 GetSaveCounter(const FSaveGameSlotManifestEntry& Entry)
+	{
+		const FSimpleSaveGameHeaderData* HeaderData = Entry.GetCustomHeaderData<FSimpleSaveGameHeaderData>();
+		return (HeaderData ? HeaderData->SaveCounter : INDEX_NONE);
+	}
+
+	/** @returns the slot manifest as stored on disk. */
+	FSaveGameSlotManifest LoadSlotManifestFile() const
+	{
+		FSaveGameSlotManifest Manifest;
+		Manifest.TryLoadFromFile(Serializer->GetSlotManifestFilePathForTests());
+		return Manifest;
+	}
+WE_END_DEFINE_SPEC(SaveGameSlotManifest)
+{
+	BeforeEach([this]
+	{
+		Directory = FPaths::AutomationTransientDir() / TEXT("SaveGameSlotManifest");
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+		Serializer.Reset(CreateSerializer());
+		Serializer->TrySaveDataToSlot(SerializeSaveGame(1), TestSlotName, UserIndex);
+	});
+
+	AfterEach([this]
+	{
+		Serializer.Reset();
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	});
+
+	Describe("TrySaveDataToSlot", [this]
+	{
+		It("should write the header of the saved slot into the manifest file.", [this]
+		{
+			const FSaveGameSlotManifestEntry* Entry = LoadSlotManifestFile().Find(TestSlotName);
+			if (!TestNotNull("Manifest entry", Entry))
+				return;
+
+			TestEqual("SaveCounter", GetSaveCounter(*Entry), 1);
+			TestEqual("FileSize", Entry->FileSize, IFileManager::Get().FileSize(*Serializer->GetSlotFilePathForTests(TestSlotName)));
+		});
+	});
+
+	Describe("ReadSlotHeaders", [this]
+	{
+		It("should rebuild the manifest from the save files when the manifest file is missing.", [this]
+		{
+			IFileManager::Get().Delete(*Serializer->GetSlotManifestFilePathForTests());
+			Serializer.Reset(CreateSerializer());
+
+			const TMap<FString, FSaveGameSlotManifestEntry> Entries = Serializer->ReadSlotHeaders({ TestSlotName }, UserIndex);
+			TestTrue("Header was read", Entries.Contains(TestSlotName));
+			TestEqual("SaveCounter", Entries.Contains(TestSlotName) ? GetSaveCounter(Entries[TestSlotName]) : INDEX_NONE, 1);
+
+			const FSaveGameSlotManifestEntry* Entry = LoadSlotManifestFile().Find(TestSlotName);
+			TestNotNull("Rebuilt manifest entry", Entry);
+		});
+
+		It("should rebuild stale entries when the save file was changed without updating the manifest.", [this]
+		{
+			// (i) Simulates e.g. a save file that was restored from a cloud backup:
+			const FString SlotFilePath = Serializer->GetSlotFilePathForTests(TestSlotName);
+			FFileHelper::SaveArrayToFile(SerializeSaveGame(2), *SlotFilePath);
+			IFileManager::Get().SetTimeStamp(*SlotFilePath, FDateTime::UtcNow() + FTimespan::FromHours(1.0));
+
+			const TMap<FString, FSaveGameSlotManifestEntry> Entries = Serializer->ReadSlotHeaders({ TestSlotName }, UserIndex);
+			TestEqual("SaveCounter", Entries.Contains(TestSlotName) ? GetSaveCounter(Entries[TestSlotName]) : INDEX_NONE, 2);
+
+			const FSaveGameSlotManifestEntry* Entry = LoadSlotManifestFile().Find(TestSlotName);
+			if (!TestNotNull("Rebuilt manifest entry", Entry))
+				return;
+
+			TestEqual("Rebuilt SaveCounter", GetSaveCounter(*Entry), 2);
+			TestEqual("Rebuilt FileTimeStamp", Entry->FileTimeStamp, IFileManager::Get().GetTimeStamp(*SlotFilePath));
+		});
+
+		It("should drop entries of save files that were deleted without updating the manifest.", [this]
+		{
+			IFileManager::Get().Delete(*Serializer->GetSlotFilePathForTests(TestSlotName));
+
+			const TMap<FString, FSaveGameSlotManifestEntry> Entries = Serializer->ReadSlotHeaders({ TestSlotName }, UserIndex);
+			TestFalse("Header was read", Entries.Contains(TestSlotName));
+			TestNull("Manifest entry", LoadSlotManifestFile().Find(TestSlotName));
+		});
+	});
+}
+
+#undef SPEC_TEST_CATEGORY
+#endif WITH_AUTOMATION_WORKER
@@ -0,0 +1,195 @@
+﻿///////////////////////////////////////////////////////////////////////////////////////
+/// Copyright (C) by Benjamin Barz and contributors. See file: CREDITS.md
+///
+/// This file is part of the WeekendUtils UE5 Plugin.
+///
+/// Distributed under the MIT License. See file: LICENSE.md
+///
+///////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SaveGame/ModularSaveGame.h"
+#include "SaveGame/SaveGameModule.h"
+
+#include "SaveGameSerializationMocks.generated.h"
+
+//////////////////////////////////////////////////////////////////////
+/// (i) Classes with the same name length come in pairs, so tests  ///
+/// can swap their paths in save data to simulate renamed classes. ///
+//////////////////////////////////////////////////////////////////////
+
+/** Module serialized through a compiled schema, whose schema is changed by @UMockSaveGameModule_SchemaB. */
+UCLASS(Hidden, ClassGroup=Tests)
+class WEEKENDUTILSTESTS_API UMockSaveGameModule_SchemaA : public USaveGameModule
+{
+	GENERATED_BODY()
+
+public:
+	UMockSaveGameModule_SchemaA()
+	{
+		DefaultModuleName = "MockSchemaModule";
+		bSupportsParallelSerialization = true;
+		bUseCompiledSchema = true;
+	}
+
+	UPROPERTY(SaveGame)
+	int32 Score = 0;
+
+	UPROPERTY(SaveGame)
+	FString RemovedName = "";
+
+	UPROPERTY(SaveGame)
+	int32 Level = 0;
+};
+
+/** Same module as @UMockSaveGameModule_SchemaA, after one of its fields was renamed. */
+UCLASS(Hidden, ClassGroup=Tests)
+class WEEKENDUTILSTESTS_API UMockSaveGameModule_SchemaB : public USaveGameModule
+{
+	GENERATED_BODY()
+
+public:
+	UMockSaveGameModule_SchemaB()
+	{
+		DefaultModuleName = "MockSchemaModule";
+		bSupportsParallelSerialization = true;
+		bUseCompiledSchema = true;
+	}
+
+	UPROPERTY(SaveGame)
+	int32 Score = 0;
+
+	UPROPERTY(SaveGame)
+	FString RenamedName = "";
+
+	UPROPERTY(SaveGame)
+	int32 Level = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+/** Custom version that is only registered for tests and only used by @UMockSaveGameModule_CustomVersion. */
+struct WEEKENDUTILSTESTS_API FMockSaveGameCustomVersion
+{
+	static constexpr int32 LatestVersion = 3;
+	static const FGuid GUID;
+};
+
+/** Module that registers @FMockSaveGameCustomVersion when serialized and remembers the version it was loaded with. */
+UCLASS(Hidden, ClassGroup=Tests)
+class WEEKENDUTILSTESTS_API UMockSaveGameModule_CustomVersion : public USaveGameModule
+{
+	GENERATED_BODY()
+
+public:
+	UMockSaveGameModule_CustomVersion()
+	{
+		DefaultModuleName = "MockCustomVersionModule";
+	}
+
+	UPROPERTY(SaveGame)
+	int32 Value = 0;
+
+	/** Version of @FMockSaveGameCustomVersion the module was loaded with, or INDEX_NONE if it was unknown to the archive. */
+	int32 LoadedCustomVersion = INDEX_NONE;
+
+	// - USaveGameModule
+	virtual void Serialize(FArchive& Ar) override;
+	// --
+};
+
+//////////////////////////////////////////////////////////////////////
+
+/** Struct module that records its save/restore hooks, so tests can check they are called around serialization. */
+USTRUCT()
+struct WEEKENDUTILSTESTS_API FMockSaveGameStructModule : public FSaveGameStructModule
+{
+	GENERATED_BODY()
+
+	UPROPERTY(SaveGame)
+	int32 Value = 0;
+
+	/** Copied from @Value in PreSaveModule, so only saved correctly if the hook ran before serialization. */
+	UPROPERTY(SaveGame)
+	int32 ValueWhenSaved = 0;
+
+	bool bWasRestored = false;
+
+	// - FSaveGameStructModule
+	virtual void PreSaveModule() override { ValueWhenSaved = Value; }
+	virtual void PostRestoreModule() override { bWasRestored = true; }
+	// --
+};
+
+//////////////////////////////////////////////////////////////////////
+
+UCLASS(Hidden, ClassGroup=Tests)
+class WEEKENDUTILSTESTS_API UMockSaveGameSubobject_A : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(SaveGame)
+	int32 Value = 0;
+};
+
+UCLASS(Hidden, ClassGroup=Tests)
+class WEEKENDUTILSTESTS_API UMockSaveGameSubobject_B : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(SaveGame)
+	int32 Value = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+/**
+ * ModularSaveGame with sub-objects in its main content, which are written into the object identity table,
+ * and an asset reference, which is written into the referenced assets table.
+ */
+UCLASS(Hidden, ClassGroup=Tests)
+class WEEKENDUTILSTESTS_API UMockModularSaveGame : public UModularSaveGame
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(SaveGame, Instanced)
+	TArray<TObjectPtr<UObject>> Subobjects = {};
+
+	/** Serialized after the sub-objects, to check that reading continues behind skipped ones. */
+	UPROPERTY(SaveGame)
+	int32 Number = 0;
+
+	UPROPERTY(SaveGame)
+	TObjectPtr<UObject> ReferencedAsset = nullptr;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+/** ModularSaveGameSerializer that reads and writes plain files in given directory, with the slot manifest enabled on all platforms. */
+UCLASS(Hidden, ClassGroup=Tests)
+class WEEKENDUTILSTESTS_API UMockFileSaveGameSerializer : public UModularSaveGameSerializer
+{
+	GENERATED_BODY()
+
+public:
+	/** Contains the save files, the slot manifest and the chunk store. Has to be set before the first access. */
+	FString Directory = "";
+
+	FString GetSlotFilePathForTests(const FSlotName& SlotName) const { return GetSlotFilePath(SlotName); }
+	FString GetSlotManifestFilePathForTests() const { return GetSlotManifestFilePath(); }
+
+protected:
+	// - USaveGameSerializer
+	virtual FString GetSlotFilePath(const FSlotName& SlotName) const override { return FString(Directory / SlotName + TEXT(".sav")); }
+	virtual FString GetSlotManifestFilePath() const override { return FString(Directory / TEXT("SaveGameSlots.manifest")); }
+	virtual FString GetChunkStoreDirectory() const override { return FString(Directory / TEXT("Chunks")); }
+	virtual bool IsSlotManifestEnabled() const override { return true; }
+	virtual bool IsChunkStoreEnabled() const override { return false; }
+	virtual TSharedRef<ISaveGameStorageBackend> CreateStorageBackend() const override;
+	// --
+};